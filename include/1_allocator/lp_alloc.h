@@ -11,43 +11,130 @@
 #ifndef LP_ALLOC_H
 #define LP_ALLOC_H
 
-#include <new>      //for placement new
-#include <cstddef>  //for ptrdiff_t,size_t
-#include <cstdlib>  //for exit
-#include <iostream> //for std::cerr
+#include <new>         //for placement new
+#include <cstddef>     //for ptrdiff_t,size_t
+#include <cstdlib>     //for exit
+#include <cstring>     //for memcpy
+#include <algorithm>   //for std::sort,trim时按地址排序chunk
+#include <iostream>    //for std::cerr
+#include <mutex>       //for std::mutex,多线程模式下保护共享depot
+#include <type_traits> //for std::integral_constant
+#include "lp_size_class.h"
+#include "lp_chunk_source.h"
+#include "lp_alloc_stats.h"
+#include "lp_alloc_trace.h"
+#if defined(__GLIBC__)
+#include <malloc.h> //for malloc_trim
+#endif
 /*
 ptrdiff_t: 指针差值类型，即两个指针相减的结果类型
 size_t: 无符号整数类型，size_t的大小和系统有关,32位系统就是32,64位系统就是64
 */
 /*
- * 不考虑多线程
+ * 二级配置器的threads参数为true时启用多线程模式(线程本地缓存+共享depot)
  * 内存不足的情况直接强制退出
  */
 namespace lp
 {
+    enum
+    {
+        _ALIGN = 8,                       // 每个区块都要调整为8的倍数,各配置器保证的默认对齐
+        _MAX_BYTES = 128,                 // 区块最大为128
+        _NFREELISTS = _MAX_BYTES / _ALIGN // free_list的个数:16
+    };
+
     /*###################################simple_alloc begin#############################################*/
+    // 配置器是否提供good_size(n):申请n个字节时实际得到的区块大小
+    template <class Alloc, class = void>
+    struct _has_good_size : std::false_type
+    {
+    };
+
+    template <class Alloc>
+    struct _has_good_size<Alloc, decltype((void)Alloc::good_size(size_t()))> : std::true_type
+    {
+    };
+
+    // alignof(T)超过_ALIGN时(如__m256,alignas(64)的计数器)改用Alloc的allocate_aligned/deallocate_aligned
+    // 定义LP_ALLOC_TRACE时每次操作都记录到分配轨迹日志,见lp_alloc_trace.h
     template <class T, class Alloc>
     class simple_alloc
     {
+    private:
+        using over_aligned = std::integral_constant<bool, (alignof(T) > _ALIGN)>;
+
     public:
         static T *allocate(size_t n)
         {
-            return 0 == n ? 0 : (T *)Alloc::allocate(n * sizeof(T));
+            return 0 == n ? 0 : _allocate(n * sizeof(T));
         }
         static T *allocate(void)
         {
-            return (T *)Alloc::allocate(sizeof(T));
+            return _allocate(sizeof(T));
         }
         static void deallocate(T *p, size_t n)
         {
             if (0 != n)
             {
-                Alloc::deallocate(p, n * sizeof(T));
+                _deallocate(p, n * sizeof(T));
             }
         }
         static void deallocate(T *p)
         {
-            Alloc::deallocate(p, sizeof(T));
+            _deallocate(p, sizeof(T));
+        }
+        // 把p处的old_n个T调整为new_n个,内容按字节搬动,只能用于平凡可拷贝的T
+        static T *reallocate(T *p, size_t old_n, size_t new_n)
+        {
+            if (0 == old_n)
+            {
+                return allocate(new_n);
+            }
+            if (0 == new_n)
+            {
+                deallocate(p, old_n);
+                return 0;
+            }
+            _LP_ALLOC_TRACE(alloc_tracer::record<Alloc>(_TRACE_REALLOC_FREE, p, old_n * sizeof(T), alignof(T)));
+            T *result = (T *)_reallocate(p, old_n * sizeof(T), new_n * sizeof(T), over_aligned());
+            _LP_ALLOC_TRACE(alloc_tracer::record<Alloc>(_TRACE_REALLOC_ALLOC, result, new_n * sizeof(T), alignof(T)));
+            return result;
+        }
+        // 申请n个T时区块实际能容纳的T的个数,不小于n;配置器没有good_size或T过度对齐时就是n
+        static size_t good_size(size_t n)
+        {
+            return 0 == n ? 0 : _good_size(n, std::integral_constant<bool, _has_good_size<Alloc>::value && !over_aligned::value>());
+        }
+
+    private:
+        static size_t _good_size(size_t n, std::true_type) { return Alloc::good_size(n * sizeof(T)) / sizeof(T); }
+        static size_t _good_size(size_t n, std::false_type) { return n; }
+        static T *_allocate(size_t bytes)
+        {
+            T *result = (T *)_allocate(bytes, over_aligned());
+            _LP_ALLOC_TRACE(alloc_tracer::record<Alloc>(_TRACE_ALLOC, result, bytes, alignof(T)));
+            return result;
+        }
+        static void _deallocate(T *p, size_t bytes)
+        {
+            _LP_ALLOC_TRACE(alloc_tracer::record<Alloc>(_TRACE_FREE, p, bytes, alignof(T)));
+            _deallocate(p, bytes, over_aligned());
+        }
+        static void *_allocate(size_t bytes, std::false_type) { return Alloc::allocate(bytes); }
+        static void *_allocate(size_t bytes, std::true_type) { return Alloc::allocate_aligned(bytes, alignof(T)); }
+        static void _deallocate(T *p, size_t bytes, std::false_type) { Alloc::deallocate(p, bytes); }
+        static void _deallocate(T *p, size_t bytes, std::true_type) { Alloc::deallocate_aligned(p, bytes, alignof(T)); }
+        static void *_reallocate(T *p, size_t old_bytes, size_t new_bytes, std::false_type)
+        {
+            return Alloc::reallocate(p, old_bytes, new_bytes);
+        }
+        // 配置器的reallocate不保证对齐,另取一块对齐的区块再拷贝
+        static void *_reallocate(T *p, size_t old_bytes, size_t new_bytes, std::true_type)
+        {
+            void *result = Alloc::allocate_aligned(new_bytes, alignof(T));
+            memcpy(result, p, old_bytes < new_bytes ? old_bytes : new_bytes);
+            Alloc::deallocate_aligned(p, old_bytes, alignof(T));
+            return result;
         }
     };
     /* simple_alloc的使用示例
@@ -66,10 +153,11 @@ namespace lp
     /*
      * 一级配置器使用malloc,realloc,free进行内存的分配和释放
      * 采用强行退出的方式解决内存不足(分配失败)的问题
+     * 第二参数ChunkSource可把内存来源换成mmap/大页,见lp_chunk_source.h
      */
     // 注意：inst为非型别参数，完全无用。
     //inst:单纯为了能使用模板编程
-    template <int inst>
+    template <int inst, class ChunkSource = malloc_chunk_source>
     class _malloc_alloc_template
     {
     private:
@@ -82,8 +170,8 @@ namespace lp
     public:
         static void *allocate(size_t n)
         {
-            // 一级配置器直接使用malloc
-            void *result = malloc(n);
+            // 一级配置器直接使用malloc(或ChunkSource)
+            void *result = ChunkSource::allocate(n);
             if (0 == result)
             {
                 result = oom_malloc(n);
@@ -93,30 +181,46 @@ namespace lp
 
         static void deallocate(void *p, size_t n)
         {
-            // 一级配置器直接使用free
-            free(p);
+            // 一级配置器直接使用free(或ChunkSource)
+            ChunkSource::deallocate(p, n);
         }
 
         static void *reallocate(void *p, size_t old_size, size_t new_size)
         {
-            void *result = realloc(p, new_size);
+            void *result = ChunkSource::reallocate(p, old_size, new_size);
             if (0 == result)
             {
                 result = oom_realloc(p, new_size);
             }
             return result;
         }
+
+        // 按align对齐,align为2的幂
+        static void *allocate_aligned(size_t n, size_t align)
+        {
+            void *result = ChunkSource::allocate_aligned(n, align);
+            if (0 == result)
+            {
+                result = oom_malloc(n);
+            }
+            return result;
+        }
+
+        static void deallocate_aligned(void *p, size_t n, size_t align)
+        {
+            ChunkSource::deallocate_aligned(p, n, align);
+        }
     };
 
-    template <int inst>
-    void *_malloc_alloc_template<inst>::oom_malloc(size_t n)
+    template <int inst, class ChunkSource>
+    void *_malloc_alloc_template<inst, ChunkSource>::oom_malloc(size_t n)
     {
         std::cerr << "out of memory" << std::endl;
         exit(1);
     }
 
-    template <int inst>
-    void *_malloc_alloc_template<inst>::oom_realloc(void *p, size_t n)
+    template <int inst, class ChunkSource>
+    void *_malloc_alloc_template<inst, ChunkSource>::oom_realloc(void *p, size_t n)
     {
         std::cerr << "out of memory" << std::endl;
         exit(1);
@@ -124,34 +228,125 @@ namespace lp
 
     // 注意,以下直接将参数inst指定为0
     using malloc_alloc = _malloc_alloc_template<0>;
+    // 不小于2MB的区块来自2MB对齐的透明大页,适合大vector等随机访问的大缓冲区
+    using huge_page_alloc = _malloc_alloc_template<0, thp_chunk_source>;
     // endregion:一级配置器
     /*###################################_malloc_alloc_template end#############################################*/
 
     /*###################################_default_alloc_template begin#############################################*/
     // region:二级配置器
     /*
-     * 区块大于128 bytes时,移交一级配置器
-     * 区块小于128 bytes时,用内存池进行管理
+     * 区块大于SizeClass::max_bytes(默认128 bytes)时,移交一级配置器
+     * 区块不大于max_bytes时,用内存池进行管理
      * 内存池管理办法:每次取一块大内存,维护对应的free_list,
      *  有内存需求时从free_list中找内存满足,释放内存时,加入到free_list中
-     * 二级配置器会主动将任何小额区块的内存需求上调至8的倍数,并维护16个free_list
+     * 二级配置器会主动将任何小额区块的内存需求上调至某个规格,每个规格维护一个free_list
+     *  规格由SizeClass策略给出(见lp_size_class.h),默认为8,16,...,128共16个规格
+     *  _geometric_size_class可把内存池扩展到几KB,同时保持规格个数较少
+     *
+     * 多线程模式(threads == true):
+     *  每个线程持有一份thread_cache(每个规格一个线程本地free_list),allocate/deallocate只操作本线程的缓存,不加锁
+     *  线程缓存用空时,加锁从共享的depot中整批取回batch_objs个对象;depot也空时再从内存池切分
+     *  线程缓存超过2 * batch_objs个对象时,把多出的一整批交还depot,供其他线程取用
+     *  线程退出时,其缓存中的对象全部并入中央free_list
+     *
+     * 归还内存(trim):
+     *  每次从系统取得的chunk头部都带一个chunk_header,串成chunk_list,记录所有chunk
+     *  trim()统计每个chunk中位于free_list和内存池里的字节数,等于chunk大小的即完全空闲,
+     *  把其中的对象从free_list摘除后free掉整个chunk
+     *  set_trim_threshold(bytes)后,free_list中的字节数每增长bytes就自动trim一次
+     *  多线程模式下其他线程缓存中的对象视为仍在使用,trim只会先归还调用线程自己的缓存
+     *
+     * 对齐的区块(allocate_aligned):
+     *  对齐不超过_ALIGN时等同allocate
+     *  16,32,64字节对齐且不大于max_bytes的区块,每种对齐各有一组free_list,区块大小取align倍数的规格,
+     *  切分时先把内存池起点调整到align的倍数;多线程模式下这组free_list在depot_lock下访问
+     *  更大的对齐(如页对齐)或更大的区块移交一级配置器
+     *
+     * 第四参数ChunkSource决定chunk和大区块的来源,默认malloc
+     *  使用_mmap_chunk_source时chunk至少为其Threshold(默认2MB)且按其粒度取整,整个chunk可由大页承载
+     *
+     * refill的批量:
+     *  每个规格各自记录下一次refill向内存池要的对象个数,从下限开始
+     *  每次refill(free_list被取空,说明需求持续)后加倍,直到上限
+     *  free_list中的对象个数向上越过两次refill的量时(对象闲置)减半,不低于下限
+     *  上下限由set_refill_bounds(min,max)设定,另外一次refill不超过_REFILL_BYTES字节
+     *  set_refill_bounds(20,20)即原先固定20个的做法
      */
 
+    // 多线程模式使用的参数
     enum
     {
-        _ALIGN = 8,                       // 每个区块都要调整为8的倍数
-        _MAX_BYTES = 128,                 // 区块最大为128
-        _NFREELISTS = _MAX_BYTES / _ALIGN // free_list的个数:16
+        _BATCH_OBJS = 32,         // 线程缓存与depot之间一次搬运的对象个数上限
+        _BATCH_BYTES = 16 * 1024, // 一批对象的总字节上限,大区块的批量因此更小
+        _DEPOT_SLOTS = 64         // depot中每个free_list最多暂存的batch个数,超出后并入中央free_list
+    };
+    // refill批量的默认参数
+    enum
+    {
+        _REFILL_MIN_OBJS = 4,      // 默认下限,也是每个规格第一次refill的个数
+        _REFILL_MAX_OBJS = 512,    // 默认上限
+        _REFILL_BYTES = 32 * 1024  // 一次refill的字节上限,大区块的上限因此更小
+    };
+    // 内存池负责的对齐
+    enum
+    {
+        _MAX_POOL_ALIGN = 64, // 内存池负责的最大对齐,更大的对齐移交一级配置器
+        _POOL_ALIGNS = 3,     // 16,32,64三种对齐,各有一组free_list
+        _ALIGNED_REFILL_OBJS = 8
     };
     // 注意,无"template型别参数",且第二参数完全没派上用场
-    // 第一参数用于多线程环境下,我们不考虑多线程环境,但依然保留该参数
-    template <bool threads, int inst>
+    // 第一参数决定是否启用多线程模式,见上方说明;第三参数为规格策略;第四参数为chunk来源
+    template <bool threads, int inst, class SizeClass = _linear_size_class<_ALIGN, _MAX_BYTES>,
+              class ChunkSource = malloc_chunk_source>
     class _default_alloc_template
     {
     public:
-        static void *allocate(size_t n);
-        static void deallocate(void *p, size_t n);
+        static void *allocate(size_t n)
+        {
+            return _allocate(n, multithreaded());
+        }
+        // 申请n个字节时实际得到的区块大小
+        static size_t good_size(size_t n)
+        {
+            return n > SizeClass::max_bytes || 0 == n ? n : class_size(free_list_index(n));
+        }
+        // 申请n个字节时使用的规格编号,移交一级配置器时返回nclasses
+        static size_t size_class(size_t n)
+        {
+            return n > SizeClass::max_bytes || 0 == n ? SizeClass::nclasses : free_list_index(n);
+        }
+        static void deallocate(void *p, size_t n)
+        {
+            _deallocate(p, n, multithreaded());
+        }
         static void *reallocate(void *p, size_t old_size, size_t new_size);
+        // 按align对齐,align为2的幂;deallocate_aligned的n和align须与申请时相同
+        static void *allocate_aligned(size_t n, size_t align);
+        static void deallocate_aligned(void *p, size_t n, size_t align);
+
+        // 把完全空闲的chunk归还系统,返回归还的字节数
+        static size_t trim()
+        {
+            return _trim(multithreaded());
+        }
+        // free_list中的字节数每增长bytes就自动trim一次,0表示关闭
+        static void set_trim_threshold(size_t bytes);
+        // refill一次向内存池要的对象个数的上下限,各规格的批量重新从下限开始
+        static void set_refill_bounds(int min_objs, int max_objs);
+
+#ifdef LP_ALLOC_STATS
+        // 统计信息,见lp_alloc_stats.h
+        static alloc_stats stats();
+        static void print_stats(std::ostream &os = std::cerr)
+        {
+            print_alloc_stats(os, stats());
+        }
+        static void dump_stats_at_exit()
+        {
+            atexit(dump_stats);
+        }
+#endif
 
     private:
         // free_list的节点使用union节省开销
@@ -161,91 +356,538 @@ namespace lp
             char client_data[1];
         };
 
-        // 16个free_list
-        static obj *volatile free_list[_NFREELISTS];
+        // 每个规格一个free_list,多线程模式下作为中央free_list,只在持有depot_lock时访问
+        static obj *volatile free_list[SizeClass::nclasses];
+        // 对齐区块的free_list,aligned_free_list[k]中的区块按(16 << k)对齐
+        static obj *volatile aligned_free_list[_POOL_ALIGNS][SizeClass::nclasses];
+        // k为0时是普通的free_list,否则是第k - 1组对齐的free_list
+        static obj *volatile *free_lists_of(size_t k)
+        {
+            return 0 == k ? free_list : aligned_free_list[k - 1];
+        }
+        // 容纳n个字节且大小为align倍数的规格的编号,内存池不负责时返回nclasses
+        static size_t aligned_index(size_t n, size_t align)
+        {
+            size_t bytes = (n + align - 1) & ~(align - 1);
+            if (align > _MAX_POOL_ALIGN || bytes > SizeClass::max_bytes)
+            {
+                return SizeClass::nclasses;
+            }
+            size_t index = free_list_index(bytes);
+            while (index < SizeClass::nclasses && 0 != class_size(index) % align)
+            {
+                ++index;
+            }
+            return index;
+        }
+        static size_t align_slot(size_t align)
+        {
+            return 16 == align ? 0 : (32 == align ? 1 : 2);
+        }
+        // 为对齐的free_list切分一批区块,返回其中一个
+        static void *aligned_refill(size_t index, size_t align);
+
+        using multithreaded = std::integral_constant<bool, threads>;
+        // 大区块移交的一级配置器,与内存池使用同一个chunk来源
+        using large_alloc = _malloc_alloc_template<inst, ChunkSource>;
 
     private:
-        // round_up将bytes调整为8的倍数
+        // round_up将bytes调整为_ALIGN的倍数,用于内存池的增长量
         static size_t round_up(size_t bytes)
         {
             return (((bytes) + _ALIGN - 1) & ~(_ALIGN - 1));
         }
-        // 根据区块大小,决定使用第n好free_list,n从1开始算
+        // 根据区块大小,决定使用第n号free_list,n从0开始算,查SizeClass的编译期查找表
         static size_t free_list_index(size_t bytes)
         {
-            std::cerr << (((bytes) + _ALIGN - 1) / _ALIGN) - 1 << std::endl;
-            return (((bytes) + _ALIGN - 1) / _ALIGN) - 1;
+            return SizeClass::index(bytes);
+        }
+        // 第index号free_list的区块大小
+        static size_t class_size(size_t index)
+        {
+            return SizeClass::size(index);
+        }
+        // 多线程模式下第index号free_list一批搬运的对象个数,大区块按_BATCH_BYTES减少批量
+        static int batch_objs(size_t index)
+        {
+            size_t n = _BATCH_BYTES / class_size(index);
+            return n >= (size_t)_BATCH_OBJS ? (int)_BATCH_OBJS : (n < 2 ? 2 : (int)n);
+        }
+        // 第index号free_list一次refill的对象个数上限
+        static int refill_limit(size_t index)
+        {
+            size_t n = _REFILL_BYTES / class_size(index);
+            int hi = n < (size_t)refill_max ? (int)n : refill_max;
+            return hi < refill_min ? refill_min : hi;
+        }
+        // 返回本次refill的对象个数,并把下一次的个数加倍
+        static int grow_refill(size_t index);
+        // free_list(含depot)新增k个对象,对象个数向上越过两次refill的量时把下一次的个数减半
+        static void count_free(size_t index, size_t k)
+        {
+            size_t idle = 2 * (size_t)refill_objs[index];
+            size_t before = free_count[index];
+            free_count[index] = before + k;
+            if (before < idle && before + k >= idle)
+            {
+                shrink_refill(index);
+            }
         }
+        static void shrink_refill(size_t index)
+        {
+            int nobjs = refill_objs[index] / 2;
+            refill_objs[index] = nobjs < refill_min ? refill_min : nobjs;
+        }
+        // 把内存池剩下的零头按从大到小的规格切分,挂到对应的free_list上
+        static void stash_leftover(char *p, size_t bytes);
         // 重新填充区块大小为n的内存池
         static void *refill(size_t n);
-        // 配置一大块空间,可容纳n个特定大小的obf
-        static char *chunk_alloc(size_t size, int &nobjs);
+        // 配置一大块空间,可容纳n个特定大小的obf,起点按align对齐
+        static char *chunk_alloc(size_t size, int &nobjs, size_t align = _ALIGN);
         // chunk alloc 中使用的状态参数
         static char *start_free; // 内存池起始位置,只在chunk_alloc中改变
         static char *end_free;   // 内存池结束位置,只在chunk_alloc中改变
 
         static size_t heap_size;
+
+        // refill的批量,多线程模式下只在持有depot_lock时访问
+        static int refill_objs[SizeClass::nclasses]; // 下一次refill的对象个数,0表示尚未refill过
+        static size_t free_count[SizeClass::nclasses]; // free_list(含depot)中的对象个数
+        static int refill_min;
+        static int refill_max;
+
+        // region:chunk记录与trim
+        // 每个chunk头部的记录,size不含chunk_header本身;大小为_ALIGN的倍数,不影响区块对齐
+        struct chunk_header
+        {
+            chunk_header *next;
+            size_t size;
+        };
+        // trim时每个chunk的统计信息
+        struct chunk_usage
+        {
+            char *begin;
+            char *end;
+            size_t free_bytes;
+            bool operator<(const chunk_usage &x) const { return begin < x.begin; }
+        };
+        static chunk_usage *find_chunk(chunk_usage *usage, size_t n, char *p);
+        // 调用者须保证独占内存池(单线程模式,或已持有depot_lock)
+        static size_t trim_pool();
+        static size_t _trim(std::false_type) { return trim_pool(); }
+        static size_t _trim(std::true_type);
+
+        static chunk_header *chunk_list; // 从系统取得的所有chunk
+        static size_t free_bytes;        // free_list(含depot)中的字节数
+        static size_t trim_threshold;    // 自动trim的步长,0表示关闭
+        static size_t trim_mark;         // free_bytes达到该值时自动trim
+        // endregion
+
+    private:
+        // region:单线程/多线程两个版本的allocate和deallocate,由multithreaded()分派
+        static void *_allocate(size_t n, std::false_type);
+        static void _deallocate(void *p, size_t n, std::false_type);
+        static void *_allocate(size_t n, std::true_type);
+        static void _deallocate(void *p, size_t n, std::true_type);
+        // endregion
+
+        // region:多线程模式
+        // 线程本地缓存,每个free_list额外记录对象个数,用于判断何时整批交还depot
+        struct thread_cache
+        {
+            obj *list[SizeClass::nclasses];
+            int count[SizeClass::nclasses];
+            int batch[SizeClass::nclasses]; // 预先算好的batch_objs,避免快速路径上做除法
+#ifdef LP_ALLOC_STATS
+            _alloc_class_counters counters[SizeClass::nclasses + 1]; // 本线程的计数,最后一项为大区块
+            thread_cache *prev_cache;                                // 所有活着的线程缓存串成双向链表,供stats()汇总
+            thread_cache *next_cache;
+#endif
+
+            thread_cache()
+            {
+                for (int i = 0; i < (int)SizeClass::nclasses; ++i)
+                {
+                    list[i] = 0;
+                    count[i] = 0;
+                    batch[i] = batch_objs(i);
+                }
+#ifdef LP_ALLOC_STATS
+                std::lock_guard<std::mutex> guard(depot_lock);
+                prev_cache = 0;
+                next_cache = live_caches;
+                if (0 != live_caches)
+                {
+                    live_caches->prev_cache = this;
+                }
+                live_caches = this;
+#endif
+            }
+            // 线程退出时把缓存中的对象全部并入中央free_list
+            ~thread_cache()
+            {
+                cache_destroyed() = true;
+                for (int i = 0; i < (int)SizeClass::nclasses; ++i)
+                {
+                    if (0 != list[i])
+                    {
+                        release_batch(i, list[i], count[i]);
+                        list[i] = 0;
+                        count[i] = 0;
+                    }
+                }
+#ifdef LP_ALLOC_STATS
+                // 本线程的计数并入全局计数器
+                std::lock_guard<std::mutex> guard(depot_lock);
+                for (int i = 0; i <= (int)SizeClass::nclasses; ++i)
+                {
+                    counters_of_all[i].allocs.add(counters[i].allocs.get());
+                    counters_of_all[i].frees.add(counters[i].frees.get());
+                    counters_of_all[i].hits.add(counters[i].hits.get());
+                }
+                (0 != prev_cache ? prev_cache->next_cache : live_caches) = next_cache;
+                if (0 != next_cache)
+                {
+                    next_cache->prev_cache = prev_cache;
+                }
+#endif
+            }
+        };
+        // 本线程的缓存是否已析构;bool平凡析构,线程退出的全过程都可以读,不能放进thread_cache本身
+        static bool &cache_destroyed()
+        {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+        // 返回本线程的缓存;线程本地对象已析构(线程退出阶段)时返回0,调用方改走加锁路径
+        static thread_cache *local_cache()
+        {
+            if (cache_destroyed())
+            {
+                return 0;
+            }
+            static thread_local thread_cache cache;
+            return &cache;
+        }
+        // 为第index号free_list取一批对象,返回以0结尾的链表,nobjs带回对象个数
+        static obj *fetch_batch(size_t index, int &nobjs);
+        // 把以0结尾,含nobjs个对象的链表first交还给第index号free_list
+        static void release_batch(size_t index, obj *first, int nobjs);
+
+        static std::mutex depot_lock; // 保护depot,中央free_list和内存池状态
+        // depot:每个free_list暂存若干整批对象,每批batch_objs个,以0结尾
+        static obj *depot[SizeClass::nclasses][_DEPOT_SLOTS];
+        static int depot_count[SizeClass::nclasses];
+        // endregion
+
+#ifdef LP_ALLOC_STATS
+        // region:统计
+        // 单线程模式下快速路径的计数;多线程模式下为已退出线程及加锁路径的计数;最后一项为大区块
+        static _alloc_class_counters counters_of_all[SizeClass::nclasses + 1];
+        // 以下计数器只在内存池路径上修改(多线程模式下持有depot_lock)
+        static _stat_counter refills[SizeClass::nclasses];
+        static _stat_counter leftover_bytes[SizeClass::nclasses];
+        static _stat_counter chunk_allocs;
+        static thread_cache *live_caches;
+        // 快速路径上使用的计数器:多线程模式下优先用线程缓存中的一份
+        static _alloc_class_counters &counters_for(thread_cache *cache, size_t index)
+        {
+            return 0 != cache ? cache->counters[index] : counters_of_all[index];
+        }
+        static void dump_stats()
+        {
+            print_stats(std::cerr);
+        }
+        // 多线程模式下统计大区块的allocate/deallocate
+        static void count_large_mt(bool is_alloc);
+        // endregion
+#endif
     };
     // static参数初值设定
-    template <bool threads, int inst>
-    char *_default_alloc_template<threads, inst>::start_free = 0;
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    char *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::start_free = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    char *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::end_free = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::heap_size = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    int _default_alloc_template<threads, inst, SizeClass, ChunkSource>::refill_objs[SizeClass::nclasses] = {};
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::free_count[SizeClass::nclasses] = {};
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    int _default_alloc_template<threads, inst, SizeClass, ChunkSource>::refill_min = _REFILL_MIN_OBJS;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    int _default_alloc_template<threads, inst, SizeClass, ChunkSource>::refill_max = _REFILL_MAX_OBJS;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::chunk_header *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::chunk_list = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::free_bytes = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::trim_threshold = 0;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::trim_mark = ~size_t(0);
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::obj *volatile _default_alloc_template<threads, inst, SizeClass, ChunkSource>::free_list[SizeClass::nclasses] = {};
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::obj *volatile _default_alloc_template<threads, inst, SizeClass, ChunkSource>::aligned_free_list[_POOL_ALIGNS][SizeClass::nclasses] = {};
+
+    // std::mutex的构造函数是constexpr,depot相关的静态成员都是常量初始化,不存在初始化顺序问题
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    std::mutex _default_alloc_template<threads, inst, SizeClass, ChunkSource>::depot_lock;
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::obj *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::depot[SizeClass::nclasses][_DEPOT_SLOTS] = {};
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    int _default_alloc_template<threads, inst, SizeClass, ChunkSource>::depot_count[SizeClass::nclasses] = {};
+
+#ifdef LP_ALLOC_STATS
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    _alloc_class_counters _default_alloc_template<threads, inst, SizeClass, ChunkSource>::counters_of_all[SizeClass::nclasses + 1];
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    _stat_counter _default_alloc_template<threads, inst, SizeClass, ChunkSource>::refills[SizeClass::nclasses];
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    _stat_counter _default_alloc_template<threads, inst, SizeClass, ChunkSource>::leftover_bytes[SizeClass::nclasses];
 
-    template <bool threads, int inst>
-    char *_default_alloc_template<threads, inst>::end_free = 0;
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    _stat_counter _default_alloc_template<threads, inst, SizeClass, ChunkSource>::chunk_allocs;
 
-    template <bool threads, int inst>
-    size_t _default_alloc_template<threads, inst>::heap_size = 0;
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::thread_cache *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::live_caches = 0;
+#endif
 
-    template <bool threads, int inst>
-    typename _default_alloc_template<threads, inst>::obj *volatile _default_alloc_template<threads, inst>::free_list[_NFREELISTS] =
-        {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     // allocate,reallocate,deallocate的具体实现
-    template <bool threads, int inst>
-    void *_default_alloc_template<threads, inst>::allocate(size_t n)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::_allocate(size_t n, std::false_type)
     {
         obj *volatile *my_free_list;
         obj *result;
-        if (n > _MAX_BYTES)
+        if (n > SizeClass::max_bytes)
         {
-            return (malloc_alloc::allocate(n));
+            _LP_ALLOC_STAT(counters_of_all[SizeClass::nclasses].allocs.add(1));
+            return (large_alloc::allocate(n));
         }
-        my_free_list = free_list + free_list_index(n);
+        size_t index = free_list_index(n);
+        _LP_ALLOC_STAT(counters_of_all[index].allocs.add(1));
+        my_free_list = free_list + index;
         result = *my_free_list;
         if (0 == result)
         {
-            void *r = refill(round_up(n));
+            void *r = refill(class_size(index));
             return r;
         }
         *my_free_list = result->free_list_link;
+        free_bytes -= class_size(index);
+        --free_count[index];
+        _LP_ALLOC_STAT(counters_of_all[index].hits.add(1));
         return result;
     }
 
-    template <bool threads, int inst>
-    void _default_alloc_template<threads, inst>::deallocate(void *p, size_t n)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::_deallocate(void *p, size_t n, std::false_type)
     {
         obj *q = (obj *)p;
         obj *volatile *my_free_list;
-        if (n > _MAX_BYTES)
+        if (n > SizeClass::max_bytes)
         {
-            malloc_alloc::deallocate(p, n);
+            _LP_ALLOC_STAT(counters_of_all[SizeClass::nclasses].frees.add(1));
+            large_alloc::deallocate(p, n);
             return;
         }
-        my_free_list = free_list + free_list_index(n);
+        size_t index = free_list_index(n);
+        _LP_ALLOC_STAT(counters_of_all[index].frees.add(1));
+        my_free_list = free_list + index;
         q->free_list_link = *my_free_list;
         *my_free_list = q;
+        count_free(index, 1);
+        if ((free_bytes += class_size(index)) >= trim_mark)
+        {
+            trim_pool();
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::_allocate(size_t n, std::true_type)
+    {
+        if (n > SizeClass::max_bytes)
+        {
+            _LP_ALLOC_STAT(count_large_mt(true));
+            return (large_alloc::allocate(n));
+        }
+        thread_cache *cache = local_cache();
+        if (0 == cache)
+        {
+            std::lock_guard<std::mutex> guard(depot_lock);
+            return _allocate(n, std::false_type());
+        }
+        size_t index = free_list_index(n);
+        _LP_ALLOC_STAT(cache->counters[index].allocs.add(1));
+        obj *result = cache->list[index];
+        if (0 == result)
+        {
+            // 线程缓存已空,整批取回
+            int nobjs;
+            result = fetch_batch(index, nobjs);
+            cache->list[index] = result->free_list_link;
+            cache->count[index] = nobjs - 1;
+            _LP_ALLOC_STAT(cache->counters[index].cached_objs.add(nobjs - 1));
+            return result;
+        }
+        cache->list[index] = result->free_list_link;
+        --cache->count[index];
+        _LP_ALLOC_STAT(cache->counters[index].hits.add(1));
+        _LP_ALLOC_STAT(cache->counters[index].cached_objs.sub(1));
+        return result;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::_deallocate(void *p, size_t n, std::true_type)
+    {
+        if (n > SizeClass::max_bytes)
+        {
+            _LP_ALLOC_STAT(count_large_mt(false));
+            large_alloc::deallocate(p, n);
+            return;
+        }
+        thread_cache *cache = local_cache();
+        if (0 == cache)
+        {
+            std::lock_guard<std::mutex> guard(depot_lock);
+            _deallocate(p, n, std::false_type());
+            return;
+        }
+        size_t index = free_list_index(n);
+        _LP_ALLOC_STAT(cache->counters[index].frees.add(1));
+        _LP_ALLOC_STAT(cache->counters[index].cached_objs.add(1));
+        obj *q = (obj *)p;
+        q->free_list_link = cache->list[index];
+        cache->list[index] = q;
+        int batch_size = cache->batch[index];
+        if (++cache->count[index] >= 2 * batch_size)
+        {
+            // 保留表头最近释放的batch_size个(缓存中较热),把其后的一整批交还depot
+            obj *cut = cache->list[index];
+            for (int i = 1; i < batch_size; ++i)
+            {
+                cut = cut->free_list_link;
+            }
+            obj *batch = cut->free_list_link;
+            cut->free_list_link = 0;
+            cache->count[index] -= batch_size;
+            _LP_ALLOC_STAT(cache->counters[index].cached_objs.sub(batch_size));
+            release_batch(index, batch, batch_size);
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::obj *
+    _default_alloc_template<threads, inst, SizeClass, ChunkSource>::fetch_batch(size_t index, int &nobjs)
+    {
+        std::lock_guard<std::mutex> guard(depot_lock);
+        // 优先从depot整批取回,O(1)
+        if (depot_count[index] > 0)
+        {
+            nobjs = batch_objs(index);
+            free_bytes -= nobjs * class_size(index);
+            free_count[index] -= nobjs;
+            return depot[index][--depot_count[index]];
+        }
+        // 其次从中央free_list摘下至多batch_objs个
+        obj *result = free_list[index];
+        if (0 != result)
+        {
+            obj *last = result;
+            nobjs = 1;
+            while (nobjs < batch_objs(index) && 0 != last->free_list_link)
+            {
+                last = last->free_list_link;
+                ++nobjs;
+            }
+            free_list[index] = last->free_list_link;
+            last->free_list_link = 0;
+            free_bytes -= nobjs * class_size(index);
+            free_count[index] -= nobjs;
+            return result;
+        }
+        // 最后从内存池切分,与refill相同,只是第一批交给线程缓存,其余挂到中央free_list
+        size_t n = class_size(index);
+        int batch = batch_objs(index);
+        nobjs = grow_refill(index);
+        if (nobjs < batch)
+        {
+            nobjs = batch;
+        }
+        _LP_ALLOC_STAT(refills[index].add(1));
+        char *chunk = chunk_alloc(n, nobjs);
+        result = (obj *)chunk;
+        for (int i = 1; i < nobjs; ++i)
+        {
+            ((obj *)(chunk + (i - 1) * n))->free_list_link = (obj *)(chunk + i * n);
+        }
+        ((obj *)(chunk + (nobjs - 1) * n))->free_list_link = free_list[index];
+        if (nobjs > batch)
+        {
+            free_list[index] = (obj *)(chunk + batch * n);
+            ((obj *)(chunk + (batch - 1) * n))->free_list_link = 0;
+            free_bytes += (nobjs - batch) * n;
+            free_count[index] += nobjs - batch;
+            nobjs = batch;
+        }
+        return result;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::release_batch(size_t index, obj *first, int nobjs)
+    {
+        std::lock_guard<std::mutex> guard(depot_lock);
+        if (batch_objs(index) == nobjs && depot_count[index] < _DEPOT_SLOTS)
+        {
+            depot[index][depot_count[index]++] = first;
+        }
+        else
+        {
+            // 零散对象(如线程退出时的缓存)或depot已满,并入中央free_list
+            obj *last = first;
+            while (0 != last->free_list_link)
+            {
+                last = last->free_list_link;
+            }
+            last->free_list_link = free_list[index];
+            free_list[index] = first;
+        }
+        count_free(index, nobjs);
+        if ((free_bytes += nobjs * class_size(index)) >= trim_mark)
+        {
+            trim_pool();
+        }
     }
 
-    template <bool threads, int inst>
-    void *_default_alloc_template<threads, inst>::reallocate(void *p, size_t old_size, size_t new_size)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::reallocate(void *p, size_t old_size, size_t new_size)
     {
         void *result;
         size_t copyz;
 
-        if (old_size > (size_t)_MAX_BYTES && new_size > (size_t)_MAX_BYTES)
+        if (old_size > SizeClass::max_bytes && new_size > SizeClass::max_bytes)
         {
-            return (realloc(p, new_size));
+            return (large_alloc::reallocate(p, old_size, new_size));
         }
-        if (round_up(old_size) == round_up(new_size))
+        if (old_size <= SizeClass::max_bytes && new_size <= SizeClass::max_bytes &&
+            free_list_index(old_size) == free_list_index(new_size))
             return (p);
         result = allocate(new_size);
         copyz = new_size > old_size ? old_size : new_size;
@@ -254,11 +896,86 @@ namespace lp
         return (result);
     }
 
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::allocate_aligned(size_t n, size_t align)
+    {
+        if (align <= _ALIGN)
+        {
+            return allocate(n);
+        }
+        size_t index = aligned_index(n, align);
+        if (SizeClass::nclasses == index)
+        {
+            return large_alloc::allocate_aligned(n, align);
+        }
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (threads)
+        {
+            guard.lock();
+        }
+        obj *volatile *my_free_list = aligned_free_list[align_slot(align)] + index;
+        obj *result = *my_free_list;
+        if (0 == result)
+        {
+            return aligned_refill(index, align);
+        }
+        *my_free_list = result->free_list_link;
+        free_bytes -= class_size(index);
+        return result;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::deallocate_aligned(void *p, size_t n, size_t align)
+    {
+        if (align <= _ALIGN)
+        {
+            deallocate(p, n);
+            return;
+        }
+        size_t index = aligned_index(n, align);
+        if (SizeClass::nclasses == index)
+        {
+            large_alloc::deallocate_aligned(p, n, align);
+            return;
+        }
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (threads)
+        {
+            guard.lock();
+        }
+        obj *volatile *my_free_list = aligned_free_list[align_slot(align)] + index;
+        ((obj *)p)->free_list_link = *my_free_list;
+        *my_free_list = (obj *)p;
+        if ((free_bytes += class_size(index)) >= trim_mark)
+        {
+            trim_pool();
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::aligned_refill(size_t index, size_t align)
+    {
+        // 对齐的区块用得少,批量固定;区块大小是align的倍数,起点对齐后每个区块都对齐
+        size_t n = class_size(index);
+        int nobjs = _ALIGNED_REFILL_OBJS;
+        char *chunk = chunk_alloc(n, nobjs, align);
+        obj *volatile *my_free_list = aligned_free_list[align_slot(align)] + index;
+        for (int i = nobjs - 1; i >= 1; --i)
+        {
+            obj *q = (obj *)(chunk + i * n);
+            q->free_list_link = *my_free_list;
+            *my_free_list = q;
+        }
+        free_bytes += (nobjs - 1) * n;
+        return chunk;
+    }
+
     // 默认内存分配器的实现
-    template <bool threads, int inst>
-    void *_default_alloc_template<threads, inst>::refill(size_t n)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::refill(size_t n)
     {
-        int nobjs = 20; // 默认尝试获取20个对象
+        int nobjs = grow_refill(free_list_index(n)); // 该规格当前的批量
+        _LP_ALLOC_STAT(refills[free_list_index(n)].add(1));
         // 注意nobjs以引用方式传递
         char *chunk = chunk_alloc(n, nobjs); // 从内存池申请内存，以填充free list
 
@@ -277,6 +994,8 @@ namespace lp
 
         // my_free_list指向相应的空闲链表桶
         my_free_list = free_list + free_list_index(n);
+        free_bytes += (nobjs - 1) * n;
+        free_count[free_list_index(n)] += nobjs - 1;
         // 返回的块是第一个对象
         result = (obj *)chunk;
 
@@ -303,13 +1022,22 @@ namespace lp
     }
 
     // 给内存池申请内存
-    template <bool threads, int inst>
-    char *_default_alloc_template<threads, inst>::chunk_alloc(size_t size, int &nobjs)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    char *_default_alloc_template<threads, inst, SizeClass, ChunkSource>::chunk_alloc(size_t size, int &nobjs, size_t align)
     {
         char *result;
         size_t total_bytes = size * nobjs;         // 计算需要申请的总字节
         size_t bytes_left = end_free - start_free; // 计算内存池剩余字节
 
+        // 对齐的请求先把内存池起点调整到align的倍数,跳过的零头挂到普通free_list上
+        size_t pad = (align - (size_t)start_free % align) % align;
+        if (0 != pad && pad <= bytes_left)
+        {
+            stash_leftover(start_free, pad);
+            start_free += pad;
+            bytes_left -= pad;
+        }
+
         // 如果内存池剩余空间完全满足需求，则直接分配
         if (bytes_left >= total_bytes)
         {
@@ -334,60 +1062,353 @@ namespace lp
             // 尝试将内存池中剩余的部分也加入到对应的free list中
             if (bytes_left > 0)
             {
-                obj *volatile *my_free_list = free_list + free_list_index(bytes_left);
-
-                ((obj *)start_free)->free_list_link = *my_free_list;
-                *my_free_list = (obj *)start_free;
+                stash_leftover(start_free, bytes_left);
             }
 
-            // 从堆上申请内存
-            start_free = (char *)malloc(bytes_to_get);
-            if (0 == start_free)
+            // 从堆上申请内存,头部留出chunk_header记录该chunk;按ChunkSource的粒度取整,多出的部分也归内存池
+            bytes_to_get = ChunkSource::chunk_size(sizeof(chunk_header) + bytes_to_get) - sizeof(chunk_header);
+            chunk_header *chunk = (chunk_header *)ChunkSource::allocate(sizeof(chunk_header) + bytes_to_get);
+            _LP_ALLOC_STAT(chunk_allocs.add(1));
+            if (0 == chunk)
             {
                 // 处理堆内存申请失败
                 // 尝试利用我们手上的东西（较大的空闲块）来满足需求
                 size_t i;
                 obj *volatile *my_free_list;
                 obj *p;
-                for (i = size; i <= (size_t)_MAX_BYTES; i += (size_t)_ALIGN)
+                for (i = free_list_index(size); i < SizeClass::nclasses; ++i)
                 {
-                    my_free_list = free_list + free_list_index(i);
+                    my_free_list = free_list + i;
                     p = *my_free_list;
                     if (0 != p)
                     {
                         // 调整free list以释放出未使用的内存块
                         *my_free_list = p->free_list_link;
+                        free_bytes -= class_size(i);
+                        --free_count[i];
                         start_free = (char *)p;
-                        end_free = start_free + i;
+                        end_free = start_free + class_size(i);
                         // 递归调用自己，以再次尝试满足内存申请的需求
-                        return (chunk_alloc(size, nobjs));
+                        return (chunk_alloc(size, nobjs, align));
                     }
                 }
                 end_free = 0; // 没有内存可以用了
 
                 // 调用一级配置器，异常情况下的处理
-                start_free = (char *)malloc_alloc::allocate(bytes_to_get);
+                chunk = (chunk_header *)large_alloc::allocate(sizeof(chunk_header) + bytes_to_get);
             }
 
-            // 成功从堆上获取了内存，更新内存池
+            // 成功从堆上获取了内存，记录chunk并更新内存池
+            chunk->size = bytes_to_get;
+            chunk->next = chunk_list;
+            chunk_list = chunk;
+            start_free = (char *)(chunk + 1);
             heap_size += bytes_to_get;
             end_free = start_free + bytes_to_get;
 
             // 递归调用自己，以再次尝试满足申请
-            return (chunk_alloc(size, nobjs));
+            return (chunk_alloc(size, nobjs, align));
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::stash_leftover(char *p, size_t bytes)
+    {
+        // 零头总是_ALIGN的倍数,而最小规格为_ALIGN,因此总能切分干净
+        while (bytes >= class_size(0))
+        {
+            size_t index = SizeClass::floor_index(bytes);
+            obj *volatile *my_free_list = free_list + index;
+            ((obj *)p)->free_list_link = *my_free_list;
+            *my_free_list = (obj *)p;
+            p += class_size(index);
+            bytes -= class_size(index);
+            free_bytes += class_size(index);
+            ++free_count[index];
+            _LP_ALLOC_STAT(leftover_bytes[index].add(class_size(index)));
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::set_trim_threshold(size_t bytes)
+    {
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (threads)
+        {
+            guard.lock();
+        }
+        trim_threshold = bytes;
+        trim_mark = 0 == bytes ? ~size_t(0) : free_bytes + bytes;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::set_refill_bounds(int min_objs, int max_objs)
+    {
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (threads)
+        {
+            guard.lock();
+        }
+        refill_min = min_objs < 1 ? 1 : min_objs;
+        refill_max = max_objs < refill_min ? refill_min : max_objs;
+        for (size_t i = 0; i < SizeClass::nclasses; ++i)
+        {
+            refill_objs[i] = 0;
+        }
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    int _default_alloc_template<threads, inst, SizeClass, ChunkSource>::grow_refill(size_t index)
+    {
+        int hi = refill_limit(index);
+        int nobjs = refill_objs[index] < refill_min ? refill_min : refill_objs[index];
+        if (nobjs > hi)
+        {
+            nobjs = hi;
+        }
+        refill_objs[index] = nobjs < hi / 2 ? nobjs * 2 : hi;
+        return nobjs;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::_trim(std::true_type)
+    {
+        // 先把调用线程自己缓存的对象交回,其他线程的缓存无法在此访问
+        thread_cache *cache = local_cache();
+        if (0 != cache)
+        {
+            for (int i = 0; i < (int)SizeClass::nclasses; ++i)
+            {
+                if (0 != cache->list[i])
+                {
+                    release_batch(i, cache->list[i], cache->count[i]);
+                    cache->list[i] = 0;
+                    cache->count[i] = 0;
+                }
+            }
+        }
+        std::lock_guard<std::mutex> guard(depot_lock);
+        return trim_pool();
+    }
+
+    // 在按地址排好序的usage中二分查找包含p的chunk,找不到返回0
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    typename _default_alloc_template<threads, inst, SizeClass, ChunkSource>::chunk_usage *
+    _default_alloc_template<threads, inst, SizeClass, ChunkSource>::find_chunk(chunk_usage *usage, size_t n, char *p)
+    {
+        size_t lo = 0, hi = n;
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            if (p < usage[mid].begin)
+            {
+                hi = mid;
+            }
+            else if (p >= usage[mid].end)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                return usage + mid;
+            }
+        }
+        return 0;
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    size_t _default_alloc_template<threads, inst, SizeClass, ChunkSource>::trim_pool()
+    {
+        size_t released = 0;
+        // depot中的整批对象先并回中央free_list,统一扫描
+        for (size_t i = 0; i < SizeClass::nclasses; ++i)
+        {
+            while (depot_count[i] > 0)
+            {
+                obj *first = depot[i][--depot_count[i]];
+                obj *last = first;
+                while (0 != last->free_list_link)
+                {
+                    last = last->free_list_link;
+                }
+                last->free_list_link = free_list[i];
+                free_list[i] = first;
+            }
+        }
+
+        size_t nchunks = 0;
+        for (chunk_header *c = chunk_list; 0 != c; c = c->next)
+        {
+            ++nchunks;
+        }
+        chunk_usage *usage = 0 == nchunks ? 0 : (chunk_usage *)malloc(nchunks * sizeof(chunk_usage));
+        if (0 != usage)
+        {
+            // 统计每个chunk中空闲的字节数:free_list中的对象加上内存池剩余部分
+            chunk_usage *u = usage;
+            for (chunk_header *c = chunk_list; 0 != c; c = c->next, ++u)
+            {
+                u->begin = (char *)(c + 1);
+                u->end = u->begin + c->size;
+                u->free_bytes = 0;
+            }
+            std::sort(usage, usage + nchunks);
+            for (size_t k = 0; k <= _POOL_ALIGNS; ++k)
+            {
+                obj *volatile *lists = free_lists_of(k);
+                for (size_t i = 0; i < SizeClass::nclasses; ++i)
+                {
+                    for (obj *p = lists[i]; 0 != p; p = p->free_list_link)
+                    {
+                        if (0 != (u = find_chunk(usage, nchunks, (char *)p)))
+                        {
+                            u->free_bytes += class_size(i);
+                        }
+                    }
+                }
+            }
+            if (start_free != end_free && 0 != (u = find_chunk(usage, nchunks, start_free)))
+            {
+                u->free_bytes += end_free - start_free;
+            }
+
+            // 从free_list中摘除位于完全空闲chunk中的对象
+            for (size_t k = 0; k <= _POOL_ALIGNS; ++k)
+            {
+                for (size_t i = 0; i < SizeClass::nclasses; ++i)
+                {
+                    obj *volatile *link = free_lists_of(k) + i;
+                    while (0 != *link)
+                    {
+                        u = find_chunk(usage, nchunks, (char *)*link);
+                        if (0 != u && u->free_bytes == (size_t)(u->end - u->begin))
+                        {
+                            *link = (*link)->free_list_link;
+                            free_bytes -= class_size(i);
+                            if (0 == k)
+                            {
+                                --free_count[i];
+                            }
+                        }
+                        else
+                        {
+                            link = &(*link)->free_list_link;
+                        }
+                    }
+                }
+            }
+            if (start_free != end_free && 0 != (u = find_chunk(usage, nchunks, start_free)) &&
+                u->free_bytes == (size_t)(u->end - u->begin))
+            {
+                start_free = end_free = 0;
+            }
+
+            // 把完全空闲的chunk从chunk_list摘除并归还系统
+            chunk_header **link = &chunk_list;
+            while (0 != *link)
+            {
+                chunk_header *c = *link;
+                u = find_chunk(usage, nchunks, (char *)(c + 1));
+                if (u->free_bytes == c->size)
+                {
+                    *link = c->next;
+                    heap_size -= c->size;
+                    released += sizeof(chunk_header) + c->size;
+                    ChunkSource::deallocate(c, sizeof(chunk_header) + c->size);
+                }
+                else
+                {
+                    link = &c->next;
+                }
+            }
+            free(usage);
+        }
+#if defined(__GLIBC__)
+        // glibc不一定把free掉的内存立刻还给操作系统
+        if (released > 0)
+        {
+            malloc_trim(0);
+        }
+#endif
+        trim_mark = 0 == trim_threshold ? ~size_t(0) : free_bytes + trim_threshold;
+        return released;
+    }
+
+#ifdef LP_ALLOC_STATS
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    void _default_alloc_template<threads, inst, SizeClass, ChunkSource>::count_large_mt(bool is_alloc)
+    {
+        thread_cache *cache = local_cache();
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (0 == cache)
+        {
+            guard.lock();
+        }
+        _alloc_class_counters &c = counters_for(cache, SizeClass::nclasses);
+        (is_alloc ? c.allocs : c.frees).add(1);
+    }
+
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    alloc_stats _default_alloc_template<threads, inst, SizeClass, ChunkSource>::stats()
+    {
+        std::unique_lock<std::mutex> guard(depot_lock, std::defer_lock);
+        if (threads)
+        {
+            guard.lock();
+        }
+        alloc_stats s;
+        s.classes.resize(SizeClass::nclasses);
+        for (size_t i = 0; i <= SizeClass::nclasses; ++i)
+        {
+            size_t allocs = counters_of_all[i].allocs.get();
+            size_t frees = counters_of_all[i].frees.get();
+            size_t hits = counters_of_all[i].hits.get();
+            size_t cached = 0;
+            for (thread_cache *c = live_caches; 0 != c; c = c->next_cache)
+            {
+                allocs += c->counters[i].allocs.get();
+                frees += c->counters[i].frees.get();
+                hits += c->counters[i].hits.get();
+                cached += c->counters[i].cached_objs.get();
+            }
+            if (SizeClass::nclasses == i)
+            {
+                s.large_allocs = allocs;
+                s.large_frees = frees;
+                break;
+            }
+            alloc_class_stats &cs = s.classes[i];
+            cs.size = class_size(i);
+            cs.allocs = allocs;
+            cs.frees = frees;
+            cs.hits = hits;
+            cs.refills = refills[i].get();
+            cs.free_bytes = (free_count[i] + cached) * cs.size;
+            cs.refill_objs = 0 == refill_objs[i] ? refill_min : refill_objs[i];
+            cs.leftover_bytes = leftover_bytes[i].get();
         }
+        s.chunk_allocs = chunk_allocs.get();
+        s.heap_size = heap_size;
+        return s;
     }
+#endif
 
     // 重载运算符==
-    template <bool threads, int inst>
-    inline bool operator==(const _default_alloc_template<threads, inst> &,
-                           const _default_alloc_template<threads, inst> &)
+    template <bool threads, int inst, class SizeClass, class ChunkSource>
+    inline bool operator==(const _default_alloc_template<threads, inst, SizeClass, ChunkSource> &,
+                           const _default_alloc_template<threads, inst, SizeClass, ChunkSource> &)
     {
         return true;
     }
 
     // 类型别名
     using alloc = _default_alloc_template<false, 0>;
+    // 多线程版本,可用于被多个线程同时访问的容器
+    using mt_alloc = _default_alloc_template<true, 0>;
+    // 几何规格版本,内存池管理到4KB,每个2的幂区间4个规格
+    using geometric_alloc = _default_alloc_template<false, 0, _geometric_size_class<4, 4096>>;
+    // chunk来自2MB透明大页的版本,大区块同huge_page_alloc
+    using huge_page_pool_alloc = _default_alloc_template<false, 0, _linear_size_class<_ALIGN, _MAX_BYTES>, thp_chunk_source>;
     // endregion:二级配置器
     /*###################################_default_alloc_template end#############################################*/
 
@@ -0,0 +1,110 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+二级配置器的统计信息
+在包含lp_alloc.h之前定义LP_ALLOC_STATS即可启用,例如 -DLP_ALLOC_STATS
+未定义时_LP_ALLOC_STAT(...)展开为空,计数器及stats()等接口都不参与编译,没有任何开销
+启用后可用:
+ * Alloc::stats()              取得一份快照(alloc_stats)
+ * Alloc::print_stats(os)      打印快照
+ * Alloc::dump_stats_at_exit() 程序退出时把快照打印到std::cerr
+*/
+#ifndef LP_ALLOC_STATS_H
+#define LP_ALLOC_STATS_H
+
+#ifdef LP_ALLOC_STATS
+#define _LP_ALLOC_STAT(stmt) stmt
+#else
+#define _LP_ALLOC_STAT(stmt)
+#endif
+
+#ifdef LP_ALLOC_STATS
+#include <atomic>  //for std::atomic
+#include <cstddef> //for size_t
+#include <cstdio>  //for snprintf
+#include <ostream> //for std::ostream
+#include <vector>  //for std::vector
+
+namespace lp
+{
+    // 单写者计数器:同一时刻只有一个线程(计数器所属线程,或持锁者)修改,其他线程可随时读取
+    // 用relaxed的load+store代替fetch_add,在x86上与普通的自增一样便宜,又不构成数据竞争
+    class _stat_counter
+    {
+    private:
+        std::atomic<size_t> value;
+
+    public:
+        constexpr _stat_counter() : value(0) {}
+        void add(size_t n) { value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+        void sub(size_t n) { value.store(value.load(std::memory_order_relaxed) - n, std::memory_order_relaxed); }
+        size_t get() const { return value.load(std::memory_order_relaxed); }
+    };
+
+    // allocate/deallocate快速路径上的计数器,多线程模式下每个线程缓存一份
+    struct _alloc_class_counters
+    {
+        _stat_counter allocs;      // allocate次数
+        _stat_counter frees;       // deallocate次数
+        _stat_counter hits;        // 直接由free_list(多线程模式下为线程缓存)满足的allocate次数
+        _stat_counter cached_objs; // 多线程模式下线程缓存中的对象个数
+    };
+
+    // 一个规格的统计快照
+    struct alloc_class_stats
+    {
+        size_t size;           // 区块大小
+        size_t allocs;         // allocate次数
+        size_t frees;          // deallocate次数
+        size_t hits;           // 直接由free_list满足的allocate次数
+        size_t refills;        // refill次数(多线程模式下为从内存池切分一批的次数)
+        size_t refill_objs;    // 下一次refill的对象个数
+        size_t free_bytes;     // free_list,depot及线程缓存中的字节数
+        size_t leftover_bytes; // 内存池零头切分后挂到该规格的字节数
+    };
+
+    // 整个配置器的统计快照
+    struct alloc_stats
+    {
+        std::vector<alloc_class_stats> classes;
+        size_t large_allocs; // 超过max_bytes,移交一级配置器的allocate次数
+        size_t large_frees;  // 超过max_bytes,移交一级配置器的deallocate次数
+        size_t chunk_allocs; // chunk_alloc向系统申请内存的次数
+        size_t heap_size;    // 内存池当前持有的chunk总字节数
+    };
+
+    inline void print_alloc_stats(std::ostream &os, const alloc_stats &s)
+    {
+        char line[160];
+        std::snprintf(line, sizeof(line), "%8s %12s %12s %12s %7s %9s %6s %12s %12s\n",
+                      "size", "allocs", "frees", "hits", "hit%", "refills", "batch", "free_bytes", "leftover");
+        os << line;
+        size_t free_total = 0;
+        for (size_t i = 0; i < s.classes.size(); ++i)
+        {
+            const alloc_class_stats &c = s.classes[i];
+            free_total += c.free_bytes;
+            if (0 == c.allocs && 0 == c.free_bytes && 0 == c.leftover_bytes)
+            {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "%8zu %12zu %12zu %12zu %6.1f%% %9zu %6zu %12zu %12zu\n",
+                          c.size, c.allocs, c.frees, c.hits,
+                          0 == c.allocs ? 0.0 : 100.0 * c.hits / c.allocs,
+                          c.refills, c.refill_objs, c.free_bytes, c.leftover_bytes);
+            os << line;
+        }
+        std::snprintf(line, sizeof(line),
+                      "large allocs %zu, large frees %zu, chunk_alloc system calls %zu, heap_size %zu, free bytes %zu\n",
+                      s.large_allocs, s.large_frees, s.chunk_allocs, s.heap_size, free_total);
+        os << line;
+    }
+} // namespace lp
+#endif // LP_ALLOC_STATS
+
+#endif // LP_ALLOC_STATS_H
@@ -0,0 +1,207 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+simple_alloc的分配轨迹记录
+在包含lp_alloc.h之前定义LP_ALLOC_TRACE即可启用,例如 -DLP_ALLOC_TRACE
+启用后经过simple_alloc的每次allocate,deallocate,reallocate都以一条alloc_trace_record写入二进制日志:
+ * 日志文件名取环境变量LP_ALLOC_TRACE_FILE,未设置时为lp_alloc.trace
+ * 每个线程先写入自己的缓冲区,满了或线程退出时加锁追加到文件
+ * 文件以alloc_trace_header开头,之后是按各线程写出顺序排列的记录,回放时按时间戳排序
+未定义LP_ALLOC_TRACE时_LP_ALLOC_TRACE(...)展开为空,没有任何开销
+回放工具见test/alloc_replay.cpp
+*/
+#ifndef LP_ALLOC_TRACE_H
+#define LP_ALLOC_TRACE_H
+
+#ifdef LP_ALLOC_TRACE
+#define _LP_ALLOC_TRACE(stmt) stmt
+#else
+#define _LP_ALLOC_TRACE(stmt)
+#endif
+
+#include <stdint.h> //for uint64_t等
+#ifdef LP_ALLOC_TRACE
+#include <atomic>  //for std::atomic
+#include <chrono>  //for std::chrono::steady_clock
+#include <cstdio>  //for FILE
+#include <cstdlib> //for getenv
+#include <cstring> //for memcpy
+#include <mutex>   //for std::mutex
+#endif
+
+namespace lp
+{
+    // region:日志格式,回放工具不启用LP_ALLOC_TRACE也要用到
+    enum
+    {
+        _TRACE_ALLOC = 1,         // allocate
+        _TRACE_FREE = 2,          // deallocate
+        _TRACE_REALLOC_FREE = 3,  // reallocate的前半:释放旧区块
+        _TRACE_REALLOC_ALLOC = 4, // reallocate的后半:得到新区块,与同一线程上一条_TRACE_REALLOC_FREE配对
+        _TRACE_NO_CLASS = 0xFFFF  // 配置器没有规格
+    };
+
+    struct alloc_trace_header
+    {
+        char magic[8];        // "LPTRACE1"
+        uint32_t record_size; // sizeof(alloc_trace_record)
+        uint32_t reserved;
+    };
+
+    // 每条32字节
+    struct alloc_trace_record
+    {
+        uint64_t time_ns;    // 距第一条记录的纳秒数;申请在调用之后取,释放在调用之前取,保证同一地址的先后
+        uint64_t ptr;        // 区块地址,回放时只用来配对申请和释放
+        uint64_t size;       // 字节数
+        uint32_t thread;     // 线程编号,按首次记录的先后从0开始
+        uint16_t size_class; // 配置器的规格编号(Alloc::size_class),没有规格的配置器为_TRACE_NO_CLASS
+        uint8_t op;          // _TRACE_ALLOC等
+        uint8_t align_log2;  // 要求的对齐,以2为底的对数
+    };
+    // endregion
+
+#ifdef LP_ALLOC_TRACE
+    // region:记录器
+    // Alloc提供size_class(n)时记录规格编号
+    template <class Alloc>
+    auto _alloc_trace_class(size_t n, int) -> decltype(Alloc::size_class(n))
+    {
+        return Alloc::size_class(n);
+    }
+    template <class Alloc>
+    size_t _alloc_trace_class(size_t n, long)
+    {
+        return _TRACE_NO_CLASS;
+    }
+
+    class alloc_tracer
+    {
+    public:
+        template <class Alloc>
+        static void record(int op, const void *p, size_t bytes, size_t align)
+        {
+            size_t size_class = _alloc_trace_class<Alloc>(bytes, 0);
+            alloc_trace_record r;
+            r.time_ns = now_ns();
+            r.ptr = (uint64_t)(uintptr_t)p;
+            r.size = bytes;
+            r.thread = 0;
+            r.size_class = size_class < _TRACE_NO_CLASS ? (uint16_t)size_class : (uint16_t)_TRACE_NO_CLASS;
+            r.op = (uint8_t)op;
+            r.align_log2 = 0;
+            while (((size_t)1 << r.align_log2) < align)
+            {
+                ++r.align_log2;
+            }
+            append(r);
+        }
+
+    private:
+        enum
+        {
+            _BUFFER_RECORDS = 4096
+        };
+
+        // 日志文件,进程结束时也不析构,静态对象析构期间的分配仍可记录
+        struct trace_file
+        {
+            std::mutex lock;
+            FILE *fp;
+            std::atomic<uint32_t> next_thread;
+            std::chrono::steady_clock::time_point start;
+
+            trace_file() : next_thread(0), start(std::chrono::steady_clock::now())
+            {
+                const char *name = getenv("LP_ALLOC_TRACE_FILE");
+                fp = fopen(0 != name ? name : "lp_alloc.trace", "wb");
+                if (0 != fp)
+                {
+                    alloc_trace_header h;
+                    memcpy(h.magic, "LPTRACE1", 8);
+                    h.record_size = sizeof(alloc_trace_record);
+                    h.reserved = 0;
+                    fwrite(&h, sizeof(h), 1, fp);
+                }
+            }
+            // 只在整个缓冲区写出时fflush;单条记录留在stdio缓冲区,由下一次写出或进程退出时刷新
+            void write(const alloc_trace_record *r, size_t n, bool flush)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (0 != fp)
+                {
+                    fwrite(r, sizeof(alloc_trace_record), n, fp);
+                    if (flush)
+                    {
+                        fflush(fp);
+                    }
+                }
+            }
+        };
+
+        struct trace_buffer
+        {
+            alloc_trace_record records[_BUFFER_RECORDS];
+            size_t count;
+
+            trace_buffer() : count(0) {}
+            ~trace_buffer()
+            {
+                buffer_destroyed() = true;
+                file().write(records, count, true);
+            }
+        };
+
+        // 线程编号与缓冲区是否已析构放在平凡析构的变量里,缓冲区析构之后仍可读
+        static uint32_t thread_id()
+        {
+            static thread_local uint32_t id = file().next_thread++;
+            return id;
+        }
+        static bool &buffer_destroyed()
+        {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        static trace_file &file()
+        {
+            static trace_file *f = new trace_file();
+            return *f;
+        }
+
+        static uint64_t now_ns()
+        {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - file().start)
+                .count();
+        }
+
+        static void append(alloc_trace_record &r)
+        {
+            r.thread = thread_id();
+            if (buffer_destroyed())
+            {
+                // 线程本地缓冲区已析构(线程退出阶段),直接写文件
+                file().write(&r, 1, false);
+                return;
+            }
+            static thread_local trace_buffer buffer;
+            buffer.records[buffer.count++] = r;
+            if (_BUFFER_RECORDS == buffer.count)
+            {
+                file().write(buffer.records, buffer.count, true);
+                buffer.count = 0;
+            }
+        }
+    };
+    // endregion
+#endif // LP_ALLOC_TRACE
+} // namespace lp
+
+#endif // LP_ALLOC_TRACE_H
@@ -0,0 +1,102 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+符合标准Allocator要求的配置器lp::allocator<T, Alloc>
+把lp::alloc等只有静态接口的配置器包装成标准容器可用的形式,例如:
+    std::map<int, int, std::less<int>, lp::allocator<std::pair<const int, int>>> m;
+    std::unordered_map<K, V, H, E, lp::allocator<std::pair<const K, V>, lp::mt_alloc>> um;
+ * 内存经由simple_alloc<T, Alloc>申请,因此同样支持over-aligned的T和LP_ALLOC_TRACE
+ * 无状态:同一Alloc的所有实例都相等,一个实例申请的内存可由任何其他实例释放
+ * deallocate总是带着大小,正好对应二级配置器按大小找free_list的做法
+ * 多线程共享的标准容器本来就要加锁;不同线程各自使用的容器应选mt_alloc
+*/
+#ifndef LP_ALLOCATOR_H
+#define LP_ALLOCATOR_H
+
+#include <cstddef>     //for size_t,ptrdiff_t
+#include <new>         //for std::bad_alloc
+#include <type_traits> //for std::true_type
+#include "lp_alloc.h"
+
+namespace lp
+{
+    template <class T, class Alloc = alloc>
+    class allocator
+    {
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        // 无状态,容器拷贝,移动,交换时不需要传播配置器
+        using propagate_on_container_copy_assignment = std::false_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::false_type;
+        using is_always_equal = std::true_type;
+
+        template <class U>
+        struct rebind
+        {
+            using other = allocator<U, Alloc>;
+        };
+
+    private:
+        using data_allocator = simple_alloc<T, Alloc>;
+
+    public:
+        allocator() noexcept {}
+        allocator(const allocator &) noexcept {}
+        template <class U>
+        allocator(const allocator<U, Alloc> &) noexcept {}
+
+        T *allocate(size_type n)
+        {
+            if (n > max_size())
+            {
+                throw std::bad_alloc();
+            }
+            return data_allocator::allocate(n);
+        }
+        T *allocate(size_type n, const void *)
+        {
+            return allocate(n);
+        }
+        void deallocate(T *p, size_type n)
+        {
+            data_allocator::deallocate(p, n);
+        }
+        size_type max_size() const noexcept
+        {
+            return size_type(-1) / sizeof(T);
+        }
+
+        // construct/destroy由std::allocator_traits提供默认实现
+    };
+
+    template <class T, class U, class Alloc>
+    inline bool operator==(const allocator<T, Alloc> &, const allocator<U, Alloc> &)
+    {
+        return true;
+    }
+
+    template <class T, class U, class Alloc>
+    inline bool operator!=(const allocator<T, Alloc> &, const allocator<U, Alloc> &)
+    {
+        return false;
+    }
+
+    // 多线程版本,不同线程各自使用的标准容器可共用同一个内存池而不加锁
+    template <class T>
+    using mt_allocator = allocator<T, mt_alloc>;
+} // namespace lp
+
+#endif // LP_ALLOCATOR_H
@@ -0,0 +1,303 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+单调内存区域(arena)与对应的配置器arena_alloc
+适用于一批对象同生共死的场景(例如一次请求中构造的所有节点和缓冲区):
+ * allocate只是移动指针(bump pointer),deallocate什么都不做
+ * 区域内的内存在arena_scope结束或arena::reset()时一次性回收
+用法:
+    lp::arena a;
+    {
+        lp::arena_scope scope(a);                  // a成为本线程的当前arena
+        lp::vector<int, lp::arena_alloc> v;        // v的内存来自a
+        {
+            lp::arena_scope child;                 // 子作用域:在当前arena上做一个标记
+            lp::vector<int, lp::arena_alloc> tmp;  // tmp的内存在child结束时回收
+        }
+    }                                              // scope结束,a回到进入scope之前的状态
+注意:容器必须在其所用的arena_scope结束之前析构
+*/
+#ifndef LP_ARENA_H
+#define LP_ARENA_H
+
+#include <cstddef>  //for size_t
+#include <cstdlib>  //for exit
+#include <cstring>  //for memcpy
+#include <stdint.h> //for uintptr_t
+#include <iostream> //for std::cerr
+#include "lp_alloc.h"
+
+namespace lp
+{
+    /*###################################arena begin#############################################*/
+    // region:arena
+    /*
+     * arena由若干block组成,block从一级配置器取得,串成单向链表,最新的block在表头
+     * 当前block用完时取一个新block,block大小从block_size开始倍增,上限_ARENA_MAX_BLOCK
+     * 大于当前block剩余空间的需求都在新block中满足,旧block剩下的空间不再使用
+     */
+    enum
+    {
+        _ARENA_BLOCK = 64 * 1024,              // 默认的首个block大小
+        _ARENA_MAX_BLOCK = 16 * 1024 * 1024    // 倍增的上限
+    };
+
+    class arena
+    {
+    private:
+        struct block
+        {
+            block *prev; // 上一个(更早的)block
+            size_t size; // 可用字节数,不含block头
+        };
+
+    public:
+        // 标记arena当前的位置,rewind(mark)回收标记之后分配的全部内存
+        struct mark_type
+        {
+            block *current;
+            char *ptr;
+        };
+
+    public:
+        explicit arena(size_t block_size = _ARENA_BLOCK)
+            : current(0), ptr(0), end(0), next_block_size(block_size < 256 ? 256 : block_size) {}
+        ~arena() { release_blocks(0); }
+
+        void *allocate(size_t n)
+        {
+            n = round_up(n);
+            if ((size_t)(end - ptr) < n)
+            {
+                new_block(n);
+            }
+            char *result = ptr;
+            ptr += n;
+            return result;
+        }
+
+        // 按align对齐,align为2的幂
+        void *allocate_aligned(size_t n, size_t align)
+        {
+            if (align <= (size_t)_ALIGN)
+            {
+                return allocate(n);
+            }
+            size_t pad = (align - (uintptr_t)ptr % align) % align;
+            if ((size_t)(end - ptr) < pad + round_up(n))
+            {
+                new_block(n + align);
+                pad = (align - (uintptr_t)ptr % align) % align;
+            }
+            ptr += pad;
+            return allocate(n);
+        }
+
+        // 若p是最近一次分配的区块且当前block足够,原地伸缩;否则另取一块并拷贝
+        void *reallocate(void *p, size_t old_size, size_t new_size)
+        {
+            old_size = round_up(old_size);
+            if ((char *)p + old_size == ptr && (size_t)(end - (char *)p) >= round_up(new_size))
+            {
+                ptr = (char *)p + round_up(new_size);
+                return p;
+            }
+            void *result = allocate(new_size);
+            memcpy(result, p, old_size < new_size ? old_size : new_size);
+            return result;
+        }
+
+        mark_type mark() const
+        {
+            mark_type m = {current, ptr};
+            return m;
+        }
+
+        void rewind(const mark_type &m)
+        {
+            // 回退到空arena时等同于reset,保留一个block,避免每个作用域都向系统申请内存
+            if (0 == m.current)
+            {
+                reset();
+                return;
+            }
+            release_blocks(m.current);
+            ptr = m.ptr;
+            end = (char *)(current + 1) + current->size;
+        }
+
+        // 回收全部内存,但保留最新(最大)的block供之后使用;不要在arena_scope内调用
+        void reset()
+        {
+            if (0 == current)
+            {
+                return;
+            }
+            block *keep = current;
+            current = keep->prev;
+            release_blocks(0);
+            keep->prev = 0;
+            current = keep;
+            ptr = (char *)(keep + 1);
+            end = ptr + keep->size;
+        }
+
+        // 所有block的总字节数
+        size_t capacity() const
+        {
+            size_t total = 0;
+            for (block *b = current; 0 != b; b = b->prev)
+            {
+                total += b->size;
+            }
+            return total;
+        }
+
+    private:
+        // 不可拷贝
+        arena(const arena &);
+        arena &operator=(const arena &);
+
+        static size_t round_up(size_t bytes)
+        {
+            return (((bytes) + _ALIGN - 1) & ~(size_t)(_ALIGN - 1));
+        }
+
+        void new_block(size_t n)
+        {
+            size_t size = next_block_size;
+            if (size < n)
+            {
+                size = n;
+            }
+            else if (next_block_size < (size_t)_ARENA_MAX_BLOCK)
+            {
+                next_block_size *= 2;
+            }
+            block *b = (block *)malloc_alloc::allocate(sizeof(block) + size);
+            b->prev = current;
+            b->size = size;
+            current = b;
+            ptr = (char *)(b + 1);
+            end = ptr + size;
+        }
+
+        // 释放比keep更新的所有block,keep为0时释放全部
+        void release_blocks(block *keep)
+        {
+            while (current != keep)
+            {
+                block *prev = current->prev;
+                malloc_alloc::deallocate(current, sizeof(block) + current->size);
+                current = prev;
+            }
+        }
+
+    private:
+        block *current;         // 最新的block
+        char *ptr;              // 当前block中下一次分配的位置
+        char *end;              // 当前block的结尾
+        size_t next_block_size; // 下一个block的大小
+    };
+    // endregion:arena
+
+    // region:arena_scope
+    /*
+     * 在作用域内把一个arena设为本线程的当前arena,作用域结束时:
+     *  arena回退到进入作用域时的位置(作用域内的分配全部回收),当前arena恢复为外层的arena
+     * arena_scope(a)  以a作为当前arena
+     * arena_scope()   子作用域,沿用外层的当前arena,只回收子作用域内的分配
+     */
+    class arena_scope
+    {
+    public:
+        explicit arena_scope(arena &a) : self(a), outer(current_arena()), saved(a.mark())
+        {
+            current_arena() = &a;
+        }
+        arena_scope() : self(checked_current()), outer(current_arena()), saved(self.mark()) {}
+        ~arena_scope()
+        {
+            self.rewind(saved);
+            current_arena() = outer;
+        }
+
+        // 本线程的当前arena,没有时为0
+        static arena *&current_arena()
+        {
+            static thread_local arena *current = 0;
+            return current;
+        }
+
+    private:
+        arena_scope(const arena_scope &);
+        arena_scope &operator=(const arena_scope &);
+
+        static arena &checked_current()
+        {
+            arena *a = current_arena();
+            if (0 == a)
+            {
+                std::cerr << "lp::arena_scope: no active arena" << std::endl;
+                exit(1);
+            }
+            return *a;
+        }
+
+        arena &self;
+        arena *outer;
+        arena::mark_type saved;
+    };
+    // endregion:arena_scope
+
+    // region:arena_alloc
+    // 静态接口的配置器,与malloc_alloc,alloc可互换,内存来自本线程的当前arena
+    // inst:单纯为了能使用模板编程
+    template <int inst>
+    class _arena_alloc_template
+    {
+    public:
+        static void *allocate(size_t n)
+        {
+            return current().allocate(n);
+        }
+        // 单个区块不单独回收,随arena_scope一起回收
+        static void deallocate(void *, size_t)
+        {
+        }
+        static void *reallocate(void *p, size_t old_size, size_t new_size)
+        {
+            return current().reallocate(p, old_size, new_size);
+        }
+        static void *allocate_aligned(size_t n, size_t align)
+        {
+            return current().allocate_aligned(n, align);
+        }
+        static void deallocate_aligned(void *, size_t, size_t)
+        {
+        }
+
+    private:
+        static arena &current()
+        {
+            arena *a = arena_scope::current_arena();
+            if (0 == a)
+            {
+                std::cerr << "lp::arena_alloc: no active arena" << std::endl;
+                exit(1);
+            }
+            return *a;
+        }
+    };
+
+    using arena_alloc = _arena_alloc_template<0>;
+    // endregion:arena_alloc
+    /*###################################arena end#############################################*/
+} // namespace lp
+
+#endif // LP_ARENA_H
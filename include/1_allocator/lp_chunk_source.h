@@ -0,0 +1,274 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+大块内存的来源(chunk source)策略
+一级配置器的所有区块,以及二级配置器内存池的chunk,都通过chunk source向系统申请
+一个chunk source需提供:
+ * allocate(n)                       申请n个字节,失败返回0
+ * deallocate(p, n)                  归还allocate(n)得到的p,n必须与申请时相同
+ * reallocate(p, old_size, new_size) 调整大小,失败返回0且p保持不变
+ * chunk_size(n)                     内存池需要至少n字节的chunk时,实际应申请的字节数
+ * allocate_aligned(n, align)        申请按align对齐的n个字节,align为2的幂,失败返回0
+ * deallocate_aligned(p, n, align)   归还allocate_aligned(n, align)得到的p
+malloc_chunk_source:默认,直接使用malloc/realloc/free
+_mmap_chunk_source:不小于Threshold的区块直接mmap,可使用2MB大页,减少大缓冲区的TLB缺失
+ * _CHUNK_HUGETLB  先尝试MAP_HUGETLB(需要系统预留大页,vm.nr_hugepages),失败时退回普通映射
+ * _CHUNK_THP      madvise(MADV_HUGEPAGE),请求内核用透明大页填充
+ * _CHUNK_ALIGNED  映射起点按2MB对齐,长度取2MB的倍数,透明大页才能覆盖整个区块
+ 非Linux平台上_mmap_chunk_source等同于malloc_chunk_source
+*/
+#ifndef LP_CHUNK_SOURCE_H
+#define LP_CHUNK_SOURCE_H
+
+#include <cstddef> //for size_t
+#include <cstdlib> //for malloc,realloc,free
+#include <cstring> //for memcpy
+#if defined(_WIN32)
+#include <malloc.h> //for _aligned_malloc
+#endif
+#if defined(__linux__)
+#include <stdint.h>   //for uintptr_t
+#include <sys/mman.h> //for mmap,mremap,madvise
+#include <unistd.h>   //for sysconf
+#endif
+
+namespace lp
+{
+    enum
+    {
+        _HUGE_PAGE_SIZE = 2 * 1024 * 1024 // x86-64与aarch64(4KB页)上的大页大小
+    };
+    enum
+    {
+        _CHUNK_HUGETLB = 1,
+        _CHUNK_THP = 2,
+        _CHUNK_ALIGNED = 4
+    };
+
+    // region:malloc_chunk_source
+    class malloc_chunk_source
+    {
+    public:
+        static void *allocate(size_t n) { return malloc(n); }
+        static void deallocate(void *p, size_t) { free(p); }
+        static void *reallocate(void *p, size_t, size_t new_size) { return realloc(p, new_size); }
+        static size_t chunk_size(size_t n) { return n; }
+        static void *allocate_aligned(size_t n, size_t align)
+        {
+#if defined(_WIN32)
+            return _aligned_malloc(n, align);
+#else
+            void *p;
+            // posix_memalign要求align至少为sizeof(void *)
+            return 0 == posix_memalign(&p, align < sizeof(void *) ? sizeof(void *) : align, n) ? p : 0;
+#endif
+        }
+        static void deallocate_aligned(void *p, size_t, size_t)
+        {
+#if defined(_WIN32)
+            _aligned_free(p);
+#else
+            free(p);
+#endif
+        }
+    };
+    // endregion:malloc_chunk_source
+
+    // region:_mmap_chunk_source
+    // Flags为_CHUNK_HUGETLB,_CHUNK_THP,_CHUNK_ALIGNED的组合
+    // 小于Threshold的区块仍由malloc负责;内存池的chunk至少取Threshold字节,因此总是来自mmap
+#if defined(__linux__)
+    template <int Flags, size_t Threshold = _HUGE_PAGE_SIZE>
+    class _mmap_chunk_source
+    {
+    public:
+        static void *allocate(size_t n)
+        {
+            return n < Threshold ? malloc(n) : map(map_size(n));
+        }
+        static void deallocate(void *p, size_t n)
+        {
+            if (n < Threshold)
+            {
+                free(p);
+            }
+            else
+            {
+                munmap(p, map_size(n));
+            }
+        }
+        static void *reallocate(void *p, size_t old_size, size_t new_size);
+        static size_t chunk_size(size_t n)
+        {
+            return map_size(n < Threshold ? Threshold : n);
+        }
+        // 映射的起点至少按页对齐(_CHUNK_ALIGNED时按2MB对齐),更大的对齐交给malloc_chunk_source
+        static void *allocate_aligned(size_t n, size_t align)
+        {
+            return n >= Threshold && align <= map_align() ? map(map_size(n))
+                                                          : malloc_chunk_source::allocate_aligned(n, align);
+        }
+        static void deallocate_aligned(void *p, size_t n, size_t align)
+        {
+            if (n >= Threshold && align <= map_align())
+            {
+                munmap(p, map_size(n));
+            }
+            else
+            {
+                malloc_chunk_source::deallocate_aligned(p, n, align);
+            }
+        }
+
+    private:
+        static size_t map_align()
+        {
+            return 0 != (Flags & _CHUNK_ALIGNED) ? (size_t)_HUGE_PAGE_SIZE : page_size();
+        }
+        // 大页模式下映射长度取2MB的倍数,否则取页大小的倍数
+        static size_t map_size(size_t n)
+        {
+            size_t granule = 0 != (Flags & (_CHUNK_HUGETLB | _CHUNK_ALIGNED)) ? (size_t)_HUGE_PAGE_SIZE : page_size();
+            return (n + granule - 1) & ~(granule - 1);
+        }
+        static size_t page_size()
+        {
+            static const size_t size = (size_t)sysconf(_SC_PAGESIZE);
+            return size;
+        }
+        static void *map(size_t n);
+        static void *map_aligned(size_t n);
+        // MREMAP_MAYMOVE选的新地址不一定按2MB对齐:先原地调整,不行再把页表搬到map_aligned得到的地址
+        static void *remap_aligned(void *p, size_t old_len, size_t new_len);
+    };
+
+    template <int Flags, size_t Threshold>
+    void *_mmap_chunk_source<Flags, Threshold>::map(size_t n)
+    {
+        void *p;
+        if (0 != (Flags & _CHUNK_HUGETLB))
+        {
+            p = mmap(0, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (MAP_FAILED != p)
+            {
+                return p;
+            }
+            // 系统没有预留足够的大页,退回普通映射
+        }
+        if (0 != (Flags & _CHUNK_ALIGNED))
+        {
+            p = map_aligned(n);
+        }
+        else
+        {
+            p = mmap(0, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            p = MAP_FAILED == p ? 0 : p;
+        }
+        if (0 != p && 0 != (Flags & _CHUNK_THP))
+        {
+            madvise(p, n, MADV_HUGEPAGE);
+        }
+        return p;
+    }
+
+    // 多映射2MB,再把首尾不对齐的部分还给系统
+    template <int Flags, size_t Threshold>
+    void *_mmap_chunk_source<Flags, Threshold>::map_aligned(size_t n)
+    {
+        size_t len = n + _HUGE_PAGE_SIZE;
+        void *m = mmap(0, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == m)
+        {
+            return 0;
+        }
+        char *p = (char *)m;
+        char *aligned = (char *)(((uintptr_t)p + _HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(_HUGE_PAGE_SIZE - 1));
+        if (aligned != p)
+        {
+            munmap(p, aligned - p);
+        }
+        size_t tail = (p + len) - (aligned + n);
+        if (tail > 0)
+        {
+            munmap(aligned + n, tail);
+        }
+        return aligned;
+    }
+
+    template <int Flags, size_t Threshold>
+    void *_mmap_chunk_source<Flags, Threshold>::remap_aligned(void *p, size_t old_len, size_t new_len)
+    {
+        void *result = mremap(p, old_len, new_len, 0);
+        if (MAP_FAILED != result)
+        {
+            return result;
+        }
+        void *target = map_aligned(new_len);
+        if (0 == target)
+        {
+            return MAP_FAILED;
+        }
+        // MREMAP_FIXED替换掉target处的映射,新区间继承p的madvise属性
+        result = mremap(p, old_len, new_len, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+        if (MAP_FAILED == result)
+        {
+            munmap(target, new_len);
+        }
+        return result;
+    }
+
+    template <int Flags, size_t Threshold>
+    void *_mmap_chunk_source<Flags, Threshold>::reallocate(void *p, size_t old_size, size_t new_size)
+    {
+        if (old_size < Threshold && new_size < Threshold)
+        {
+            return realloc(p, new_size);
+        }
+        if (old_size >= Threshold && new_size >= Threshold)
+        {
+            size_t old_len = map_size(old_size);
+            size_t new_len = map_size(new_size);
+            if (old_len == new_len)
+            {
+                return p;
+            }
+            // 由内核重新映射页表,不拷贝数据;hugetlb映射在较旧的内核上不支持mremap,失败时走下面的拷贝
+            void *result = 0 != (Flags & _CHUNK_ALIGNED) ? remap_aligned(p, old_len, new_len)
+                                                          : mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+            if (MAP_FAILED != result)
+            {
+                return result;
+            }
+        }
+        void *result = allocate(new_size);
+        if (0 == result)
+        {
+            return 0;
+        }
+        memcpy(result, p, old_size < new_size ? old_size : new_size);
+        deallocate(p, old_size);
+        return result;
+    }
+#else
+    // 其他平台没有对应的接口,退回malloc
+    template <int Flags, size_t Threshold = _HUGE_PAGE_SIZE>
+    class _mmap_chunk_source : public malloc_chunk_source
+    {
+    };
+#endif
+
+    // 普通mmap,不要求大页
+    using mmap_chunk_source = _mmap_chunk_source<0>;
+    // 透明大页:2MB对齐并madvise,无需系统配置
+    using thp_chunk_source = _mmap_chunk_source<_CHUNK_THP | _CHUNK_ALIGNED>;
+    // 预留大页(MAP_HUGETLB),没有预留时退回透明大页
+    using hugetlb_chunk_source = _mmap_chunk_source<_CHUNK_HUGETLB | _CHUNK_THP | _CHUNK_ALIGNED>;
+    // endregion:_mmap_chunk_source
+} // namespace lp
+
+#endif // LP_CHUNK_SOURCE_H
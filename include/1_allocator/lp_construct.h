@@ -14,19 +14,29 @@
 */
 #include <new> //for placement new
 #include <type_traits>
+#include <utility>  //for std::forward
+#include "../2_iterator/lp_iterator.h"
 namespace lp
 {
-    template <class T1, class T2>
-    inline void construct(T1 *p, const T2 &value)
+    // 参数原样转发给T的构造函数:传右值时调用移动构造,不传参数时值初始化
+    template <class T, class... Args>
+    inline void construct(T *p, Args &&...args)
     {
         // placement new的用法:
         // 不分配内存,而是在已经分配好的内存地址p上构造一个对象
-        new (p) T1(value);
+        new (p) T(std::forward<Args>(args)...);
+    }
+
+    // 默认初始化:平凡类型不做任何事,内容保持不确定;与construct(p)的值初始化(清零)相对
+    template <class T>
+    inline void default_construct(T *p)
+    {
+        new (p) T;
     }
 
     // region:destory的第一版本,接受一个指针
     template <class T>
-    inline void destory(T *p)
+    inline void destroy(T *p)
     {
         p->~T(); // 调用T的析构函数
     }
@@ -41,25 +51,26 @@ namespace lp
     // };
     // 这种析构函数就是平凡的,它的作用就是什么都不做,因此可以直接跳过,不用调用
     // 对于平凡的析构函数,可以直接跳过,不用调用析构函数,这样可以提高性能
-    template <class ForwardIterator, class T>
-    inline void destroy(ForwardIterator first, ForwardIterator last)
-    {
-        destroy_aux(first, last, std::is_trivially_destructible<T>{});
-    }
-
-    template <class ForwardIterator, class T>
+    template <class ForwardIterator>
     inline void destroy_aux(ForwardIterator first, ForwardIterator last, std::false_type)
     {
-        for (; first < last; ++first)
+        for (; first != last; ++first)
         {
             destroy(&*first);
         }
     }
 
-    template <class ForwardIterator, class T>
+    template <class ForwardIterator>
     inline void destroy_aux(ForwardIterator first, ForwardIterator last, std::true_type)
     {
     }
+
+    template <class ForwardIterator>
+    inline void destroy(ForwardIterator first, ForwardIterator last)
+    {
+        using T = typename iterator_traits<ForwardIterator>::value_type;
+        destroy_aux(first, last, std::is_trivially_destructible<T>{});
+    }
     // endregion:destory的第二版本
 
     // region:destory的第三版本,对于char*和wchar_t*的特化版本
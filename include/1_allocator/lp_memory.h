@@ -9,6 +9,9 @@
 #include "lp_alloc.h"   //负责内存的配置和释放
 #include "lp_construct.h" //负责内存的构造和析构
 #include "lp_uninitialized.h"
+#include "lp_parallel_uninitialized.h" //uninitialized_*与destroy的并行版本
+#include "lp_arena.h" //单调内存区域与arena_alloc
+#include "lp_allocator.h" //供标准容器使用的lp::allocator
 
 /*
 
@@ -0,0 +1,289 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+uninitialized_*与destroy的并行版本,第一个参数为执行策略,例如
+    lp::uninitialized_fill_n(lp::execution::par, p, n, 0);
+    lp::destroy(lp::execution::par, p, p + n);
+ * 迭代器都是随机访问迭代器,且区间不小于_PAR_CHUNK_BYTES的两倍时,均分给线程池中的线程
+   每个线程处理连续的一段,多GB的缓冲区在NUMA机器上按first-touch分布到各线程所在的节点
+ * 其他情况(包括execution::seq)退回顺序版本
+ * 异常保证与顺序版本相同:任何一段抛出异常,已构造的所有元素都会被销毁,再抛出第一个异常
+*/
+#ifndef LP_PARALLEL_UNINITIALIZED_H
+#define LP_PARALLEL_UNINITIALIZED_H
+
+#include <atomic>      //for std::atomic
+#include <cstddef>     //for size_t
+#include <mutex>       //for std::mutex
+#include <type_traits> //for std::is_trivially_destructible
+#include <utility>     //for std::pair
+#include <vector>      //for std::vector
+#include "lp_construct.h"
+#include "lp_uninitialized.h"
+#include "../5_algorithm/lp_execution.h"
+
+namespace lp
+{
+    enum
+    {
+        _PAR_CHUNK_BYTES = 1024 * 1024 // 每段至少这么多字节,更小的区间不值得交给其他线程
+    };
+
+    // region:并行构造的框架
+    // n个元素,每个elem_bytes字节,在threads个线程上分成几段
+    inline size_t _par_chunks(size_t threads, size_t n, size_t elem_bytes)
+    {
+        size_t chunks = n / (_PAR_CHUNK_BYTES / elem_bytes + 1);
+        return chunks < threads ? chunks : threads;
+    }
+
+    // 并行构造[0,n):construct(b,e)构造[b,e)一段,失败时自行销毁已构造的部分;destroy(b,e)销毁构造好的一段
+    // 任何一段失败后,尚未开始的段不再构造,已完成的段全部销毁,再抛出第一个异常
+    template <class Construct, class Destroy>
+    void _parallel_construct(size_t threads, size_t n, size_t elem_bytes, Construct construct, Destroy destroy)
+    {
+        size_t chunks = _par_chunks(threads, n, elem_bytes);
+        if (chunks <= 1)
+        {
+            construct((size_t)0, n);
+            return;
+        }
+        std::mutex lock;
+        std::vector<std::pair<size_t, size_t>> finished;
+        std::atomic<bool> failed(false);
+        try
+        {
+            parallel_chunks(n, chunks, [&](size_t b, size_t e)
+                            {
+                                if (failed.load())
+                                {
+                                    return;
+                                }
+                                try
+                                {
+                                    construct(b, e);
+                                }
+                                catch (...)
+                                {
+                                    failed = true;
+                                    throw;
+                                }
+                                std::lock_guard<std::mutex> guard(lock);
+                                finished.push_back(std::make_pair(b, e)); });
+        }
+        catch (...)
+        {
+            for (size_t i = 0; i < finished.size(); ++i)
+            {
+                destroy(finished[i].first, finished[i].second);
+            }
+            throw;
+        }
+    }
+    // endregion
+
+    // region:uninitialized_copy,uninitialized_move
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _par_uninitialized_copy(size_t, InputIterator first, InputIterator last, ForwardIterator result, std::false_type)
+    {
+        return lp::uninitialized_copy(first, last, result);
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    ForwardIterator _par_uninitialized_copy(size_t threads, InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
+    {
+        using T = typename iterator_traits<ForwardIterator>::value_type;
+        size_t n = last - first;
+        _parallel_construct(threads, n, sizeof(T), [&](size_t b, size_t e)
+                            { lp::uninitialized_copy(first + b, first + e, result + b); },
+                            [&](size_t b, size_t e)
+                            { lp::destroy(result + b, result + e); });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator>
+    uninitialized_copy(ExecutionPolicy &&policy, InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return _par_uninitialized_copy(_policy_threads(policy), first, last, result,
+                                       _all_random_access<InputIterator, ForwardIterator>());
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _par_uninitialized_move(size_t, InputIterator first, InputIterator last, ForwardIterator result, std::false_type)
+    {
+        return lp::uninitialized_move(first, last, result);
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    ForwardIterator _par_uninitialized_move(size_t threads, InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
+    {
+        using T = typename iterator_traits<ForwardIterator>::value_type;
+        size_t n = last - first;
+        _parallel_construct(threads, n, sizeof(T), [&](size_t b, size_t e)
+                            { lp::uninitialized_move(first + b, first + e, result + b); },
+                            [&](size_t b, size_t e)
+                            { lp::destroy(result + b, result + e); });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class InputIterator, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator>
+    uninitialized_move(ExecutionPolicy &&policy, InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return _par_uninitialized_move(_policy_threads(policy), first, last, result,
+                                       _all_random_access<InputIterator, ForwardIterator>());
+    }
+    // endregion
+
+    // region:uninitialized_fill,uninitialized_fill_n
+    template <class ForwardIterator, class Size, class T>
+    inline ForwardIterator _par_uninitialized_fill_n(size_t, ForwardIterator first, Size n, const T &value, std::false_type)
+    {
+        return lp::uninitialized_fill_n(first, n, value);
+    }
+
+    template <class ForwardIterator, class Size, class T>
+    ForwardIterator _par_uninitialized_fill_n(size_t threads, ForwardIterator first, Size n, const T &value, std::true_type)
+    {
+        if (n <= 0)
+        {
+            return first;
+        }
+        using V = typename iterator_traits<ForwardIterator>::value_type;
+        _parallel_construct(threads, (size_t)n, sizeof(V), [&](size_t b, size_t e)
+                            { lp::uninitialized_fill_n(first + b, e - b, value); },
+                            [&](size_t b, size_t e)
+                            { lp::destroy(first + b, first + e); });
+        return first + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class Size, class T>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator>
+    uninitialized_fill_n(ExecutionPolicy &&policy, ForwardIterator first, Size n, const T &value)
+    {
+        return _par_uninitialized_fill_n(_policy_threads(policy), first, n, value, _all_random_access<ForwardIterator>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    uninitialized_fill(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last, const T &value)
+    {
+        if (_all_random_access<ForwardIterator>::value)
+        {
+            lp::uninitialized_fill_n(policy, first, lp::distance(first, last), value);
+        }
+        else
+        {
+            lp::uninitialized_fill(first, last, value);
+        }
+    }
+    // endregion
+
+    // region:uninitialized_default_construct,uninitialized_value_construct
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator _par_uninitialized_default_construct_n(size_t, ForwardIterator first, Size n, std::false_type)
+    {
+        return lp::uninitialized_default_construct_n(first, n);
+    }
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _par_uninitialized_default_construct_n(size_t threads, ForwardIterator first, Size n, std::true_type)
+    {
+        using V = typename iterator_traits<ForwardIterator>::value_type;
+        if (n <= 0 || std::is_trivially_default_constructible<V>::value)
+        {
+            return lp::uninitialized_default_construct_n(first, n);
+        }
+        _parallel_construct(threads, (size_t)n, sizeof(V), [&](size_t b, size_t e)
+                            { lp::uninitialized_default_construct_n(first + b, e - b); },
+                            [&](size_t b, size_t e)
+                            { lp::destroy(first + b, first + e); });
+        return first + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class Size>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator>
+    uninitialized_default_construct_n(ExecutionPolicy &&policy, ForwardIterator first, Size n)
+    {
+        return _par_uninitialized_default_construct_n(_policy_threads(policy), first, n, _all_random_access<ForwardIterator>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    uninitialized_default_construct(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last)
+    {
+        lp::uninitialized_default_construct_n(policy, first, lp::distance(first, last));
+    }
+
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator _par_uninitialized_value_construct_n(size_t, ForwardIterator first, Size n, std::false_type)
+    {
+        return lp::uninitialized_value_construct_n(first, n);
+    }
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _par_uninitialized_value_construct_n(size_t threads, ForwardIterator first, Size n, std::true_type)
+    {
+        if (n <= 0)
+        {
+            return first;
+        }
+        using V = typename iterator_traits<ForwardIterator>::value_type;
+        _parallel_construct(threads, (size_t)n, sizeof(V), [&](size_t b, size_t e)
+                            { lp::uninitialized_value_construct_n(first + b, e - b); },
+                            [&](size_t b, size_t e)
+                            { lp::destroy(first + b, first + e); });
+        return first + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class Size>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator>
+    uninitialized_value_construct_n(ExecutionPolicy &&policy, ForwardIterator first, Size n)
+    {
+        return _par_uninitialized_value_construct_n(_policy_threads(policy), first, n, _all_random_access<ForwardIterator>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    uninitialized_value_construct(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last)
+    {
+        lp::uninitialized_value_construct_n(policy, first, lp::distance(first, last));
+    }
+    // endregion
+
+    // region:destroy
+    template <class ForwardIterator>
+    inline void _par_destroy(size_t, ForwardIterator first, ForwardIterator last, std::false_type)
+    {
+        lp::destroy(first, last);
+    }
+
+    template <class ForwardIterator>
+    void _par_destroy(size_t threads, ForwardIterator first, ForwardIterator last, std::true_type)
+    {
+        using V = typename iterator_traits<ForwardIterator>::value_type;
+        if (std::is_trivially_destructible<V>::value)
+        {
+            return;
+        }
+        size_t n = last - first;
+        parallel_chunks(n, _par_chunks(threads, n, sizeof(V)), [&](size_t b, size_t e)
+                        { lp::destroy(first + b, first + e); });
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    destroy(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last)
+    {
+        _par_destroy(_policy_threads(policy), first, last, _all_random_access<ForwardIterator>());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_PARALLEL_UNINITIALIZED_H
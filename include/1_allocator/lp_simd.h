@@ -0,0 +1,399 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+平凡类型的向量化填充与拷贝,供uninitialized_copy/uninitialized_fill/uninitialized_fill_n使用
+ * x86上提供SSE2,AVX2,AVX-512三套内核,第一次使用时通过CPUID选出CPU支持的最宽的一套
+ * 区间超过末级缓存(LLC)时改用非临时(streaming)存储,不把即将被挤出的数据写进缓存
+ * 各套内核用__attribute__((target))单独编译,不需要-mavx2等编译选项
+ * 其他平台和编译器只有通用内核(memcpy与逐个赋值)
+填充只处理大小为1,2,4,8字节且按自身大小对齐的类型,其他类型仍交给lp::fill_n
+*/
+#ifndef LP_SIMD_H
+#define LP_SIMD_H
+
+#include <cstddef>   //for size_t
+#include <cstring>   //for memcpy,memmove
+#include <stdint.h>  //for uint64_t,uintptr_t
+#include <type_traits>
+#include "../5_algorithm/lp_algobase.h" //for lp::fill_n
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _LP_SIMD_X86
+#include <immintrin.h>
+#ifndef _LP_TARGET
+#define _LP_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+#if defined(__linux__)
+#include <unistd.h> //for sysconf
+#endif
+
+namespace lp
+{
+    // SIMD级别_SIMD_GENERIC.._SIMD_LEVELS见lp_simd_scan.h
+    enum
+    {
+        _SIMD_MIN_BYTES = 64,                // 更短的区间直接memcpy/lp::fill_n,省去间接调用
+        _SIMD_DEFAULT_LLC = 32 * 1024 * 1024 // 读不到LLC大小时的假定值
+    };
+
+    // 一套内核:stream为true时使用非临时存储
+    struct simd_kernels
+    {
+        const char *name;
+        void (*copy)(void *dst, const void *src, size_t bytes, bool stream);
+        // 以8字节的pattern填充bytes个字节,bytes是元素大小的倍数,dst按元素大小对齐
+        void (*fill)(void *dst, size_t bytes, uint64_t pattern, bool stream);
+    };
+
+    // region:通用内核
+    inline void _generic_copy(void *dst, const void *src, size_t bytes, bool)
+    {
+        memcpy(dst, src, bytes);
+    }
+
+    inline void _generic_fill(void *dst, size_t bytes, uint64_t pattern, bool)
+    {
+        char *d = (char *)dst;
+        for (; bytes >= 8; bytes -= 8, d += 8)
+        {
+            memcpy(d, &pattern, 8);
+        }
+        memcpy(d, &pattern, bytes);
+    }
+    // endregion
+
+#ifdef _LP_SIMD_X86
+    // region:x86内核
+    // 三套内核结构相同:长度不足一个向量的交给通用内核;否则首尾各用一次非对齐存储,
+    // 中间从第一个向量对齐的位置开始做对齐存储.首尾与中间的重叠部分写入相同的数据
+    // 填充时dst按元素大小对齐,向量宽度是元素大小的倍数,所以任何位置开始的pattern都与元素对齐
+
+    _LP_TARGET("sse2") inline void _sse2_copy(void *dst, const void *src, size_t bytes, bool stream)
+    {
+        if (bytes < 16)
+        {
+            memcpy(dst, src, bytes);
+            return;
+        }
+        char *d = (char *)dst;
+        const char *s = (const char *)src;
+        __m128i head = _mm_loadu_si128((const __m128i *)s);
+        __m128i tail = _mm_loadu_si128((const __m128i *)(s + bytes - 16));
+        size_t i = 16 - ((uintptr_t)d & 15);
+        if (stream)
+        {
+            for (; i + 16 <= bytes; i += 16)
+            {
+                _mm_stream_si128((__m128i *)(d + i), _mm_loadu_si128((const __m128i *)(s + i)));
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; i + 16 <= bytes; i += 16)
+            {
+                _mm_store_si128((__m128i *)(d + i), _mm_loadu_si128((const __m128i *)(s + i)));
+            }
+        }
+        _mm_storeu_si128((__m128i *)d, head);
+        _mm_storeu_si128((__m128i *)(d + bytes - 16), tail);
+    }
+
+    _LP_TARGET("sse2") inline void _sse2_fill(void *dst, size_t bytes, uint64_t pattern, bool stream)
+    {
+        if (bytes < 16)
+        {
+            _generic_fill(dst, bytes, pattern, stream);
+            return;
+        }
+        char *d = (char *)dst;
+        __m128i v = _mm_set1_epi64x((long long)pattern);
+        _mm_storeu_si128((__m128i *)d, v);
+        size_t i = 16 - ((uintptr_t)d & 15);
+        if (stream)
+        {
+            for (; i + 16 <= bytes; i += 16)
+            {
+                _mm_stream_si128((__m128i *)(d + i), v);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; i + 16 <= bytes; i += 16)
+            {
+                _mm_store_si128((__m128i *)(d + i), v);
+            }
+        }
+        _mm_storeu_si128((__m128i *)(d + bytes - 16), v);
+    }
+
+    _LP_TARGET("avx2") inline void _avx2_copy(void *dst, const void *src, size_t bytes, bool stream)
+    {
+        if (bytes < 32)
+        {
+            _sse2_copy(dst, src, bytes, false);
+            return;
+        }
+        char *d = (char *)dst;
+        const char *s = (const char *)src;
+        __m256i head = _mm256_loadu_si256((const __m256i *)s);
+        __m256i tail = _mm256_loadu_si256((const __m256i *)(s + bytes - 32));
+        size_t i = 32 - ((uintptr_t)d & 31);
+        if (stream)
+        {
+            for (; i + 32 <= bytes; i += 32)
+            {
+                _mm256_stream_si256((__m256i *)(d + i), _mm256_loadu_si256((const __m256i *)(s + i)));
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            // 每次两个向量,减少循环开销
+            for (; i + 64 <= bytes; i += 64)
+            {
+                __m256i a = _mm256_loadu_si256((const __m256i *)(s + i));
+                __m256i b = _mm256_loadu_si256((const __m256i *)(s + i + 32));
+                _mm256_store_si256((__m256i *)(d + i), a);
+                _mm256_store_si256((__m256i *)(d + i + 32), b);
+            }
+            if (i + 32 <= bytes)
+            {
+                _mm256_store_si256((__m256i *)(d + i), _mm256_loadu_si256((const __m256i *)(s + i)));
+            }
+        }
+        _mm256_storeu_si256((__m256i *)d, head);
+        _mm256_storeu_si256((__m256i *)(d + bytes - 32), tail);
+        _mm256_zeroupper();
+    }
+
+    _LP_TARGET("avx2") inline void _avx2_fill(void *dst, size_t bytes, uint64_t pattern, bool stream)
+    {
+        if (bytes < 32)
+        {
+            _sse2_fill(dst, bytes, pattern, false);
+            return;
+        }
+        char *d = (char *)dst;
+        __m256i v = _mm256_set1_epi64x((long long)pattern);
+        _mm256_storeu_si256((__m256i *)d, v);
+        size_t i = 32 - ((uintptr_t)d & 31);
+        if (stream)
+        {
+            for (; i + 32 <= bytes; i += 32)
+            {
+                _mm256_stream_si256((__m256i *)(d + i), v);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; i + 64 <= bytes; i += 64)
+            {
+                _mm256_store_si256((__m256i *)(d + i), v);
+                _mm256_store_si256((__m256i *)(d + i + 32), v);
+            }
+            if (i + 32 <= bytes)
+            {
+                _mm256_store_si256((__m256i *)(d + i), v);
+            }
+        }
+        _mm256_storeu_si256((__m256i *)(d + bytes - 32), v);
+        _mm256_zeroupper();
+    }
+
+    _LP_TARGET("avx512f") inline void _avx512_copy(void *dst, const void *src, size_t bytes, bool stream)
+    {
+        if (bytes < 64)
+        {
+            _avx2_copy(dst, src, bytes, false);
+            return;
+        }
+        char *d = (char *)dst;
+        const char *s = (const char *)src;
+        __m512i head = _mm512_loadu_si512((const void *)s);
+        __m512i tail = _mm512_loadu_si512((const void *)(s + bytes - 64));
+        size_t i = 64 - ((uintptr_t)d & 63);
+        if (stream)
+        {
+            for (; i + 64 <= bytes; i += 64)
+            {
+                _mm512_stream_si512((__m512i *)(d + i), _mm512_loadu_si512((const void *)(s + i)));
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; i + 64 <= bytes; i += 64)
+            {
+                _mm512_store_si512((void *)(d + i), _mm512_loadu_si512((const void *)(s + i)));
+            }
+        }
+        _mm512_storeu_si512((void *)d, head);
+        _mm512_storeu_si512((void *)(d + bytes - 64), tail);
+        _mm256_zeroupper();
+    }
+
+    _LP_TARGET("avx512f") inline void _avx512_fill(void *dst, size_t bytes, uint64_t pattern, bool stream)
+    {
+        if (bytes < 64)
+        {
+            _avx2_fill(dst, bytes, pattern, false);
+            return;
+        }
+        char *d = (char *)dst;
+        __m512i v = _mm512_set1_epi64((long long)pattern);
+        _mm512_storeu_si512((void *)d, v);
+        size_t i = 64 - ((uintptr_t)d & 63);
+        if (stream)
+        {
+            for (; i + 64 <= bytes; i += 64)
+            {
+                _mm512_stream_si512((__m512i *)(d + i), v);
+            }
+            _mm_sfence();
+        }
+        else
+        {
+            for (; i + 64 <= bytes; i += 64)
+            {
+                _mm512_store_si512((void *)(d + i), v);
+            }
+        }
+        _mm512_storeu_si512((void *)(d + bytes - 64), v);
+        _mm256_zeroupper();
+    }
+    // endregion
+#endif // _LP_SIMD_X86
+
+    // region:simd
+    class simd
+    {
+    public:
+        // CPU支持的最高级别
+        static int best_level()
+        {
+#ifdef _LP_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return _SIMD_AVX512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return _SIMD_AVX2;
+            }
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return _SIMD_SSE2;
+            }
+#endif
+            return _SIMD_GENERIC;
+        }
+
+        // 指定级别的内核,不检查CPU是否支持;本平台没有的级别退回通用内核
+        static const simd_kernels &kernels(int level)
+        {
+            static const simd_kernels table[_SIMD_LEVELS] = {
+                {"generic", _generic_copy, _generic_fill},
+#ifdef _LP_SIMD_X86
+                {"sse2", _sse2_copy, _sse2_fill},
+                {"avx2", _avx2_copy, _avx2_fill},
+                {"avx512", _avx512_copy, _avx512_fill},
+#else
+                {"generic", _generic_copy, _generic_fill},
+                {"generic", _generic_copy, _generic_fill},
+                {"generic", _generic_copy, _generic_fill},
+#endif
+            };
+            return table[level < _SIMD_LEVELS ? level : _SIMD_GENERIC];
+        }
+
+        // 第一次调用时按CPUID选定,之后不再改变
+        static const simd_kernels &active()
+        {
+            static const simd_kernels &k = kernels(best_level());
+            return k;
+        }
+
+        // 不小于此字节数的区间使用非临时存储,取末级缓存的大小
+        static size_t stream_threshold()
+        {
+            static const size_t threshold = llc_size();
+            return threshold;
+        }
+
+        // 与memcpy相同;区间重叠时退回memmove
+        static void copy(void *dst, const void *src, size_t bytes)
+        {
+            if (bytes < _SIMD_MIN_BYTES || overlap(dst, src, bytes))
+            {
+                memmove(dst, src, bytes);
+                return;
+            }
+            active().copy(dst, src, bytes, bytes >= stream_threshold());
+        }
+
+        // 以value填充[dst,dst+n),T须平凡可拷贝
+        template <class T>
+        static void fill(T *dst, size_t n, const T &value)
+        {
+            using fast = std::integral_constant<bool, (1 == sizeof(T) || 2 == sizeof(T) || 4 == sizeof(T) ||
+                                                       8 == sizeof(T)) &&
+                                                          alignof(T) == sizeof(T)>;
+            _fill(dst, n, value, fast());
+        }
+
+    private:
+        static bool overlap(const void *dst, const void *src, size_t bytes)
+        {
+            uintptr_t d = (uintptr_t)dst, s = (uintptr_t)src;
+            return d < s + bytes && s < d + bytes;
+        }
+
+        static size_t llc_size()
+        {
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+            long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+            if (l3 > 0)
+            {
+                return (size_t)l3;
+            }
+#endif
+            return _SIMD_DEFAULT_LLC;
+        }
+
+        template <class T>
+        static void _fill(T *dst, size_t n, const T &value, std::true_type)
+        {
+            size_t bytes = n * sizeof(T);
+            if (bytes < _SIMD_MIN_BYTES)
+            {
+                lp::fill_n(dst, n, value);
+                return;
+            }
+            // 把value重复铺满8个字节
+            uint64_t pattern;
+            for (size_t i = 0; i < 8; i += sizeof(T))
+            {
+                memcpy((char *)&pattern + i, &value, sizeof(T));
+            }
+            active().fill(dst, bytes, pattern, bytes >= stream_threshold());
+        }
+
+        template <class T>
+        static void _fill(T *dst, size_t n, const T &value, std::false_type)
+        {
+            lp::fill_n(dst, n, value);
+        }
+    };
+    // endregion
+} // namespace lp
+
+#endif // LP_SIMD_H
@@ -0,0 +1,209 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+二级配置器的size class(区块规格)策略
+一个size class策略描述内存池管理哪些规格的区块,需提供:
+ * nclasses          规格个数,即free_list个数
+ * max_bytes         最大规格,超过该值的需求移交一级配置器
+ * index(bytes)      容纳bytes所需的最小规格的编号,bytes位于[1,max_bytes]
+ * size(index)       编号为index的规格的字节数
+ * floor_index(bytes) 不超过bytes的最大规格的编号,bytes >= size(0)
+规格表和查找表都在编译期由constexpr函数生成,运行时只有一次查表
+*/
+#ifndef LP_SIZE_CLASS_H
+#define LP_SIZE_CLASS_H
+
+#include <cstddef> //for size_t
+
+namespace lp
+{
+    // region:编译期整数序列,C++11没有std::index_sequence,这里自己实现一个
+    // _make_index_sequence<N>::type 即 _index_sequence<0,1,...,N-1>,递归深度为log(N)
+    template <size_t... I>
+    struct _index_sequence
+    {
+    };
+
+    template <class S1, class S2>
+    struct _concat_index_sequence;
+
+    template <size_t... I1, size_t... I2>
+    struct _concat_index_sequence<_index_sequence<I1...>, _index_sequence<I2...>>
+    {
+        using type = _index_sequence<I1..., (sizeof...(I1) + I2)...>;
+    };
+
+    template <size_t N>
+    struct _make_index_sequence
+        : _concat_index_sequence<typename _make_index_sequence<N / 2>::type,
+                                 typename _make_index_sequence<N - N / 2>::type>
+    {
+    };
+
+    template <>
+    struct _make_index_sequence<0>
+    {
+        using type = _index_sequence<>;
+    };
+
+    template <>
+    struct _make_index_sequence<1>
+    {
+        using type = _index_sequence<0>;
+    };
+    // endregion 编译期整数序列
+
+    // region:由规格描述(Spec)生成规格表和查找表
+    /*
+     * Spec需提供:
+     * granule  所有规格都是granule的倍数,查找表以granule为步长
+     * limit    规格上限,大于limit的规格被丢弃
+     * size(i)  第i个规格的字节数,constexpr且随i严格递增
+     */
+    // 规格随编号严格递增,用二分查找,constexpr递归深度只有log级别
+    // 在[lo,hi)中查找第一个不小于bytes的规格的编号
+    template <class Spec>
+    constexpr size_t _size_class_lower_bound(size_t bytes, size_t lo, size_t hi)
+    {
+        return lo == hi ? lo
+                        : (Spec::size(lo + (hi - lo) / 2) >= bytes
+                               ? _size_class_lower_bound<Spec>(bytes, lo, lo + (hi - lo) / 2)
+                               : _size_class_lower_bound<Spec>(bytes, lo + (hi - lo) / 2 + 1, hi));
+    }
+
+    // 规格个数:第一个超过limit的规格的编号
+    // 规格都是granule的倍数且严格递增,因此个数不超过limit / granule
+    template <class Spec>
+    constexpr size_t _size_class_count()
+    {
+        return _size_class_lower_bound<Spec>(Spec::limit + 1, 0, Spec::limit / Spec::granule);
+    }
+
+    // 能容纳bytes的最小规格的编号
+    template <class Spec>
+    constexpr size_t _size_class_first_fit(size_t bytes)
+    {
+        return _size_class_lower_bound<Spec>(bytes, 0, _size_class_count<Spec>());
+    }
+
+    template <class Spec, class Seq>
+    struct _size_class_sizes;
+
+    template <class Spec, size_t... I>
+    struct _size_class_sizes<Spec, _index_sequence<I...>>
+    {
+        static constexpr size_t table[sizeof...(I)] = {Spec::size(I)...};
+    };
+
+    template <class Spec, size_t... I>
+    constexpr size_t _size_class_sizes<Spec, _index_sequence<I...>>::table[sizeof...(I)];
+
+    // 查找表:table[k]为能容纳k * granule字节的最小规格的编号
+    template <class Spec, class Seq>
+    struct _size_class_lookup;
+
+    template <class Spec, size_t... I>
+    struct _size_class_lookup<Spec, _index_sequence<I...>>
+    {
+        static constexpr unsigned short table[sizeof...(I)] = {
+            static_cast<unsigned short>(_size_class_first_fit<Spec>(I * Spec::granule))...};
+    };
+
+    template <class Spec, size_t... I>
+    constexpr unsigned short _size_class_lookup<Spec, _index_sequence<I...>>::table[sizeof...(I)];
+
+    template <class Spec>
+    class _size_class_table
+    {
+    public:
+        static constexpr size_t nclasses = _size_class_count<Spec>();
+        static constexpr size_t max_bytes = Spec::size(nclasses - 1);
+        static constexpr size_t granule = Spec::granule;
+
+    private:
+        static_assert(nclasses > 0, "size class table is empty");
+        static_assert(nclasses < 65536, "too many size classes");
+
+        using sizes = _size_class_sizes<Spec, typename _make_index_sequence<nclasses>::type>;
+        using lookup = _size_class_lookup<Spec, typename _make_index_sequence<max_bytes / granule + 1>::type>;
+
+    public:
+        static size_t index(size_t bytes)
+        {
+            return lookup::table[(bytes + granule - 1) / granule];
+        }
+        static size_t size(size_t index)
+        {
+            return sizes::table[index];
+        }
+        static size_t floor_index(size_t bytes)
+        {
+            if (bytes >= max_bytes)
+            {
+                return nclasses - 1;
+            }
+            size_t i = index(bytes);
+            return size(i) > bytes ? i - 1 : i;
+        }
+    };
+
+    template <class Spec>
+    constexpr size_t _size_class_table<Spec>::nclasses;
+    template <class Spec>
+    constexpr size_t _size_class_table<Spec>::max_bytes;
+    template <class Spec>
+    constexpr size_t _size_class_table<Spec>::granule;
+    // endregion 由规格描述生成规格表和查找表
+
+    // region:线性规格 Align,2*Align,...,MaxBytes
+    // 即原先二级配置器的做法,默认<8,128>,共16个规格
+    template <size_t Align, size_t MaxBytes>
+    struct _linear_size_class_spec
+    {
+        static constexpr size_t granule = Align;
+        static constexpr size_t limit = MaxBytes;
+        static constexpr size_t size(size_t i) { return (i + 1) * Align; }
+    };
+
+    template <size_t Align, size_t MaxBytes>
+    struct _linear_size_class : public _size_class_table<_linear_size_class_spec<Align, MaxBytes>>
+    {
+    };
+    // endregion 线性规格
+
+    // region:几何规格
+    /*
+     * 8,16,...,8*Steps 为线性部分
+     * 之后每个2的幂区间(B,2B]再等分为Steps个规格,间距为B/Steps
+     * 例如Steps=4: 8,16,24,32, 40,48,56,64, 80,96,112,128, 160,192,224,256, ...
+     * 内部碎片不超过1/(Steps+1),而规格数只随MaxBytes对数增长
+     */
+    template <size_t Steps, size_t MaxBytes>
+    struct _geometric_size_class_spec
+    {
+        static constexpr size_t granule = 8;
+        static constexpr size_t limit = MaxBytes;
+        // 查找规格个数时会试探远超limit的编号,移位过大时直接返回最大值,避免溢出
+        static constexpr size_t size(size_t i)
+        {
+            return i < Steps ? 8 * (i + 1)
+                   : (i - Steps) / Steps >= 24
+                       ? ~size_t(0)
+                       : (size_t(8) << ((i - Steps) / Steps)) * (Steps + (i - Steps) % Steps + 1);
+        }
+    };
+
+    template <size_t Steps, size_t MaxBytes>
+    struct _geometric_size_class : public _size_class_table<_geometric_size_class_spec<Steps, MaxBytes>>
+    {
+        static_assert(Steps >= 1, "Steps must be positive");
+    };
+    // endregion 几何规格
+} // namespace lp
+
+#endif // LP_SIZE_CLASS_H
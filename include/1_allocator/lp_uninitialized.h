@@ -9,28 +9,109 @@
 #include <type_traits>
 #include <new>
 #include <cstring>
+#include <utility>   //for std::move
+#include <memory>    //for std::unique_ptr,std::shared_ptr
+#include "lp_construct.h"
+#include "lp_simd.h"
+#include "../5_algorithm/lp_algobase.h"
 namespace lp
 {
+    // region:平凡类型的拷贝与填充
+    // 连续内存(原生指针或连续迭代器)交给lp::simd的向量化内核,其他迭代器交给lp的基本算法
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _trivial_copy(InputIterator first, InputIterator last, ForwardIterator result, std::false_type)
+    {
+        return lp::copy(first, last, result);
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _trivial_copy(InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
+    {
+        using T = typename iterator_traits<ForwardIterator>::value_type;
+        const ptrdiff_t n = last - first;
+        if (n != 0)
+        {
+            simd::copy(lp::to_address(result), lp::to_address(first), n * sizeof(T));
+        }
+        return result + n;
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _trivial_copy(InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return _trivial_copy(first, last, result, _is_contiguous_same<InputIterator, ForwardIterator>());
+    }
+
+    template <class ForwardIterator, class Size, class T>
+    inline ForwardIterator _trivial_fill_n(ForwardIterator first, Size n, const T &value, std::false_type)
+    {
+        return lp::fill_n(first, n, value);
+    }
+
+    template <class ForwardIterator, class Size, class T>
+    inline ForwardIterator _trivial_fill_n(ForwardIterator first, Size n, const T &value, std::true_type)
+    {
+        if (n <= 0)
+        {
+            return first;
+        }
+        const typename iterator_traits<ForwardIterator>::value_type tmp = value;
+        simd::fill(lp::to_address(first), (size_t)n, tmp);
+        return first + n;
+    }
+
+    template <class ForwardIterator, class Size, class T>
+    inline ForwardIterator _trivial_fill_n(ForwardIterator first, Size n, const T &value)
+    {
+        return _trivial_fill_n(first, n, value, is_contiguous_iterator<ForwardIterator>());
+    }
+
+    template <class ForwardIterator, class T>
+    inline void _trivial_fill(ForwardIterator first, ForwardIterator last, const T &value, std::false_type)
+    {
+        lp::fill(first, last, value);
+    }
+
+    template <class ForwardIterator, class T>
+    inline void _trivial_fill(ForwardIterator first, ForwardIterator last, const T &value, std::true_type)
+    {
+        _trivial_fill_n(first, last - first, value, std::true_type());
+    }
+
+    template <class ForwardIterator, class T>
+    inline void _trivial_fill(ForwardIterator first, ForwardIterator last, const T &value)
+    {
+        _trivial_fill(first, last, value, is_contiguous_iterator<ForwardIterator>());
+    }
+    // endregion
+
     // region:uninitialized_copy
+    // 能否按字节拷贝由目标元素类型决定:目标平凡可拷贝且与源元素类型相同,
+    // 否则(如const char*构造std::string)只能逐个构造,不能对未构造的空间赋值
+    template <class InputIterator, class ForwardIterator>
+    struct _is_trivial_construct
+        : std::integral_constant<bool, std::is_trivially_copyable<typename iterator_traits<ForwardIterator>::value_type>::value &&
+                                           std::is_same<typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type,
+                                                        typename iterator_traits<ForwardIterator>::value_type>::value>
+    {
+    };
+
     template <class InputIterator, class ForwardIterator>
     ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, std::true_type);
 
     template <class InputIterator, class ForwardIterator>
     ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, std::false_type);
-    template <class InputIterator, class ForwardIterator>
 
+    template <class InputIterator, class ForwardIterator>
     inline ForwardIterator uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result)
     {
-        // std::iterator_traits 替换为 lp::iterator_traits
-        using ValueType = typename std::iterator_traits<InputIterator>::value_type;
-        return _uninitialized_copy(first, last, result, std::is_trivially_copyable<ValueType>());
+        return _uninitialized_copy(first, last, result, _is_trivial_construct<InputIterator, ForwardIterator>());
     }
 
     template <class InputIterator, class ForwardIterator>
     ForwardIterator _uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
     {
-        // TODO: std::copy改为lp::copy
-        return std::copy(first, last, result);
+        return _trivial_copy(first, last, result);
     }
 
     template <class InputIterator, class ForwardIterator>
@@ -41,7 +122,7 @@ namespace lp
         {
             for (; first != last; ++first, ++cur)
             {
-                construct(&*cur, *first);
+                lp::construct(&*cur, *first);
             }
         }
         catch (...)
@@ -50,27 +131,152 @@ namespace lp
             while (cur != result)
             {
                 --cur;
-                destroy(&*cur);
+                lp::destroy(&*cur);
             }
             throw;
         }
         return cur;
     }
 
-    // 对char*和wchar_t*等指针类型，使用memmove进行优化
+    // 对char*和wchar_t*等指针类型，使用向量化拷贝进行优化(区间重叠时退回memmove)
     inline char *uninitialized_copy(const char *first, const char *last, char *result)
     {
-        memmove(result, first, last - first);
+        simd::copy(result, first, last - first);
         return result + (last - first);
     }
 
     inline wchar_t *uninitialized_copy(const wchar_t *first, const wchar_t *last, wchar_t *result)
     {
-        memmove(result, first, (last - first) * sizeof(wchar_t));
+        simd::copy(result, first, (last - first) * sizeof(wchar_t));
         return result + (last - first);
     }
     // endregion uninitialized_copy
 
+    // region:uninitialized_move
+    // 与uninitialized_copy相同,但以移动构造代替拷贝构造,源区间中的对象变为"已移动"状态;
+    // 同样由目标元素类型决定能否按字节拷贝
+    template <class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result, std::true_type);
+
+    template <class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result, std::false_type);
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        return _uninitialized_move(first, last, result, _is_trivial_construct<InputIterator, ForwardIterator>());
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
+    {
+        // 平凡可拷贝的类型移动就是拷贝
+        return _trivial_copy(first, last, result);
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    ForwardIterator _uninitialized_move(InputIterator first, InputIterator last, ForwardIterator result, std::false_type)
+    {
+        ForwardIterator cur = result;
+        try
+        {
+            for (; first != last; ++first, ++cur)
+            {
+                lp::construct(&*cur, std::move(*first));
+            }
+        }
+        catch (...)
+        {
+            // 已移动的源对象无法复原,只销毁已经构造的对象
+            while (cur != result)
+            {
+                --cur;
+                lp::destroy(&*cur);
+            }
+            throw;
+        }
+        return cur;
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _uninitialized_move_if_noexcept(InputIterator first, InputIterator last, ForwardIterator result, std::true_type)
+    {
+        return lp::uninitialized_move(first, last, result);
+    }
+
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator _uninitialized_move_if_noexcept(InputIterator first, InputIterator last, ForwardIterator result, std::false_type)
+    {
+        return lp::uninitialized_copy(first, last, result);
+    }
+
+    // 移动构造不会抛出异常(或者根本不能拷贝)时才移动,否则拷贝
+    // vector扩容时用它搬迁元素:拷贝途中抛出异常,旧缓冲区仍完好,保证强异常安全
+    template <class InputIterator, class ForwardIterator>
+    inline ForwardIterator uninitialized_move_if_noexcept(InputIterator first, InputIterator last, ForwardIterator result)
+    {
+        using ValueType = typename iterator_traits<InputIterator>::value_type;
+        using use_move = std::integral_constant<bool, std::is_nothrow_move_constructible<ValueType>::value ||
+                                                          !std::is_copy_constructible<ValueType>::value>;
+        return _uninitialized_move_if_noexcept(first, last, result, use_move());
+    }
+    // endregion uninitialized_move
+
+    // region:uninitialized_relocate
+    // 平凡可重定位:把对象按位搬到新地址并且不再析构原对象,等价于移动构造后析构原对象
+    // 平凡可拷贝的类型默认为true;其他类型只要不保存指向自身的指针(如unique_ptr,多数句柄类型)也满足,
+    // 可以特化为true,例如:
+    //     template <> struct lp::is_trivially_relocatable<my_handle> : std::true_type {};
+    // 容器搬迁这些类型时用memmove/realloc代替逐个移动和析构
+    // 注意libstdc++的std::string短字符串优化时指向自身内部,不能标记
+    template <class T>
+    struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+    {
+    };
+
+    template <class T>
+    struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+    {
+    };
+
+    template <class T>
+    struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+    {
+    };
+
+    template <class T>
+    T *_uninitialized_relocate(T *first, T *last, T *result, std::true_type);
+
+    template <class T>
+    T *_uninitialized_relocate(T *first, T *last, T *result, std::false_type);
+
+    // 把[first,last)中的对象搬到result开始的未初始化空间,之后[first,last)成为未初始化空间
+    // 平凡可重定位时两段空间可以重叠,否则不能重叠
+    template <class T>
+    inline T *uninitialized_relocate(T *first, T *last, T *result)
+    {
+        return _uninitialized_relocate(first, last, result, is_trivially_relocatable<T>());
+    }
+
+    template <class T>
+    inline T *_uninitialized_relocate(T *first, T *last, T *result, std::true_type)
+    {
+        if (first != last)
+        {
+            memmove((void *)result, (const void *)first, (last - first) * sizeof(T));
+        }
+        return result + (last - first);
+    }
+
+    template <class T>
+    inline T *_uninitialized_relocate(T *first, T *last, T *result, std::false_type)
+    {
+        T *cur = lp::uninitialized_move_if_noexcept(first, last, result);
+        lp::destroy(first, last);
+        return cur;
+    }
+    // endregion uninitialized_relocate
+
     // region:uninitialized_fill
     template <class ForwardIterator, class T>
     void _uninitialized_fill(ForwardIterator first, ForwardIterator last, const T &value, std::false_type);
@@ -81,16 +287,16 @@ namespace lp
     template <class ForwardIterator, class T>
     inline void uninitialized_fill(ForwardIterator first, ForwardIterator last, const T &value)
     {
-        // 根据 T 的类型，决定是使用 std::true_type 还是 std::false_type
+        // 根据元素(而不是value)的类型，决定是使用 std::true_type 还是 std::false_type
         // 然后使用这个类型来调用 _uninitialized_fill 函数
-        _uninitialized_fill(first, last, value, std::is_trivial<T>());
+        using ValueType = typename iterator_traits<ForwardIterator>::value_type;
+        _uninitialized_fill(first, last, value, std::is_trivial<ValueType>());
     }
 
     template <class ForwardIterator, class T>
     inline void _uninitialized_fill(ForwardIterator first, ForwardIterator last, const T &value, std::true_type)
     {
-        // TODO: std::fill改为lp::fill
-        std::fill(first, last, value);
+        _trivial_fill(first, last, value);
     }
 
     template <class ForwardIterator, class T>
@@ -101,7 +307,7 @@ namespace lp
         {
             for (; cur != last; ++cur)
             {
-                construct(&*cur, value);
+                lp::construct(&*cur, value);
             }
         }
         catch (...)
@@ -110,7 +316,7 @@ namespace lp
             while (cur != first)
             {
                 --cur;
-                destroy(&*cur);
+                lp::destroy(&*cur);
             }
             throw; // 重新抛出异常
         }
@@ -127,16 +333,16 @@ namespace lp
     template <class ForwardIterator, class Size, class T>
     inline ForwardIterator uninitialized_fill_n(ForwardIterator first, Size n, const T &value)
     {
-        // 然后使用这个类型来调用 _uninitialized_fill 函数
-        return _uninitialized_fill_n(first, n, value, std::is_trivial<T>());
+        // 与uninitialized_fill相同,按元素的类型分派
+        using ValueType = typename iterator_traits<ForwardIterator>::value_type;
+        return _uninitialized_fill_n(first, n, value, std::is_trivial<ValueType>());
     }
 
     template <class ForwardIterator, class Size, class T>
     inline ForwardIterator _uninitialized_fill_n(ForwardIterator first, Size n, const T &value, std::true_type)
     {
-        // 对Trivial类型可以直接使用内存填充操作，如通过使用标准库算法std::fill
-        // TODO: std::fill_n改为lp::fill_n
-        return std::fill_n(first, n, value);
+        // 对Trivial类型可以直接使用内存填充操作,连续内存上使用向量化填充
+        return _trivial_fill_n(first, n, value);
     }
 
     template <class ForwardIterator, class Size, class T>
@@ -147,7 +353,7 @@ namespace lp
         {
             for (; n > 0; --n, ++cur)
             {
-                construct(&*cur, value);
+                lp::construct(&*cur, value);
             }
         }
         catch (...)
@@ -156,12 +362,128 @@ namespace lp
             while (cur != first)
             {
                 --cur;
-                destroy(&*cur);
+                lp::destroy(&*cur);
             }
             throw; // 重新抛出异常
         }
         return cur;
     }
     // endregion uninitialized_fill_n
+
+    // region:uninitialized_default_construct
+    // 构造函数的标签:要求元素默认初始化,平凡类型的元素不初始化,例如
+    //     lp::vector<uint8_t> buf(n, lp::default_init); // 随后由read()写满,不必先清零
+    struct default_init_t
+    {
+    };
+    constexpr default_init_t default_init = default_init_t();
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_default_construct_n(ForwardIterator first, Size n, std::true_type);
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_default_construct_n(ForwardIterator first, Size n, std::false_type);
+
+    // 在[first,first+n)上默认初始化,返回first+n
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator uninitialized_default_construct_n(ForwardIterator first, Size n)
+    {
+        using ValueType = typename iterator_traits<ForwardIterator>::value_type;
+        return _uninitialized_default_construct_n(first, n, std::is_trivially_default_constructible<ValueType>());
+    }
+
+    template <class ForwardIterator>
+    inline void uninitialized_default_construct(ForwardIterator first, ForwardIterator last)
+    {
+        lp::uninitialized_default_construct_n(first, lp::distance(first, last));
+    }
+
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator _uninitialized_default_construct_n(ForwardIterator first, Size n, std::true_type)
+    {
+        // 平凡的默认构造什么都不做,只需移动迭代器
+        if (n > 0)
+        {
+            lp::advance(first, n);
+        }
+        return first;
+    }
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_default_construct_n(ForwardIterator first, Size n, std::false_type)
+    {
+        ForwardIterator cur = first;
+        try
+        {
+            for (; n > 0; --n, ++cur)
+            {
+                lp::default_construct(&*cur);
+            }
+        }
+        catch (...)
+        {
+            while (cur != first)
+            {
+                --cur;
+                lp::destroy(&*cur);
+            }
+            throw;
+        }
+        return cur;
+    }
+    // endregion uninitialized_default_construct
+
+    // region:uninitialized_value_construct
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_value_construct_n(ForwardIterator first, Size n, std::true_type);
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_value_construct_n(ForwardIterator first, Size n, std::false_type);
+
+    // 在[first,first+n)上值初始化(平凡类型清零),返回first+n
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator uninitialized_value_construct_n(ForwardIterator first, Size n)
+    {
+        using ValueType = typename iterator_traits<ForwardIterator>::value_type;
+        return _uninitialized_value_construct_n(first, n, std::is_trivial<ValueType>());
+    }
+
+    template <class ForwardIterator>
+    inline void uninitialized_value_construct(ForwardIterator first, ForwardIterator last)
+    {
+        lp::uninitialized_value_construct_n(first, lp::distance(first, last));
+    }
+
+    template <class ForwardIterator, class Size>
+    inline ForwardIterator _uninitialized_value_construct_n(ForwardIterator first, Size n, std::true_type)
+    {
+        // 平凡类型的值初始化就是填充T(),连续内存上使用向量化填充
+        using ValueType = typename iterator_traits<ForwardIterator>::value_type;
+        return _trivial_fill_n(first, n, ValueType());
+    }
+
+    template <class ForwardIterator, class Size>
+    ForwardIterator _uninitialized_value_construct_n(ForwardIterator first, Size n, std::false_type)
+    {
+        ForwardIterator cur = first;
+        try
+        {
+            for (; n > 0; --n, ++cur)
+            {
+                lp::construct(&*cur);
+            }
+        }
+        catch (...)
+        {
+            while (cur != first)
+            {
+                --cur;
+                lp::destroy(&*cur);
+            }
+            throw;
+        }
+        return cur;
+    }
+    // endregion uninitialized_value_construct
 } // namespace LP
 #endif // LP_UNINITIALIZED_H
\ No newline at end of file
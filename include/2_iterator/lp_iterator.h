@@ -7,15 +7,18 @@
 #ifndef LP_ITERATOR_H
 #define LP_ITERATOR_H
 #include <cstddef>
+#include <iterator> //for std::*_iterator_tag
+#include <type_traits>
 namespace lp
 {
     // region: 基础iterator类,自定义的迭代器类应继承该类
+    // 模板参数的顺序与std::iterator相同:没有默认值的Category必须在最前面
     template <
-        class T,                    // 元素类型
-        class Reference = T &,      // 引用类型
-        class Pointer = T *,        // 指针类型
-        class Category,             // 迭代器类型
-        class Distance = ptrdiff_t> // 距离类型
+        class Category,              // 迭代器类型
+        class T,                     // 元素类型
+        class Distance = ptrdiff_t,  // 距离类型
+        class Pointer = T *,         // 指针类型
+        class Reference = T &>       // 引用类型
     struct iterator
     {
         using value_type = T;
@@ -66,12 +69,79 @@ namespace lp
          * 支持所有指针算术能力,包括++、--,p+n,p-n,p1-p2,p1<p2
          */
     };
+    struct contiguous_iterator_tag : public random_access_iterator_tag
+    {
+        /*连续迭代器
+         * 随机访问迭代器,且元素在内存中连续存放:*(it + n)与*(lp::to_address(it) + n)是同一个对象
+         * 原生指针和包装指针的容器迭代器属于此类,算法可以直接对[to_address(first),to_address(first) + n)
+         * 做memmove/memset/memcmp
+         */
+    };
     // endregion 常用迭代器类型tag
+    // 标准库迭代器(如std::vector<T>::iterator)的std::*_iterator_tag换成对应的lp tag,
+    // 使lp的算法也能按类型分派标准库的迭代器
+    template <class Category>
+    struct _lp_category
+    {
+        using type = Category;
+    };
+    template <>
+    struct _lp_category<std::input_iterator_tag>
+    {
+        using type = input_iterator_tag;
+    };
+    template <>
+    struct _lp_category<std::output_iterator_tag>
+    {
+        using type = output_iterator_tag;
+    };
+    template <>
+    struct _lp_category<std::forward_iterator_tag>
+    {
+        using type = forward_iterator_tag;
+    };
+    template <>
+    struct _lp_category<std::bidirectional_iterator_tag>
+    {
+        using type = bidirectional_iterator_tag;
+    };
+    template <>
+    struct _lp_category<std::random_access_iterator_tag>
+    {
+        using type = random_access_iterator_tag;
+    };
+#if __cplusplus >= 202002L
+    template <>
+    struct _lp_category<std::contiguous_iterator_tag>
+    {
+        using type = contiguous_iterator_tag;
+    };
+
+    // C++20的标准库迭代器(如std::vector<T>::iterator)只在iterator_concept中声明自己是连续的
+    template <class Iterator, class = void>
+    struct _std_category
+    {
+        using type = typename Iterator::iterator_category;
+    };
+    template <class Iterator>
+    struct _std_category<Iterator, typename std::enable_if<std::is_same<typename Iterator::iterator_concept,
+                                                                        std::contiguous_iterator_tag>::value>::type>
+    {
+        using type = std::contiguous_iterator_tag;
+    };
+#else
+    template <class Iterator>
+    struct _std_category
+    {
+        using type = typename Iterator::iterator_category;
+    };
+#endif
+
     //  region:萃取器,用于获取迭代器的相关信息
     template <class Iterator>
     struct iterator_traits
     {
-        using iterator_category = typename Iterator::iterator_category;
+        using iterator_category = typename _lp_category<typename _std_category<Iterator>::type>::type;
         using value_type = typename Iterator::value_type;
         using difference_type = typename Iterator::difference_type;
         using pointer = typename Iterator::pointer;
@@ -82,7 +152,7 @@ namespace lp
     template <class T>
     struct iterator_traits<T *>
     {
-        using iterator_category = random_access_iterator_tag;
+        using iterator_category = contiguous_iterator_tag;
         using value_type = T;
         using difference_type = ptrdiff_t;
         using pointer = T *;
@@ -93,13 +163,70 @@ namespace lp
     template <class T>
     struct iterator_traits<const T *>
     {
-        using iterator_category = random_access_iterator_tag;
+        using iterator_category = contiguous_iterator_tag;
         using value_type = T;
         using difference_type = ptrdiff_t;
         using pointer = const T *;
         using reference = const T &;
     };
     // endregion 萃取器
+
+    // region:迭代器类型的判断
+    template <class Iterator, class Category>
+    struct _has_iterator_category
+        : std::integral_constant<bool, std::is_base_of<Category, typename iterator_traits<Iterator>::iterator_category>::value>
+    {
+    };
+
+    template <class Iterator>
+    struct is_input_iterator : _has_iterator_category<Iterator, input_iterator_tag>
+    {
+    };
+
+    template <class Iterator>
+    struct is_forward_iterator : _has_iterator_category<Iterator, forward_iterator_tag>
+    {
+    };
+
+    template <class Iterator>
+    struct is_bidirectional_iterator : _has_iterator_category<Iterator, bidirectional_iterator_tag>
+    {
+    };
+
+    template <class Iterator>
+    struct is_random_access_iterator : _has_iterator_category<Iterator, random_access_iterator_tag>
+    {
+    };
+
+    template <class Iterator>
+    struct is_contiguous_iterator : _has_iterator_category<Iterator, contiguous_iterator_tag>
+    {
+    };
+    // endregion 迭代器类型的判断
+
+    // region:to_address,连续迭代器所指元素的地址
+    // 默认调用it.operator->();没有operator->或者它不返回原生指针的迭代器可以特化本模板,例如
+    //     template <> struct lp::to_address_traits<my_iter> { static int *to_address(const my_iter &it) { return it.p; } };
+    // 尾后迭代器也必须能转换,不能通过解引用实现
+    template <class Iterator>
+    struct to_address_traits
+    {
+        using pointer = typename std::remove_reference<typename iterator_traits<Iterator>::reference>::type *;
+        static pointer to_address(const Iterator &it) { return it.operator->(); }
+    };
+
+    template <class T>
+    inline T *to_address(T *p)
+    {
+        return p;
+    }
+
+    template <class Iterator>
+    inline typename to_address_traits<Iterator>::pointer to_address(const Iterator &it)
+    {
+        return to_address_traits<Iterator>::to_address(it);
+    }
+    // endregion to_address
     // 定义一些函数用来进行萃取
     // region:萃取获得迭代器的类型(category)
     template <class Iterator>
@@ -145,6 +272,7 @@ namespace lp
         return n;
     }
 
+    // 连续迭代器(contiguous_iterator_tag)也走这个版本
     template <class RandomAccessIterator>
     inline typename iterator_traits<RandomAccessIterator>::difference_type
     _distance(RandomAccessIterator first, RandomAccessIterator last, random_access_iterator_tag)
@@ -184,7 +312,7 @@ namespace lp
         }
     }
 
-    // 对于random_access_iterator_tag,支持指针算术能力(随机移动)
+    // 对于random_access_iterator_tag(包括contiguous_iterator_tag),支持指针算术能力(随机移动)
     template <class RandomAccessIterator, class Distance>
     inline void _advance(RandomAccessIterator &it, Distance n, random_access_iterator_tag)
     {
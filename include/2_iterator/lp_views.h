@@ -0,0 +1,631 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+惰性视图:filter,transform,take,zip,chunk,只需要C++11
+视图只保存迭代器和函数对象,不复制元素,也不分配内存;串联的视图在遍历时一次完成所有步骤:
+    auto v = lp::views::take(lp::views::transform(lp::views::filter(src, is_odd), square), 100);
+或者用管道写法:
+    auto v = src | lp::views::filter(is_odd) | lp::views::transform(square) | lp::views::take(100);
+    lp::vector<int> out = lp::views::to<lp::vector<int>>(v); // 显式物化
+ * 每个视图都是lp::subrange<适配后的迭代器>,迭代器继承lp::iterator,类型tag由底层迭代器决定:
+   transform,take,zip保留随机访问(不再是连续的),filter,chunk最多是前向迭代器
+ * 随机访问的视图上lp::distance是O(1)的,to据此预先按大小分配目标容器
+ * 视图引用底层容器的元素,不能比容器活得更久,因此底层区间只能是左值容器或另一个视图
+ * 函数对象以const方式调用,拷贝构造时不应抛出异常
+*/
+#ifndef LP_VIEWS_H
+#define LP_VIEWS_H
+
+#include <cstddef>     //for size_t,ptrdiff_t
+#include <new>         //for placement new
+#include <type_traits> //for std::conditional,std::decay等
+#include <utility>     //for std::pair,std::declval,std::forward
+#include "lp_iterator.h"
+#include "../1_allocator/lp_uninitialized.h" //for lp::default_init_t
+#include "../5_algorithm/lp_algobase.h"      //for lp::copy,lp::min
+
+namespace lp
+{
+    // region:辅助类型
+    template <class Iterator>
+    using _iter_category = typename iterator_traits<Iterator>::iterator_category;
+    template <class Iterator>
+    using _iter_value = typename iterator_traits<Iterator>::value_type;
+    template <class Iterator>
+    using _iter_difference = typename iterator_traits<Iterator>::difference_type;
+    template <class Iterator>
+    using _iter_reference = typename iterator_traits<Iterator>::reference;
+
+    // 两个类型tag中较弱的一个
+    template <class Category1, class Category2>
+    struct _weaker_category
+        : std::conditional<std::is_base_of<Category1, Category2>::value, Category1, Category2>
+    {
+    };
+
+    // 适配后的迭代器不再是连续的,最多是随机访问迭代器
+    template <class Iterator>
+    using _adapted_category = typename _weaker_category<random_access_iterator_tag, _iter_category<Iterator>>::type;
+
+    // 可以拷贝赋值的函数对象包装:lambda没有拷贝赋值,直接作为成员会使迭代器不能赋值
+    template <class Function, bool = std::is_copy_assignable<Function>::value>
+    class _func_box
+    {
+    private:
+        Function f;
+
+    public:
+        explicit _func_box(const Function &f) : f(f) {}
+        const Function &get() const { return f; }
+    };
+
+    template <class Function>
+    class _func_box<Function, false>
+    {
+    private:
+        typename std::aligned_storage<sizeof(Function), alignof(Function)>::type buf;
+
+    public:
+        explicit _func_box(const Function &f) { ::new ((void *)&buf) Function(f); }
+        _func_box(const _func_box &x) { ::new ((void *)&buf) Function(x.get()); }
+        // 析构后重新拷贝构造
+        _func_box &operator=(const _func_box &x)
+        {
+            if (this != &x)
+            {
+                get().~Function();
+                ::new ((void *)&buf) Function(x.get());
+            }
+            return *this;
+        }
+        ~_func_box() { get().~Function(); }
+        const Function &get() const { return *reinterpret_cast<const Function *>(&buf); }
+    };
+
+    // 由Derived的++,--,+=,-(距离),==补全其余的运算符,只有用到的才会实例化
+    template <class Derived, class Difference>
+    struct _iterator_ops
+    {
+        friend Derived operator++(Derived &x, int)
+        {
+            Derived tmp = x;
+            ++x;
+            return tmp;
+        }
+        friend Derived operator--(Derived &x, int)
+        {
+            Derived tmp = x;
+            --x;
+            return tmp;
+        }
+        friend bool operator!=(const Derived &a, const Derived &b) { return !(a == b); }
+        friend Derived &operator-=(Derived &x, Difference n) { return x += -n; }
+        friend Derived operator+(Derived x, Difference n) { return x += n; }
+        friend Derived operator+(Difference n, Derived x) { return x += n; }
+        friend Derived operator-(Derived x, Difference n) { return x += -n; }
+        friend bool operator<(const Derived &a, const Derived &b) { return a - b < 0; }
+        friend bool operator>(const Derived &a, const Derived &b) { return b < a; }
+        friend bool operator<=(const Derived &a, const Derived &b) { return !(b < a); }
+        friend bool operator>=(const Derived &a, const Derived &b) { return !(a < b); }
+    };
+
+    // it向后移动n个位置,但不越过last
+    template <class Iterator, class Distance>
+    inline Iterator _bounded_next(Iterator it, Distance n, Iterator last, input_iterator_tag)
+    {
+        for (; n > 0 && it != last; --n)
+        {
+            ++it;
+        }
+        return it;
+    }
+
+    template <class Iterator, class Distance>
+    inline Iterator _bounded_next(Iterator it, Distance n, Iterator last, random_access_iterator_tag)
+    {
+        return it + lp::min(static_cast<_iter_difference<Iterator>>(n), last - it);
+    }
+
+    template <class Iterator, class Distance>
+    inline Iterator _bounded_next(Iterator it, Distance n, Iterator last)
+    {
+        return _bounded_next(it, n, last, _iter_category<Iterator>());
+    }
+    // endregion
+
+    // region:subrange
+    // 一对迭代器表示的区间,所有视图都是subrange
+    template <class Iterator>
+    class subrange
+    {
+    private:
+        Iterator first;
+        Iterator last;
+
+    public:
+        using iterator = Iterator;
+        using value_type = _iter_value<Iterator>;
+        using difference_type = _iter_difference<Iterator>;
+
+        subrange(Iterator first, Iterator last) : first(first), last(last) {}
+        Iterator begin() const { return first; }
+        Iterator end() const { return last; }
+        bool empty() const { return first == last; }
+        // 随机访问迭代器为O(1),否则遍历一次
+        difference_type size() const { return lp::distance(first, last); }
+    };
+
+    template <class T>
+    struct _is_subrange : std::false_type
+    {
+    };
+
+    template <class Iterator>
+    struct _is_subrange<subrange<Iterator>> : std::true_type
+    {
+    };
+    // endregion
+
+    // region:filter_iterator
+    // 只经过满足pred的元素;最多是前向迭代器
+    template <class Iterator, class Predicate>
+    class filter_iterator
+        : public iterator<typename _weaker_category<forward_iterator_tag, _iter_category<Iterator>>::type,
+                          _iter_value<Iterator>, _iter_difference<Iterator>,
+                          typename iterator_traits<Iterator>::pointer, _iter_reference<Iterator>>,
+          public _iterator_ops<filter_iterator<Iterator, Predicate>, _iter_difference<Iterator>>
+    {
+    private:
+        Iterator cur;
+        Iterator last;
+        _func_box<Predicate> pred;
+
+        // cur移到第一个满足pred的元素
+        void satisfy()
+        {
+            while (cur != last && !pred.get()(*cur))
+            {
+                ++cur;
+            }
+        }
+
+    public:
+        filter_iterator(Iterator first, Iterator last, const Predicate &pred) : cur(first), last(last), pred(pred)
+        {
+            satisfy();
+        }
+        _iter_reference<Iterator> operator*() const { return *cur; }
+        filter_iterator &operator++()
+        {
+            ++cur;
+            satisfy();
+            return *this;
+        }
+        bool operator==(const filter_iterator &x) const { return cur == x.cur; }
+        Iterator base() const { return cur; }
+    };
+    // endregion
+
+    // region:transform_iterator
+    // *it为f(*base),是一个值而不是引用(除非f返回引用)
+    template <class Iterator, class Function>
+    using _transform_reference = decltype(std::declval<const Function &>()(std::declval<_iter_reference<Iterator>>()));
+
+    template <class Iterator, class Function>
+    class transform_iterator
+        : public iterator<_adapted_category<Iterator>, typename std::decay<_transform_reference<Iterator, Function>>::type,
+                          _iter_difference<Iterator>, void, _transform_reference<Iterator, Function>>,
+          public _iterator_ops<transform_iterator<Iterator, Function>, _iter_difference<Iterator>>
+    {
+    public:
+        using difference_type = _iter_difference<Iterator>;
+        using reference = _transform_reference<Iterator, Function>;
+
+    private:
+        Iterator cur;
+        _func_box<Function> f;
+
+    public:
+        transform_iterator(Iterator it, const Function &f) : cur(it), f(f) {}
+        reference operator*() const { return f.get()(*cur); }
+        reference operator[](difference_type n) const { return f.get()(cur[n]); }
+        transform_iterator &operator++()
+        {
+            ++cur;
+            return *this;
+        }
+        transform_iterator &operator--()
+        {
+            --cur;
+            return *this;
+        }
+        transform_iterator &operator+=(difference_type n)
+        {
+            cur += n;
+            return *this;
+        }
+        difference_type operator-(const transform_iterator &x) const { return cur - x.cur; }
+        bool operator==(const transform_iterator &x) const { return cur == x.cur; }
+        Iterator base() const { return cur; }
+    };
+    // endregion
+
+    // region:take_iterator
+    // 记录还剩下的个数,个数为0或底层迭代器到达末尾时就到了视图的末尾
+    // 随机访问时视图的首尾个数是精确的,两个迭代器的距离就是个数之差
+    template <class Iterator>
+    class take_iterator
+        : public iterator<_adapted_category<Iterator>, _iter_value<Iterator>, _iter_difference<Iterator>,
+                          typename iterator_traits<Iterator>::pointer, _iter_reference<Iterator>>,
+          public _iterator_ops<take_iterator<Iterator>, _iter_difference<Iterator>>
+    {
+    public:
+        using difference_type = _iter_difference<Iterator>;
+
+    private:
+        Iterator cur;
+        difference_type remaining;
+
+    public:
+        take_iterator(Iterator it, difference_type remaining) : cur(it), remaining(remaining) {}
+        _iter_reference<Iterator> operator*() const { return *cur; }
+        _iter_reference<Iterator> operator[](difference_type n) const { return cur[n]; }
+        take_iterator &operator++()
+        {
+            ++cur;
+            --remaining;
+            return *this;
+        }
+        take_iterator &operator--()
+        {
+            --cur;
+            ++remaining;
+            return *this;
+        }
+        take_iterator &operator+=(difference_type n)
+        {
+            cur += n;
+            remaining -= n;
+            return *this;
+        }
+        difference_type operator-(const take_iterator &x) const { return x.remaining - remaining; }
+        bool operator==(const take_iterator &x) const { return remaining == x.remaining || cur == x.cur; }
+        Iterator base() const { return cur; }
+    };
+    // endregion
+
+    // region:zip_iterator
+    // *it为两个引用组成的std::pair,任一个底层迭代器到达末尾就到了视图的末尾
+    template <class Iterator1, class Iterator2>
+    class zip_iterator
+        : public iterator<typename _weaker_category<_adapted_category<Iterator1>, _adapted_category<Iterator2>>::type,
+                          std::pair<_iter_value<Iterator1>, _iter_value<Iterator2>>, _iter_difference<Iterator1>, void,
+                          std::pair<_iter_reference<Iterator1>, _iter_reference<Iterator2>>>,
+          public _iterator_ops<zip_iterator<Iterator1, Iterator2>, _iter_difference<Iterator1>>
+    {
+    public:
+        using difference_type = _iter_difference<Iterator1>;
+        using reference = std::pair<_iter_reference<Iterator1>, _iter_reference<Iterator2>>;
+
+    private:
+        Iterator1 cur1;
+        Iterator2 cur2;
+
+    public:
+        zip_iterator(Iterator1 it1, Iterator2 it2) : cur1(it1), cur2(it2) {}
+        reference operator*() const { return reference(*cur1, *cur2); }
+        reference operator[](difference_type n) const { return reference(cur1[n], cur2[n]); }
+        zip_iterator &operator++()
+        {
+            ++cur1;
+            ++cur2;
+            return *this;
+        }
+        zip_iterator &operator--()
+        {
+            --cur1;
+            --cur2;
+            return *this;
+        }
+        zip_iterator &operator+=(difference_type n)
+        {
+            cur1 += n;
+            cur2 += n;
+            return *this;
+        }
+        difference_type operator-(const zip_iterator &x) const { return cur1 - x.cur1; }
+        bool operator==(const zip_iterator &x) const { return cur1 == x.cur1 || cur2 == x.cur2; }
+        Iterator1 base1() const { return cur1; }
+        Iterator2 base2() const { return cur2; }
+    };
+    // endregion
+
+    // region:chunk_iterator
+    // *it为下一段最多n个元素组成的subrange;最多是前向迭代器
+    template <class Iterator>
+    class chunk_iterator
+        : public iterator<typename _weaker_category<forward_iterator_tag, _iter_category<Iterator>>::type,
+                          subrange<Iterator>, _iter_difference<Iterator>, void, subrange<Iterator>>,
+          public _iterator_ops<chunk_iterator<Iterator>, _iter_difference<Iterator>>
+    {
+    public:
+        using difference_type = _iter_difference<Iterator>;
+
+    private:
+        Iterator cur;
+        Iterator next; // 当前一段的末尾
+        Iterator last;
+        difference_type n;
+
+    public:
+        chunk_iterator(Iterator first, Iterator last, difference_type n)
+            : cur(first), next(_bounded_next(first, n, last)), last(last), n(n) {}
+        subrange<Iterator> operator*() const { return subrange<Iterator>(cur, next); }
+        chunk_iterator &operator++()
+        {
+            cur = next;
+            next = _bounded_next(cur, n, last);
+            return *this;
+        }
+        bool operator==(const chunk_iterator &x) const { return cur == x.cur; }
+        Iterator base() const { return cur; }
+    };
+    // endregion
+
+    namespace views
+    {
+        // region:视图
+        // 区间r的迭代器类型,左值容器为非const的iterator,const容器为const_iterator
+        template <class Range>
+        using _iter_of = decltype(std::declval<Range &>().begin());
+
+        // 左值容器或视图转换成subrange
+        template <class Range>
+        inline subrange<_iter_of<Range>> all(Range &&r)
+        {
+            static_assert(std::is_lvalue_reference<Range>::value || _is_subrange<typename std::decay<Range>::type>::value,
+                          "lp::views: a temporary container would dangle, bind it to a variable first");
+            return subrange<_iter_of<Range>>(r.begin(), r.end());
+        }
+
+        template <class Range, class Predicate>
+        inline subrange<filter_iterator<_iter_of<Range>, Predicate>> filter(Range &&r, Predicate pred)
+        {
+            using It = filter_iterator<_iter_of<Range>, Predicate>;
+            subrange<_iter_of<Range>> s = views::all(std::forward<Range>(r));
+            return subrange<It>(It(s.begin(), s.end(), pred), It(s.end(), s.end(), pred));
+        }
+
+        template <class Range, class Function>
+        inline subrange<transform_iterator<_iter_of<Range>, Function>> transform(Range &&r, Function f)
+        {
+            using It = transform_iterator<_iter_of<Range>, Function>;
+            subrange<_iter_of<Range>> s = views::all(std::forward<Range>(r));
+            return subrange<It>(It(s.begin(), f), It(s.end(), f));
+        }
+
+        // 随机访问时把个数截到区间长度,首尾迭代器都精确,其他情况尾迭代器为(末尾,0)
+        template <class Iterator>
+        inline subrange<take_iterator<Iterator>> _take(Iterator first, Iterator last, _iter_difference<Iterator> n, input_iterator_tag)
+        {
+            return subrange<take_iterator<Iterator>>(take_iterator<Iterator>(first, n), take_iterator<Iterator>(last, 0));
+        }
+
+        template <class Iterator>
+        inline subrange<take_iterator<Iterator>> _take(Iterator first, Iterator last, _iter_difference<Iterator> n,
+                                                       random_access_iterator_tag)
+        {
+            n = lp::min(n, last - first);
+            return subrange<take_iterator<Iterator>>(take_iterator<Iterator>(first, n), take_iterator<Iterator>(first + n, 0));
+        }
+
+        template <class Range>
+        inline subrange<take_iterator<_iter_of<Range>>> take(Range &&r, size_t n)
+        {
+            using It = _iter_of<Range>;
+            subrange<It> s = views::all(std::forward<Range>(r));
+            return _take(s.begin(), s.end(), static_cast<_iter_difference<It>>(n), _iter_category<It>());
+        }
+
+        // 两个都是随机访问时把长度截到较短的一个,尾迭代器精确
+        template <class Iterator1, class Iterator2>
+        inline subrange<zip_iterator<Iterator1, Iterator2>> _zip(Iterator1 first1, Iterator1 last1, Iterator2 first2,
+                                                                 Iterator2 last2, input_iterator_tag)
+        {
+            using It = zip_iterator<Iterator1, Iterator2>;
+            return subrange<It>(It(first1, first2), It(last1, last2));
+        }
+
+        template <class Iterator1, class Iterator2>
+        inline subrange<zip_iterator<Iterator1, Iterator2>> _zip(Iterator1 first1, Iterator1 last1, Iterator2 first2,
+                                                                 Iterator2 last2, random_access_iterator_tag)
+        {
+            using It = zip_iterator<Iterator1, Iterator2>;
+            const _iter_difference<Iterator1> n = lp::min(last1 - first1, static_cast<_iter_difference<Iterator1>>(last2 - first2));
+            return subrange<It>(It(first1, first2), It(first1 + n, first2 + n));
+        }
+
+        template <class Range1, class Range2>
+        inline subrange<zip_iterator<_iter_of<Range1>, _iter_of<Range2>>> zip(Range1 &&r1, Range2 &&r2)
+        {
+            using It1 = _iter_of<Range1>;
+            using It2 = _iter_of<Range2>;
+            subrange<It1> s1 = views::all(std::forward<Range1>(r1));
+            subrange<It2> s2 = views::all(std::forward<Range2>(r2));
+            return _zip(s1.begin(), s1.end(), s2.begin(), s2.end(),
+                        typename _weaker_category<_adapted_category<It1>, _adapted_category<It2>>::type());
+        }
+
+        // 每n个元素一段,最后一段可能不足n个;n必须大于0
+        template <class Range>
+        inline subrange<chunk_iterator<_iter_of<Range>>> chunk(Range &&r, size_t n)
+        {
+            using It = _iter_of<Range>;
+            static_assert(is_forward_iterator<It>::value, "lp::views::chunk needs a forward range");
+            subrange<It> s = views::all(std::forward<Range>(r));
+            const _iter_difference<It> len = static_cast<_iter_difference<It>>(n);
+            return subrange<chunk_iterator<It>>(chunk_iterator<It>(s.begin(), s.end(), len),
+                                                chunk_iterator<It>(s.end(), s.end(), len));
+        }
+        // endregion
+
+        // region:物化
+        template <class Container, class = void>
+        struct _has_reserve : std::false_type
+        {
+        };
+
+        template <class Container>
+        struct _has_reserve<Container, decltype((void)std::declval<Container &>().reserve(size_t()))> : std::true_type
+        {
+        };
+
+        // 能以(n, lp::default_init)构造且元素可以不初始化:一次分配后直接复制
+        template <class Container, class Iterator>
+        struct _is_presize_copyable
+            : std::integral_constant<bool, is_random_access_iterator<Iterator>::value &&
+                                               std::is_constructible<Container, size_t, default_init_t>::value &&
+                                               std::is_trivially_default_constructible<typename Container::value_type>::value>
+        {
+        };
+
+        template <class Container, class Iterator>
+        inline void _reserve(Container &c, Iterator first, Iterator last, std::true_type)
+        {
+            c.reserve(static_cast<size_t>(lp::distance(first, last)));
+        }
+
+        template <class Container, class Iterator>
+        inline void _reserve(Container &, Iterator, Iterator, std::false_type)
+        {
+        }
+
+        template <class Container, class Iterator>
+        inline Container _to(Iterator first, Iterator last, std::true_type)
+        {
+            Container c(static_cast<size_t>(lp::distance(first, last)), default_init);
+            lp::copy(first, last, c.begin());
+            return c;
+        }
+
+        // 随机访问且容器有reserve时先reserve,然后逐个emplace_back
+        template <class Container, class Iterator>
+        inline Container _to(Iterator first, Iterator last, std::false_type)
+        {
+            Container c;
+            _reserve(c, first, last,
+                     std::integral_constant<bool, is_random_access_iterator<Iterator>::value && _has_reserve<Container>::value>());
+            for (; first != last; ++first)
+            {
+                c.emplace_back(*first);
+            }
+            return c;
+        }
+
+        // 把区间r的元素复制到一个新的Container中,这是视图唯一一次遍历底层数据的地方
+        template <class Container, class Range>
+        inline Container to(Range &&r)
+        {
+            using It = _iter_of<Range>;
+            subrange<It> s = views::all(std::forward<Range>(r));
+            return _to<Container>(s.begin(), s.end(), _is_presize_copyable<Container, It>());
+        }
+        // endregion
+
+        // region:管道写法
+        // r | views::filter(pred)等价于views::filter(r, pred),Fn把参数转发给对应的函数
+        template <class Fn, class Arg>
+        struct _closure
+        {
+            Arg arg;
+        };
+
+        template <class Range, class Fn, class Arg>
+        inline auto operator|(Range &&r, const _closure<Fn, Arg> &c) -> decltype(Fn()(std::forward<Range>(r), c.arg))
+        {
+            return Fn()(std::forward<Range>(r), c.arg);
+        }
+
+        struct _filter_fn
+        {
+            template <class Range, class Predicate>
+            auto operator()(Range &&r, const Predicate &pred) const -> decltype(views::filter(std::forward<Range>(r), pred))
+            {
+                return views::filter(std::forward<Range>(r), pred);
+            }
+        };
+
+        struct _transform_fn
+        {
+            template <class Range, class Function>
+            auto operator()(Range &&r, const Function &f) const -> decltype(views::transform(std::forward<Range>(r), f))
+            {
+                return views::transform(std::forward<Range>(r), f);
+            }
+        };
+
+        struct _take_fn
+        {
+            template <class Range>
+            auto operator()(Range &&r, size_t n) const -> decltype(views::take(std::forward<Range>(r), n))
+            {
+                return views::take(std::forward<Range>(r), n);
+            }
+        };
+
+        struct _chunk_fn
+        {
+            template <class Range>
+            auto operator()(Range &&r, size_t n) const -> decltype(views::chunk(std::forward<Range>(r), n))
+            {
+                return views::chunk(std::forward<Range>(r), n);
+            }
+        };
+
+        template <class Container>
+        struct _to_fn
+        {
+            template <class Range>
+            Container operator()(Range &&r, int) const
+            {
+                return views::to<Container>(std::forward<Range>(r));
+            }
+        };
+
+        template <class Predicate>
+        inline _closure<_filter_fn, Predicate> filter(Predicate pred)
+        {
+            return _closure<_filter_fn, Predicate>{pred};
+        }
+
+        template <class Function>
+        inline _closure<_transform_fn, Function> transform(Function f)
+        {
+            return _closure<_transform_fn, Function>{f};
+        }
+
+        inline _closure<_take_fn, size_t> take(size_t n)
+        {
+            return _closure<_take_fn, size_t>{n};
+        }
+
+        inline _closure<_chunk_fn, size_t> chunk(size_t n)
+        {
+            return _closure<_chunk_fn, size_t>{n};
+        }
+
+        template <class Container>
+        inline _closure<_to_fn<Container>, int> to()
+        {
+            return _closure<_to_fn<Container>, int>{0};
+        }
+        // endregion
+    } // namespace views
+} // namespace lp
+
+#endif // LP_VIEWS_H
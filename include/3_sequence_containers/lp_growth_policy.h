@@ -0,0 +1,70 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+vector的增长策略
+备用空间不足时vector向增长策略询问新的容量,策略需提供:
+ * capacity<T, Alloc>(old_cap, min_cap)  当前容量为old_cap,至少需要min_cap(> old_cap)个T时的新容量,不小于min_cap
+可选的策略:
+ * growth_2x        加倍,均摊拷贝次数最少,但大vector最多浪费一半的空间,默认策略
+ * growth_1_5x      增长为1.5倍,浪费的空间最多为三分之一,扩容次数约为加倍的1.7倍;
+                    不是平凡可重定位的元素扩容时新旧空间同时存在,峰值内存也更低
+ * growth_aligned   在Base给出的容量上取整到配置器实际分配的大小:
+                    小区块取整到内存池的规格(simple_alloc::good_size),多出的部分本来就会被浪费;
+                    不小于PageSize字节的区块取整到页,大区块由mmap或大页承载时按页分配
+*/
+#ifndef LP_GROWTH_POLICY_H
+#define LP_GROWTH_POLICY_H
+
+#include <cstddef> //for size_t
+#include "../1_allocator/lp_alloc.h" //for simple_alloc
+
+namespace lp
+{
+    enum
+    {
+        _GROWTH_PAGE_SIZE = 4096 // growth_aligned默认的页大小
+    };
+
+    struct growth_2x
+    {
+        template <class T, class Alloc>
+        static size_t capacity(size_t old_cap, size_t min_cap)
+        {
+            return 2 * old_cap > min_cap ? 2 * old_cap : min_cap;
+        }
+    };
+
+    struct growth_1_5x
+    {
+        template <class T, class Alloc>
+        static size_t capacity(size_t old_cap, size_t min_cap)
+        {
+            const size_t grown = old_cap + old_cap / 2;
+            return grown > min_cap ? grown : min_cap;
+        }
+    };
+
+    template <class Base = growth_1_5x, size_t PageSize = _GROWTH_PAGE_SIZE>
+    struct growth_aligned
+    {
+        template <class T, class Alloc>
+        static size_t capacity(size_t old_cap, size_t min_cap)
+        {
+            const size_t n = Base::template capacity<T, Alloc>(old_cap, min_cap);
+            const size_t bytes = n * sizeof(T);
+            if (bytes < PageSize)
+            {
+                return simple_alloc<T, Alloc>::good_size(n);
+            }
+            // 取整到页后按T的个数向下取整,不会少于n
+            return ((bytes + PageSize - 1) & ~(PageSize - 1)) / sizeof(T);
+        }
+    };
+} // namespace lp
+
+#endif // LP_GROWTH_POLICY_H
@@ -24,7 +24,7 @@ namespace lp
 
     // 迭代器
     template <class T, class Ref, class Ptr>
-    struct _list_iterator : public lp::iterator<T, Ref, Ptr, lp::bidirectional_iterator_tag>
+    struct _list_iterator : public lp::iterator<lp::bidirectional_iterator_tag, T, ptrdiff_t, Ptr, Ref>
     {
         using iterator = _list_iterator<T, T &, T *>;
         using const_iterator = _list_iterator<T, const T &, const T *>;
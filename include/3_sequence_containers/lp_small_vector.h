@@ -0,0 +1,505 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+small_vector:前N个元素放在对象内部的缓冲区,超出后才向Alloc申请空间
+ * 与vector一样由start,finish,end_of_storage三个指针描述,元素在内部缓冲区时start指向该缓冲区,
+   因此begin(),end(),operator[]等与vector完全相同,不需要判断元素在哪里
+ * 容量先为N,之后由增长策略Growth决定;shrink_to_fit在元素不超过N个时搬回内部缓冲区
+ * 移动时只有在堆上的缓冲区可以直接接管,在内部缓冲区的元素要逐个搬动
+ * start可能指向自身,small_vector本身不是平凡可重定位的
+适合元素个数通常很少的场合,例如每个请求的参数表,语法树节点的子节点
+*/
+#ifndef LP_SMALL_VECTOR_H_
+#define LP_SMALL_VECTOR_H_
+#include <cstddef>
+#include <cstring>     //for memcpy
+#include <type_traits> //for std::aligned_storage
+#include <utility>     //for std::move,std::forward
+#include "../1_allocator/lp_memory.h"
+#include "../5_algorithm/lp_algobase.h"
+#include "lp_growth_policy.h"
+
+namespace lp
+{
+    template <class T, size_t N, class Alloc = alloc, class Growth = growth_2x>
+    class small_vector
+    {
+        static_assert(N > 0, "lp::small_vector needs at least one inline element, use lp::vector instead");
+
+    public:
+        using value_type = T;
+        using pointer = value_type *;
+        using iterator = value_type *;
+        using const_iterator = const value_type *;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+        using difference_type = ptrdiff_t;
+        using size_type = size_t;
+
+    protected:
+        using data_allocator = simple_alloc<value_type, Alloc>;
+        using relocatable = std::integral_constant<bool, is_trivially_relocatable<T>::value>;
+
+        iterator start;          // 目前使用空间的头
+        iterator finish;         // 目前使用空间的尾
+        iterator end_of_storage; // 可用空间的结尾
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf[N]; // 内部缓冲区
+
+        iterator inline_storage() { return reinterpret_cast<iterator>(buf); }
+        void reset_inline()
+        {
+            start = finish = inline_storage();
+            end_of_storage = start + N;
+        }
+        // n不超过N时使用内部缓冲区,否则向配置器申请
+        iterator allocate_storage(size_type n) { return n <= N ? inline_storage() : data_allocator::allocate(n); }
+        void deallocate_storage(iterator p, size_type n)
+        {
+            if (p != inline_storage())
+            {
+                data_allocator::deallocate(p, n);
+            }
+        }
+        void deallocate() { deallocate_storage(start, capacity()); }
+        // 备用空间不足以再容纳n个元素时,由增长策略给出新容量
+        size_type next_capacity(size_type n) const
+        {
+            return Growth::template capacity<T, Alloc>(capacity(), size() + n);
+        }
+        // 把容量改为new_cap(不小于size()),元素搬到新空间
+        void reallocate_storage(size_type new_cap, std::true_type);
+        void reallocate_storage(size_type new_cap, std::false_type);
+        void move_to(iterator new_start, size_type new_cap);
+        // 备用空间不足时扩容并在尾端以args构造一个元素
+        template <class... Args>
+        void grow_emplace_back(Args &&...args);
+
+        // 以下两个只用于平凡可重定位的元素,同vector
+        iterator open_gap(iterator pos, size_type n)
+        {
+            lp::uninitialized_relocate(pos, finish, pos + n);
+            finish += n;
+            return pos;
+        }
+        void close_gap(iterator pos, size_type n)
+        {
+            lp::uninitialized_relocate(pos + n, finish, pos);
+            finish -= n;
+        }
+        // 备用空间充足时在position处插入x
+        void spare_insert(iterator position, T &&x, std::true_type)
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type tmp;
+            lp::construct(reinterpret_cast<T *>(&tmp), std::move(x));
+            memcpy((void *)open_gap(position, 1), &tmp, sizeof(T));
+        }
+        void spare_insert(iterator position, T &&x, std::false_type)
+        {
+            lp::construct(finish, std::move(*(finish - 1)));
+            ++finish;
+            lp::move_backward(position, finish - 2, finish - 1);
+            *position = std::move(x);
+        }
+        // 备用空间充足时在pos处插入n个x,x不能是本small_vector中的元素
+        void spare_fill_insert(iterator pos, size_type n, const T &x, std::true_type);
+        void spare_fill_insert(iterator pos, size_type n, const T &x, std::false_type);
+        void erase_aux(iterator first, iterator last, std::true_type)
+        {
+            lp::destroy(first, last);
+            close_gap(first, last - first);
+        }
+        void erase_aux(iterator first, iterator last, std::false_type)
+        {
+            iterator i = lp::move(last, finish, first);
+            lp::destroy(i, finish);
+            finish = i;
+        }
+
+        // 在[first,first+n)上默认初始化(true_type)或值初始化(false_type)
+        static void construct_n(iterator first, size_type n, std::true_type)
+        {
+            lp::uninitialized_default_construct_n(first, n);
+        }
+        static void construct_n(iterator first, size_type n, std::false_type)
+        {
+            lp::uninitialized_value_construct_n(first, n);
+        }
+        // 构造n个元素,DefaultInit同construct_n
+        template <class DefaultInit>
+        void init_n(size_type n, DefaultInit default_init)
+        {
+            start = allocate_storage(n);
+            try
+            {
+                construct_n(start, n, default_init);
+            }
+            catch (...)
+            {
+                deallocate_storage(start, n);
+                throw;
+            }
+            finish = start + n;
+            end_of_storage = start + lp::max(n, static_cast<size_type>(N));
+        }
+        // 在尾端追加n个元素,DefaultInit同construct_n
+        template <class DefaultInit>
+        void append_n(size_type n, DefaultInit default_init)
+        {
+            if (static_cast<size_type>(end_of_storage - finish) < n)
+            {
+                reallocate_storage(next_capacity(n), relocatable());
+            }
+            construct_n(finish, n, default_init);
+            finish += n;
+        }
+        template <class DefaultInit>
+        void resize_n(size_type new_size, DefaultInit default_init)
+        {
+            if (new_size < size())
+            {
+                erase(begin() + new_size, end());
+            }
+            else
+            {
+                append_n(new_size - size(), default_init);
+            }
+        }
+        // 接管或搬走x的元素,*this必须没有元素且在内部缓冲区
+        void steal(small_vector &x);
+
+    public:
+        iterator begin() { return start; }
+        const_iterator begin() const { return start; }
+        iterator end() { return finish; }
+        const_iterator end() const { return finish; }
+        size_type size() const { return static_cast<size_type>(end() - begin()); }
+        size_type capacity() const { return static_cast<size_type>(end_of_storage - begin()); }
+        // 堆上缓冲区占用的字节数,元素在内部缓冲区时为0
+        size_type capacity_bytes() const { return is_inline() ? 0 : capacity() * sizeof(T); }
+        bool empty() const { return begin() == end(); }
+        // 元素是否在内部缓冲区
+        bool is_inline() const { return start == reinterpret_cast<const_iterator>(buf); }
+        reference operator[](size_type n) { return *(begin() + n); }
+        const_reference operator[](size_type n) const { return *(begin() + n); }
+        reference front() { return *begin(); }
+        reference back() { return *(end() - 1); }
+
+        small_vector() { reset_inline(); }
+        explicit small_vector(size_type n)
+        {
+            init_n(n, std::false_type());
+        }
+        // 元素默认初始化,平凡类型的内容不确定
+        small_vector(size_type n, default_init_t)
+        {
+            init_n(n, std::true_type());
+        }
+        small_vector(size_type n, const T &value)
+        {
+            start = allocate_storage(n);
+            try
+            {
+                lp::uninitialized_fill_n(start, n, value);
+            }
+            catch (...)
+            {
+                deallocate_storage(start, n);
+                throw;
+            }
+            finish = start + n;
+            end_of_storage = start + lp::max(n, static_cast<size_type>(N));
+        }
+        small_vector(const small_vector &x)
+        {
+            start = allocate_storage(x.size());
+            try
+            {
+                finish = lp::uninitialized_copy(x.begin(), x.end(), start);
+            }
+            catch (...)
+            {
+                deallocate_storage(start, x.size());
+                throw;
+            }
+            end_of_storage = start + lp::max(x.size(), static_cast<size_type>(N));
+        }
+        // 移动后x为空,在内部缓冲区
+        small_vector(small_vector &&x) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            reset_inline();
+            steal(x);
+        }
+        ~small_vector()
+        {
+            lp::destroy(start, finish);
+            deallocate();
+        }
+        small_vector &operator=(const small_vector &x)
+        {
+            if (&x != this)
+            {
+                clear();
+                reserve(x.size());
+                finish = lp::uninitialized_copy(x.begin(), x.end(), start);
+            }
+            return *this;
+        }
+        small_vector &operator=(small_vector &&x) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if (&x != this)
+            {
+                lp::destroy(start, finish);
+                deallocate();
+                reset_inline();
+                steal(x);
+            }
+            return *this;
+        }
+        void swap(small_vector &x)
+        {
+            small_vector tmp(std::move(x));
+            x = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+        void push_back(const T &x) { emplace_back(x); }
+        void push_back(T &&x) { emplace_back(std::move(x)); }
+        template <class... Args>
+        void emplace_back(Args &&...args)
+        {
+            if (finish != end_of_storage)
+            {
+                lp::construct(finish, std::forward<Args>(args)...);
+                ++finish;
+            }
+            else
+            {
+                grow_emplace_back(std::forward<Args>(args)...);
+            }
+        }
+        // 以args在position处构造元素,返回指向它的迭代器
+        template <class... Args>
+        iterator emplace(iterator position, Args &&...args)
+        {
+            const size_type n = position - begin();
+            if (position == end())
+            {
+                emplace_back(std::forward<Args>(args)...);
+            }
+            else
+            {
+                // 先构造新元素:args可能引用本small_vector中的元素,平移或扩容之后就变了
+                T x_copy(std::forward<Args>(args)...);
+                if (finish == end_of_storage)
+                {
+                    reallocate_storage(next_capacity(1), relocatable());
+                }
+                spare_insert(begin() + n, std::move(x_copy), relocatable());
+            }
+            return begin() + n;
+        }
+        void pop_back()
+        {
+            --finish;
+            lp::destroy(finish);
+        }
+        iterator insert(iterator position, const T &x) { return emplace(position, x); }
+        iterator insert(iterator position, T &&x) { return emplace(position, std::move(x)); }
+        // 插入n个元素x
+        void insert(iterator pos, size_type n, const T &x);
+
+        iterator erase(iterator position)
+        {
+            erase_aux(position, position + 1, relocatable());
+            return position;
+        }
+        iterator erase(iterator first, iterator last)
+        {
+            if (first != last)
+            {
+                erase_aux(first, last, relocatable());
+            }
+            return first;
+        }
+        void resize(size_type new_size, const T &x)
+        {
+            if (new_size < size())
+            {
+                erase(begin() + new_size, end());
+            }
+            else
+            {
+                insert(end(), new_size - size(), x);
+            }
+        }
+        void resize(size_type new_size) { resize_n(new_size, std::false_type()); }
+        void resize(size_type new_size, default_init_t) { resize_n(new_size, std::true_type()); }
+        void clear() { erase(begin(), end()); }
+        // 容量至少为n,按配置器实际分配的大小取整
+        void reserve(size_type n)
+        {
+            if (n > capacity())
+            {
+                reallocate_storage(data_allocator::good_size(n), relocatable());
+            }
+        }
+        // 把容量缩小到size(),不超过N个元素时搬回内部缓冲区
+        void shrink_to_fit()
+        {
+            if (!is_inline() && finish != end_of_storage)
+            {
+                reallocate_storage(size(), relocatable());
+            }
+        }
+    };
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::reallocate_storage(size_type new_cap, std::true_type)
+    {
+        // 堆上的缓冲区换成另一块堆上的缓冲区时交给配置器的reallocate
+        if (!is_inline() && new_cap > N)
+        {
+            const size_type old_size = size();
+            start = data_allocator::reallocate(start, capacity(), new_cap);
+            finish = start + old_size;
+            end_of_storage = start + new_cap;
+        }
+        else
+        {
+            move_to(allocate_storage(new_cap), new_cap);
+        }
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::reallocate_storage(size_type new_cap, std::false_type)
+    {
+        move_to(allocate_storage(new_cap), new_cap);
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::move_to(iterator new_start, size_type new_cap)
+    {
+        iterator new_finish = new_start;
+        try // 平凡可重定位时按位搬动,否则移动构造不抛异常时移动,否则拷贝
+        {
+            new_finish = lp::uninitialized_relocate(start, finish, new_start);
+        }
+        catch (...)
+        {
+            deallocate_storage(new_start, new_cap);
+            throw;
+        }
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + lp::max(new_cap, static_cast<size_type>(N));
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    template <class... Args>
+    void small_vector<T, N, Alloc, Growth>::grow_emplace_back(Args &&...args)
+    {
+        const size_type new_cap = next_capacity(1);
+        const size_type old_size = size();
+        iterator new_start = data_allocator::allocate(new_cap);
+        try
+        {
+            // 先构造新元素:args可能引用本small_vector中的元素,搬走之后就失效了
+            lp::construct(new_start + old_size, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(new_start, new_cap);
+            throw;
+        }
+        try
+        {
+            lp::uninitialized_relocate(start, finish, new_start);
+        }
+        catch (...)
+        {
+            lp::destroy(new_start + old_size);
+            data_allocator::deallocate(new_start, new_cap);
+            throw;
+        }
+        deallocate();
+        start = new_start;
+        finish = new_start + old_size + 1;
+        end_of_storage = new_start + new_cap;
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::steal(small_vector &x)
+    {
+        if (!x.is_inline())
+        {
+            start = x.start;
+            finish = x.finish;
+            end_of_storage = x.end_of_storage;
+        }
+        else
+        {
+            // 内部缓冲区放不下的不会在x的内部缓冲区里,这里一定放得下
+            finish = lp::uninitialized_relocate(x.start, x.finish, start);
+        }
+        x.reset_inline();
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::insert(iterator pos, size_type n, const T &x)
+    {
+        if (n != 0)
+        {
+            const size_type elems_before = pos - start;
+            T x_copy = x; // x可能是本small_vector中的元素,扩容或平移之后就变了
+            if (static_cast<size_type>(end_of_storage - finish) < n)
+            {
+                reallocate_storage(next_capacity(n), relocatable());
+            }
+            spare_fill_insert(start + elems_before, n, x_copy, relocatable());
+        }
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::spare_fill_insert(iterator pos, size_type n, const T &x, std::true_type)
+    {
+        iterator gap = open_gap(pos, n);
+        try
+        {
+            lp::uninitialized_fill_n(gap, n, x);
+        }
+        catch (...)
+        {
+            close_gap(gap, n);
+            throw;
+        }
+    }
+
+    template <class T, size_t N, class Alloc, class Growth>
+    void small_vector<T, N, Alloc, Growth>::spare_fill_insert(iterator pos, size_type n, const T &x, std::false_type)
+    {
+        const size_type elems_after = finish - pos;
+        iterator old_finish = finish;
+        if (elems_after > n)
+        {
+            lp::uninitialized_move(finish - n, finish, finish);
+            finish += n;
+            lp::move_backward(pos, old_finish - n, old_finish);
+            lp::fill(pos, pos + n, x);
+        }
+        else
+        {
+            lp::uninitialized_fill_n(finish, n - elems_after, x);
+            finish += n - elems_after;
+            lp::uninitialized_move(pos, old_finish, finish);
+            finish += elems_after;
+            lp::fill(pos, old_finish, x);
+        }
+    }
+} // namespace lp
+#endif // LP_SMALL_VECTOR_H_
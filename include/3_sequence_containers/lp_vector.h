@@ -7,18 +7,26 @@
 #ifndef LP_VECTOR_H_
 #define LP_VECTOR_H_
 #include <cstddef>
+#include <cstring>   //for memmove
+#include <type_traits>
+#include <utility>   //for std::move,std::forward
 #include "../1_allocator/lp_memory.h"
+#include "../5_algorithm/lp_algobase.h"
+#include "lp_growth_policy.h"
 
 namespace lp
 {
-    template <class T, class Alloc = alloc>
+    // Growth为增长策略,决定备用空间不足时的新容量,见lp_growth_policy.h
+    template <class T, class Alloc = alloc, class Growth = growth_2x>
     class vector
     {
     public:
         using value_type = T;
         using pointer = value_type *;
         using iterator = value_type *;
+        using const_iterator = const value_type *;
         using reference = value_type &;
+        using const_reference = const value_type &;
         using difference_type = ptrdiff_t;
         using size_type = size_t;
 
@@ -28,18 +36,77 @@ namespace lp
         iterator start;          // 目前使用空间的头
         iterator finish;         // 目前使用空间的尾
         iterator end_of_storage; // 可用空间的结尾
-        // 插入一个元素,是push_back()中使用的一个辅助函数
-        void insert_aux(iterator position, const T &x);
+        // 备用空间不足以再容纳n个元素时,由增长策略给出新容量
+        size_type next_capacity(size_type n) const
+        {
+            return Growth::template capacity<T, Alloc>(capacity(), size() + n);
+        }
+        // 以args构造一个元素插入到position处,是push_back(),emplace()中使用的一个辅助函数
+        template <class... Args>
+        void insert_aux(iterator position, Args &&...args);
 
-        // 将first到last之间的元素拷贝到result指向的位置前面
-        // TODO: copy_backward 由算法模块提供
-        iterator copy_backward(iterator first, iterator last, iterator result)
+        // 平凡可重定位的元素(见lp::is_trivially_relocatable)整段按位搬动:
+        // 扩容时直接交给配置器的reallocate,大缓冲区由realloc原地扩展或由内核重新映射页面;
+        // 插入和删除时用memmove平移后面的元素,不必逐个移动和析构
+        using relocatable = std::integral_constant<bool, is_trivially_relocatable<T>::value>;
+        // 备用空间充足时在position处以args构造一个元素
+        template <class... Args>
+        void spare_insert(iterator position, std::true_type, Args &&...args);
+        template <class... Args>
+        void spare_insert(iterator position, std::false_type, Args &&...args);
+        // 备用空间充足时在pos处插入n个x
+        void spare_fill_insert(iterator pos, size_type n, const T &x, std::true_type);
+        void spare_fill_insert(iterator pos, size_type n, const T &x, std::false_type);
+        // 备用空间不足时扩容到new_size并在position处以args构造一个元素
+        template <class... Args>
+        void grow_insert(iterator position, size_type new_size, std::true_type, Args &&...args);
+        template <class... Args>
+        void grow_insert(iterator position, size_type new_size, std::false_type, Args &&...args);
+        // 备用空间不足时扩容到new_size并在pos处插入n个x
+        void grow_fill_insert(iterator pos, size_type n, const T &x, size_type new_size, std::true_type);
+        void grow_fill_insert(iterator pos, size_type n, const T &x, size_type new_size, std::false_type);
+        // 在pos处插入[first,last):输入迭代器逐个插入;前向迭代器先用lp::distance求出个数,至多扩容一次
+        template <class InputIterator>
+        void range_insert(iterator pos, InputIterator first, InputIterator last, input_iterator_tag);
+        template <class ForwardIterator>
+        void range_insert(iterator pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag);
+        // 备用空间充足时在pos处插入[first,last)中的n个元素
+        template <class ForwardIterator>
+        void spare_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n, std::true_type);
+        template <class ForwardIterator>
+        void spare_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n, std::false_type);
+        // 备用空间不足时扩容到new_size并在pos处插入[first,last)中的n个元素
+        template <class ForwardIterator>
+        void grow_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n, size_type new_size, std::true_type);
+        template <class ForwardIterator>
+        void grow_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n, size_type new_size, std::false_type);
+        // reallocate扩容到new_size,并在pos处空出n个未初始化的位置,返回该位置
+        iterator realloc_gap(iterator pos, size_type n, size_type new_size);
+        // 以下两个只用于平凡可重定位的元素
+        // 把[pos,finish)按位后移n个位置,在pos处空出n个未初始化的位置,备用空间必须足够
+        iterator open_gap(iterator pos, size_type n)
         {
-            while (first != last)
-            {
-                *(--result) = *(--last);
-            }
-            return result;
+            lp::uninitialized_relocate(pos, finish, pos + n);
+            finish += n;
+            return pos;
+        }
+        // open_gap的逆操作,[pos,pos+n)必须是未初始化的
+        void close_gap(iterator pos, size_type n)
+        {
+            lp::uninitialized_relocate(pos + n, finish, pos);
+            finish -= n;
+        }
+        // 删除[first,last)
+        void erase_aux(iterator first, iterator last, std::true_type)
+        {
+            lp::destroy(first, last);
+            close_gap(first, last - first);
+        }
+        void erase_aux(iterator first, iterator last, std::false_type)
+        {
+            iterator i = lp::move(last, finish, first);
+            lp::destroy(i, finish);
+            finish = i;
         }
 
         void deallocate()
@@ -53,61 +120,202 @@ namespace lp
         void fill_initialize(size_type n, const T &value)
         {
             iterator result = data_allocator::allocate(n);
-            uninitialized_fill_n(result, n, value);
+            lp::uninitialized_fill_n(result, n, value);
             start = result;
             finish = start + n;
             end_of_storage = finish;
         }
 
+        // 在[first,first+n)上默认初始化(true_type)或值初始化(false_type)
+        static void construct_n(iterator first, size_type n, std::true_type)
+        {
+            lp::uninitialized_default_construct_n(first, n);
+        }
+        static void construct_n(iterator first, size_type n, std::false_type)
+        {
+            lp::uninitialized_value_construct_n(first, n);
+        }
+        // 构造n个元素,DefaultInit同construct_n
+        template <class DefaultInit>
+        void init_n(size_type n, DefaultInit default_init)
+        {
+            start = data_allocator::allocate(n);
+            try
+            {
+                construct_n(start, n, default_init);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(start, n);
+                throw;
+            }
+            finish = start + n;
+            end_of_storage = finish;
+        }
+        // 在尾端追加n个元素,DefaultInit同construct_n
+        template <class DefaultInit>
+        void append_n(size_type n, DefaultInit default_init);
+        template <class DefaultInit>
+        void resize_n(size_type new_size, DefaultInit default_init)
+        {
+            if (new_size < size())
+            {
+                erase(begin() + new_size, end());
+            }
+            else
+            {
+                append_n(new_size - size(), default_init);
+            }
+        }
+        // 把容量改为new_cap(不小于size()),元素搬到新空间
+        void reallocate_storage(size_type new_cap, std::true_type);
+        void reallocate_storage(size_type new_cap, std::false_type);
+
+        // 申请n个元素的空间并拷贝[first,last),返回新空间的头
+        iterator allocate_and_copy(size_type n, const_iterator first, const_iterator last)
+        {
+            iterator result = data_allocator::allocate(n);
+            try
+            {
+                lp::uninitialized_copy(first, last, result);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(result, n);
+                throw;
+            }
+            return result;
+        }
+
     public:
         iterator begin() { return start; }
+        const_iterator begin() const { return start; }
         iterator end() { return finish; }
+        const_iterator end() const { return finish; }
         size_type size() const { return static_cast<size_type>(end() - begin()); }
         size_type capacity() const { return static_cast<size_type>(end_of_storage - begin()); }
+        // 缓冲区占用的字节数
+        size_type capacity_bytes() const { return capacity() * sizeof(T); }
         bool empty() const { return begin() == end(); }
         reference operator[](size_type n) { return *(begin() + n); }
+        const_reference operator[](size_type n) const { return *(begin() + n); }
         reference front() { return *begin(); }
         reference back() { return *(end() - 1); }
 
         vector() : start(nullptr), finish(nullptr), end_of_storage(nullptr) {}
         vector(size_type n, const T &value) { fill_initialize(n, value); }
         // 使用explicit防止误导性的隐式转换
-        explicit vector(size_type n) { fill_initialize(n, T()); }
+        explicit vector(size_type n) { init_n(n, std::false_type()); }
+        // 元素默认初始化,平凡类型的内容不确定,适合随即整体覆盖的缓冲区
+        vector(size_type n, default_init_t) { init_n(n, std::true_type()); }
+        vector(const vector &x)
+        {
+            start = allocate_and_copy(x.size(), x.begin(), x.end());
+            finish = start + x.size();
+            end_of_storage = finish;
+        }
+        // 移动构造只接管x的缓冲区,x变为空vector
+        vector(vector &&x) noexcept : start(x.start), finish(x.finish), end_of_storage(x.end_of_storage)
+        {
+            x.start = x.finish = x.end_of_storage = nullptr;
+        }
         ~vector()
         {
-            destory(start, finish);
+            lp::destroy(start, finish);
             deallocate();
         }
+        vector &operator=(const vector &x);
+        // 配置器没有状态,直接交换缓冲区即可,x析构时释放原来的元素
+        vector &operator=(vector &&x) noexcept
+        {
+            swap(x);
+            return *this;
+        }
+        void swap(vector &x) noexcept
+        {
+            std::swap(start, x.start);
+            std::swap(finish, x.finish);
+            std::swap(end_of_storage, x.end_of_storage);
+        }
 
-        void push_back(const T &x)
+        void push_back(const T &x) { emplace_back(x); }
+        void push_back(T &&x) { emplace_back(std::move(x)); }
+        // 以args直接在尾端构造元素,省去临时对象的拷贝或移动
+        template <class... Args>
+        void emplace_back(Args &&...args)
         {
             if (finish != end_of_storage)
             {
-                construct(finish, x);
+                lp::construct(finish, std::forward<Args>(args)...);
+                ++finish;
+            }
+            else
+            {
+                insert_aux(end(), std::forward<Args>(args)...);
+            }
+        }
+        // 调用者保证size() < capacity()(例如reserve之后),省去容量检查
+        void push_back_unchecked(const T &x) { emplace_back_unchecked(x); }
+        void push_back_unchecked(T &&x) { emplace_back_unchecked(std::move(x)); }
+        template <class... Args>
+        void emplace_back_unchecked(Args &&...args)
+        {
+            lp::construct(finish, std::forward<Args>(args)...);
+            ++finish;
+        }
+        // 以args在position处构造元素,返回指向它的迭代器
+        template <class... Args>
+        iterator emplace(iterator position, Args &&...args)
+        {
+            const size_type n = position - begin();
+            if (finish != end_of_storage && position == end())
+            {
+                lp::construct(finish, std::forward<Args>(args)...);
                 ++finish;
             }
             else
             {
-                insert_aux(end(), x);
+                insert_aux(position, std::forward<Args>(args)...);
             }
+            return begin() + n;
         }
         void pop_back()
         {
             --finish;
-            destory(finish);
+            lp::destroy(finish);
         }
+        iterator insert(iterator position, const T &x) { return emplace(position, x); }
+        iterator insert(iterator position, T &&x) { return emplace(position, std::move(x)); }
         // 插入n个元素x
         void insert(iterator pos, size_type n, const T &x);
+        // 插入[first,last),区间不能是本vector中的元素;整数参数仍匹配上面的insert(pos, n, x)
+        template <class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+        void insert(iterator pos, InputIterator first, InputIterator last)
+        {
+            range_insert(pos, first, last, iterator_category(first));
+        }
+        // 在尾端追加[first,last),同insert(end(), first, last)
+        template <class InputIterator, class = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+        void append(InputIterator first, InputIterator last)
+        {
+            range_insert(end(), first, last, iterator_category(first));
+        }
+        // 在尾端追加p开始的n个元素,平凡可拷贝的T直接整段拷贝
+        void append(const T *p, size_type n) { append(p, p + n); }
 
         iterator erase(iterator position)
         {
-            if (position + 1 != end())
+            erase_aux(position, position + 1, relocatable());
+            return position;
+        }
+        // 删除[first,last)中的元素
+        iterator erase(iterator first, iterator last)
+        {
+            if (first != last)
             {
-                copy(position + 1, finish, position);
+                erase_aux(first, last, relocatable());
             }
-            --finish;
-            destroy(finish);
-            return position;
+            return first;
         }
         void resize(size_type new_size, const T &x)
         {
@@ -120,44 +328,146 @@ namespace lp
                 insert(end(), new_size - size(), x);
             }
         }
-        void resize(size_type new_size) { resize(new_size, T()); }
+        void resize(size_type new_size) { resize_n(new_size, std::false_type()); }
+        // 新增的元素默认初始化
+        void resize(size_type new_size, default_init_t) { resize_n(new_size, std::true_type()); }
         void clear() { erase(begin(), end()); }
+        // 容量至少为n,按配置器实际分配的大小取整;n不大于capacity()时什么也不做
+        void reserve(size_type n)
+        {
+            if (n > capacity())
+            {
+                reallocate_storage(data_allocator::good_size(n), relocatable());
+            }
+        }
+        // 把容量缩小到size(),空vector释放缓冲区
+        void shrink_to_fit()
+        {
+            if (finish != end_of_storage)
+            {
+                reallocate_storage(size(), relocatable());
+            }
+        }
     };
 
-    template <class T, class Alloc>
-    void vector<T, Alloc>::insert_aux(iterator position, const T &x)
+    template <class T, class Alloc, class Growth>
+    vector<T, Alloc, Growth> &vector<T, Alloc, Growth>::operator=(const vector &x)
+    {
+        if (&x != this)
+        {
+            const size_type xlen = x.size();
+            if (xlen > capacity())
+            {
+                iterator tmp = allocate_and_copy(xlen, x.begin(), x.end());
+                lp::destroy(start, finish);
+                deallocate();
+                start = tmp;
+                end_of_storage = start + xlen;
+            }
+            else if (size() >= xlen)
+            {
+                iterator i = lp::copy(x.begin(), x.end(), begin());
+                lp::destroy(i, finish);
+            }
+            else
+            {
+                lp::copy(x.begin(), x.begin() + size(), start);
+                lp::uninitialized_copy(x.begin() + size(), x.end(), finish);
+            }
+            finish = start + xlen;
+        }
+        return *this;
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::insert_aux(iterator position, Args &&...args)
     {
         // 备用空间充足
         if (finish != end_of_storage)
         {
-            construct(finish, *(finish - 1));
-            ++finish;
-            T x_copy = x;
-            copy_backward(position, finish - 2, finish - 1);
-            *position = x_copy;
+            spare_insert(position, relocatable(), std::forward<Args>(args)...);
         }
         else // 备用空间不足
         {
-            const size_type old_size = size();
-            const size_type new_size = old_size == 0 ? 1 : 2 * old_size;
-            iterator new_start = data_allocator::allocate(new_size);
-            iterator new_finish = new_start;
-            try // 把旧内存中的元素搬到新内存
+            grow_insert(position, next_capacity(1), relocatable(), std::forward<Args>(args)...);
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::spare_insert(iterator position, std::true_type, Args &&...args)
+    {
+        // 先在临时空间构造新元素:args可能引用本vector中的元素,构造也可能抛出异常
+        // 之后按位搬进空位,临时对象视为已搬走,不再析构
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T *tmp = reinterpret_cast<T *>(&buf);
+        lp::construct(tmp, std::forward<Args>(args)...);
+        memcpy((void *)open_gap(position, 1), tmp, sizeof(T));
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::spare_insert(iterator position, std::false_type, Args &&...args)
+    {
+        // 先构造新元素:args可能引用本vector中的元素,后移之后就变了
+        T x_copy(std::forward<Args>(args)...);
+        lp::construct(finish, std::move(*(finish - 1)));
+        ++finish;
+        lp::move_backward(position, finish - 2, finish - 1);
+        *position = std::move(x_copy);
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::grow_insert(iterator position, size_type new_size, std::true_type, Args &&...args)
+    {
+        // args可能引用本vector中的元素,reallocate之后就失效了,先在临时空间构造
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buf;
+        T *tmp = reinterpret_cast<T *>(&buf);
+        lp::construct(tmp, std::forward<Args>(args)...);
+        memcpy((void *)realloc_gap(position, 1, new_size), tmp, sizeof(T));
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class... Args>
+    void vector<T, Alloc, Growth>::grow_insert(iterator position, size_type new_size, std::false_type, Args &&...args)
+    {
+        const size_type elems_before = position - start;
+        iterator new_start = data_allocator::allocate(new_size);
+        iterator new_finish = new_start;
+        try
+        {
+            // 先构造新元素:args可能引用本vector中的元素,搬走之后就失效了
+            lp::construct(new_start + elems_before, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(new_start, new_size);
+            throw;
+        }
+        try // 把旧内存中的元素搬到新内存,移动构造不抛异常时移动,否则拷贝
+        {
+            new_finish = lp::uninitialized_move_if_noexcept(begin(), position, new_start);
+            ++new_finish;
+            new_finish = lp::uninitialized_move_if_noexcept(position, finish, new_finish);
+        }
+        catch (...)
+        {
+            // 出错的那一段已自行销毁;第一段就出错时只剩新元素
+            if (new_finish == new_start)
             {
-                new_finish = uninitialized_copy(begin(), position, new_start);
-                construct(new_finish, x);
-                new_finish++;
-                new_finish = uninitialized_copy(position, finish, new_finish);
+                lp::destroy(new_start + elems_before);
             }
-            catch (...)
+            else
             {
-                destory(new_start, new_finish);
-                data_allocator::deallocate(new_start, new_size);
-                throw;
+                lp::destroy(new_start, new_finish);
             }
+            data_allocator::deallocate(new_start, new_size);
+            throw;
         }
         // 释放旧空间
-        destory(begin(), end());
+        lp::destroy(begin(), end());
         deallocate();
         // 更新指针
         start = new_start;
@@ -165,62 +475,318 @@ namespace lp
         end_of_storage = new_start + new_size;
     }
 
-    template <class T, class Alloc>
-    void vector<T, Alloc>::insert(iterator pos, size_type n, const T &x)
+    template <class T, class Alloc, class Growth>
+    typename vector<T, Alloc, Growth>::iterator vector<T, Alloc, Growth>::realloc_gap(iterator pos, size_type n, size_type new_size)
+    {
+        const size_type elems_before = pos - start;
+        reallocate_storage(new_size, std::true_type());
+        return open_gap(start + elems_before, n);
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::reallocate_storage(size_type new_cap, std::true_type)
+    {
+        const size_type old_size = size();
+        start = data_allocator::reallocate(start, capacity(), new_cap);
+        finish = start + old_size;
+        end_of_storage = start + new_cap;
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::reallocate_storage(size_type new_cap, std::false_type)
+    {
+        iterator new_start = data_allocator::allocate(new_cap);
+        iterator new_finish = new_start;
+        try // 移动构造不抛异常时移动,否则拷贝
+        {
+            new_finish = lp::uninitialized_move_if_noexcept(start, finish, new_start);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(new_start, new_cap);
+            throw;
+        }
+        lp::destroy(start, finish);
+        deallocate();
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + new_cap;
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class DefaultInit>
+    void vector<T, Alloc, Growth>::append_n(size_type n, DefaultInit default_init)
+    {
+        if (static_cast<size_type>(end_of_storage - finish) < n)
+        {
+            reallocate_storage(next_capacity(n), relocatable());
+        }
+        // 构造失败时uninitialized_*已销毁构造了一半的元素,finish不变
+        construct_n(finish, n, default_init);
+        finish += n;
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::insert(iterator pos, size_type n, const T &x)
     {
         if (n != 0)
         {
             if (static_cast<size_type>(end_of_storage - finish) >= n)
             {
                 // 备用空间大于新增元素个数
-                T x_copy = x;
-                // 计算插入点之后的现有元素个数
-                const size_type elems_after = finish - pos;
-                iterator old_finish = finish;
-                if (elems_after > n)
-                {
-                    uninitialized_copy(finish - n, finish, finish);
-                    finish += n;
-                    copy_backward(position, old_finish - n, old_finish);
-                    fill(pos, pos + n, x_copy);
-                }
-                else
-                {
-                    uninitialized_fill_n(finish, n - elems_after, x_copy);
-                    finish += n - elems_after;
-                    uninitialized_copy(pos, old_finish, finish);
-                    finish += elems_after;
-                    fill(pos, old_finish, x_copy);
-                }
+                spare_fill_insert(pos, n, x, relocatable());
+            }
+            else
+            {
+                // 备用空间不足，需要分配新空间
+                grow_fill_insert(pos, n, x, next_capacity(n), relocatable());
             }
         }
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::spare_fill_insert(iterator pos, size_type n, const T &x, std::true_type)
+    {
+        T x_copy = x; // x可能是本vector中的元素,平移之后就变了
+        iterator gap = open_gap(pos, n);
+        try
+        {
+            lp::uninitialized_fill_n(gap, n, x_copy);
+        }
+        catch (...)
+        {
+            // uninitialized_fill_n已销毁构造了一半的元素,把后面的元素移回原位
+            close_gap(gap, n);
+            throw;
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::spare_fill_insert(iterator pos, size_type n, const T &x, std::false_type)
+    {
+        T x_copy = x;
+        // 计算插入点之后的现有元素个数
+        const size_type elems_after = finish - pos;
+        iterator old_finish = finish;
+        if (elems_after > n)
+        {
+            lp::uninitialized_move(finish - n, finish, finish);
+            finish += n;
+            lp::move_backward(pos, old_finish - n, old_finish);
+            lp::fill(pos, pos + n, x_copy);
+        }
         else
         {
-            // 备用空间不足，需要分配新空间
-            const size_type old_size = size();
-            const size_type new_size = old_size + max(old_size, n);
-            iterator new_start = data_allocator::allocate(new_size);
-            iterator new_finish = new_start;
-            try
+            lp::uninitialized_fill_n(finish, n - elems_after, x_copy);
+            finish += n - elems_after;
+            lp::uninitialized_move(pos, old_finish, finish);
+            finish += elems_after;
+            lp::fill(pos, old_finish, x_copy);
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::grow_fill_insert(iterator pos, size_type n, const T &x, size_type new_size, std::true_type)
+    {
+        T x_copy = x; // x可能是本vector中的元素,reallocate之后就失效了
+        iterator gap = realloc_gap(pos, n, new_size);
+        try
+        {
+            lp::uninitialized_fill_n(gap, n, x_copy);
+        }
+        catch (...)
+        {
+            close_gap(gap, n);
+            throw;
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    void vector<T, Alloc, Growth>::grow_fill_insert(iterator pos, size_type n, const T &x, size_type new_size, std::false_type)
+    {
+        const size_type elems_before = pos - start;
+        iterator new_start = data_allocator::allocate(new_size);
+        iterator new_finish = new_start;
+        try
+        {
+            // 先填充新元素:x可能是本vector中的元素,搬走之后就失效了
+            lp::uninitialized_fill_n(new_start + elems_before, n, x);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(new_start, new_size);
+            throw;
+        }
+        try // 移动构造不抛异常时移动,否则拷贝
+        {
+            new_finish = lp::uninitialized_move_if_noexcept(begin(), pos, new_start);
+            new_finish += n;
+            new_finish = lp::uninitialized_move_if_noexcept(pos, finish, new_finish);
+        }
+        catch (...)
+        {
+            // 出错的那一段已自行销毁;第一段就出错时只剩新元素
+            if (new_finish == new_start)
             {
-                new_finish = uninitialized_copy(begin(), pos, new_start);
-                new_finish = uninitialized_fill_n(new_finish, n, x);
-                new_finish = uninitialized_copy(pos, finish, new_finish);
+                lp::destroy(new_start + elems_before, new_start + elems_before + n);
             }
-            catch (...)
+            else
             {
-                destory(new_start, new_finish);
-                data_allocator::deallocate(new_start, new_size);
-                throw;
+                lp::destroy(new_start, new_finish);
+            }
+            data_allocator::deallocate(new_start, new_size);
+            throw;
+        }
+        // 释放旧空间
+        lp::destroy(begin(), finish);
+        deallocate();
+        // 更新指针
+        start = new_start;
+        finish = new_finish;
+        end_of_storage = new_start + new_size;
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class InputIterator>
+    void vector<T, Alloc, Growth>::range_insert(iterator pos, InputIterator first, InputIterator last, input_iterator_tag)
+    {
+        // 个数未知,只能逐个插入
+        for (; first != last; ++first)
+        {
+            pos = emplace(pos, *first) + 1;
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class ForwardIterator>
+    void vector<T, Alloc, Growth>::range_insert(iterator pos, ForwardIterator first, ForwardIterator last, forward_iterator_tag)
+    {
+        const size_type n = static_cast<size_type>(lp::distance(first, last));
+        if (n != 0)
+        {
+            if (static_cast<size_type>(end_of_storage - finish) >= n)
+            {
+                spare_range_insert(pos, first, last, n, relocatable());
+            }
+            else
+            {
+                grow_range_insert(pos, first, last, n, next_capacity(n), relocatable());
             }
         }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class ForwardIterator>
+    void vector<T, Alloc, Growth>::spare_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n,
+                                                      std::true_type)
+    {
+        iterator gap = open_gap(pos, n);
+        try
+        {
+            lp::uninitialized_copy(first, last, gap);
+        }
+        catch (...)
+        {
+            // uninitialized_copy已销毁构造了一半的元素,把后面的元素移回原位
+            close_gap(gap, n);
+            throw;
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class ForwardIterator>
+    void vector<T, Alloc, Growth>::spare_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n,
+                                                      std::false_type)
+    {
+        // 计算插入点之后的现有元素个数
+        const size_type elems_after = finish - pos;
+        iterator old_finish = finish;
+        if (elems_after > n)
+        {
+            lp::uninitialized_move(finish - n, finish, finish);
+            finish += n;
+            lp::move_backward(pos, old_finish - n, old_finish);
+            lp::copy(first, last, pos);
+        }
+        else
+        {
+            ForwardIterator mid = first;
+            lp::advance(mid, elems_after);
+            lp::uninitialized_copy(mid, last, finish);
+            finish += n - elems_after;
+            lp::uninitialized_move(pos, old_finish, finish);
+            finish += elems_after;
+            lp::copy(first, mid, pos);
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class ForwardIterator>
+    void vector<T, Alloc, Growth>::grow_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n,
+                                                     size_type new_size, std::true_type)
+    {
+        iterator gap = realloc_gap(pos, n, new_size);
+        try
+        {
+            lp::uninitialized_copy(first, last, gap);
+        }
+        catch (...)
+        {
+            close_gap(gap, n);
+            throw;
+        }
+    }
+
+    template <class T, class Alloc, class Growth>
+    template <class ForwardIterator>
+    void vector<T, Alloc, Growth>::grow_range_insert(iterator pos, ForwardIterator first, ForwardIterator last, size_type n,
+                                                     size_type new_size, std::false_type)
+    {
+        const size_type elems_before = pos - start;
+        iterator new_start = data_allocator::allocate(new_size);
+        iterator new_finish = new_start;
+        try
+        {
+            lp::uninitialized_copy(first, last, new_start + elems_before);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(new_start, new_size);
+            throw;
+        }
+        try // 移动构造不抛异常时移动,否则拷贝
+        {
+            new_finish = lp::uninitialized_move_if_noexcept(begin(), pos, new_start);
+            new_finish += n;
+            new_finish = lp::uninitialized_move_if_noexcept(pos, finish, new_finish);
+        }
+        catch (...)
+        {
+            // 出错的那一段已自行销毁;第一段就出错时只剩新元素
+            if (new_finish == new_start)
+            {
+                lp::destroy(new_start + elems_before, new_start + elems_before + n);
+            }
+            else
+            {
+                lp::destroy(new_start, new_finish);
+            }
+            data_allocator::deallocate(new_start, new_size);
+            throw;
+        }
         // 释放旧空间
-        destory(begin(), finish);
+        lp::destroy(begin(), finish);
         deallocate();
         // 更新指针
         start = new_start;
         finish = new_finish;
         end_of_storage = new_start + new_size;
     }
+
+    // vector只保存指向堆上缓冲区的指针,本身可以按位搬动
+    template <class T, class Alloc, class Growth>
+    struct is_trivially_relocatable<vector<T, Alloc, Growth>> : std::true_type
+    {
+    };
 };     // namespace lp
 #endif // LP_VECTOR_H_
\ No newline at end of file
@@ -0,0 +1,445 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+其他算法:for_each,transform,find,find_if,count,count_if,copy_if,mismatch,min_element,max_element,minmax_element,is_sorted
+排序算法(sort,stable_sort,radix_sort)见lp_sort.h
+连续迭代器,元素为算术类型时,查找,计数,mismatch与最值用lp_simd_scan.h的向量内核:
+ * find/count的value须与元素同类型,或两者都是整数
+ * find_if/count_if只对lp::value_eq,lp::value_between等比较谓词向量化
+*/
+#ifndef LP_ALGO_H
+#define LP_ALGO_H
+
+#include <utility> //for std::move,std::pair
+#include "lp_algobase.h"
+#include "lp_sort.h"
+
+namespace lp
+{
+    // region:for_each,transform
+    template <class InputIterator, class Function>
+    inline Function for_each(InputIterator first, InputIterator last, Function f)
+    {
+        for (; first != last; ++first)
+        {
+            f(*first);
+        }
+        return f;
+    }
+
+    // 把op(*i)写入result开始的区间,返回result的尾后位置
+    template <class InputIterator, class OutputIterator, class UnaryOperation>
+    inline OutputIterator transform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            *result = op(*first);
+        }
+        return result;
+    }
+
+    template <class InputIterator1, class InputIterator2, class OutputIterator, class BinaryOperation>
+    inline OutputIterator transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2,
+                                    OutputIterator result, BinaryOperation op)
+    {
+        for (; first1 != last1; ++first1, ++first2, ++result)
+        {
+            *result = op(*first1, *first2);
+        }
+        return result;
+    }
+    // endregion
+
+    // region:向量化的条件
+    // value与元素同类型,或两者都是整数,可以转换为元素类型后向量比较
+    template <class Iterator, class T, bool = _is_simd_scan<Iterator>::value>
+    struct _is_simd_value : std::false_type
+    {
+    };
+
+    template <class E, class T>
+    struct _is_simd_value_type
+        : std::integral_constant<bool, std::is_same<E, T>::value ||
+                                           (std::is_integral<E>::value && std::is_integral<T>::value && !std::is_same<T, bool>::value)>
+    {
+    };
+
+    template <class Iterator, class T>
+    struct _is_simd_value<Iterator, T, true>
+        : _is_simd_value_type<typename std::remove_cv<typename iterator_traits<Iterator>::value_type>::type, T>
+    {
+    };
+
+    // value转换为元素类型E后不变;否则没有元素与之相等,按原样逐个比较
+    template <class E, class T>
+    inline bool _simd_value_fits(const T &value)
+    {
+        return (T)(E)value == value;
+    }
+
+    // 谓词是与元素同类型的比较谓词(_cmp_pred)时为其比较运算,否则为-1
+    template <class Iterator, class Predicate>
+    struct _simd_pred_op : std::integral_constant<int, -1>
+    {
+    };
+
+    template <class Iterator, class T, int Op>
+    struct _simd_pred_op<Iterator, _cmp_pred<T, Op>>
+        : std::integral_constant<int, _is_simd_scan<Iterator>::value &&
+                                              std::is_same<T, typename std::remove_cv<typename iterator_traits<Iterator>::value_type>::type>::value
+                                          ? Op
+                                          : -1>
+    {
+    };
+
+    template <class Iterator, class Predicate>
+    struct _is_simd_pred : std::integral_constant<bool, 0 <= _simd_pred_op<Iterator, Predicate>::value>
+    {
+    };
+    // endregion
+
+    // region:find,find_if
+    template <class InputIterator, class Predicate>
+    inline InputIterator _find_if_dispatch(InputIterator first, InputIterator last, Predicate pred, std::false_type)
+    {
+        for (; first != last; ++first)
+        {
+            if (pred(*first))
+            {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    template <class InputIterator, class Predicate>
+    inline InputIterator _find_if_dispatch(InputIterator first, InputIterator last, Predicate pred, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type;
+        return first + _simd_find<_simd_pred_op<InputIterator, Predicate>::value>((const E *)lp::to_address(first),
+                                                                                   (size_t)(last - first), pred.a, pred.b);
+    }
+
+    // 第一个满足pred的元素,没有时返回last
+    template <class InputIterator, class Predicate>
+    inline InputIterator find_if(InputIterator first, InputIterator last, Predicate pred)
+    {
+        return _find_if_dispatch(first, last, pred, _is_simd_pred<InputIterator, Predicate>());
+    }
+
+    template <class InputIterator, class T>
+    inline InputIterator _find_dispatch(InputIterator first, InputIterator last, const T &value, std::false_type)
+    {
+        for (; first != last; ++first)
+        {
+            if (*first == value)
+            {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    template <class InputIterator, class T>
+    inline InputIterator _find_dispatch(InputIterator first, InputIterator last, const T &value, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type;
+        if (!_simd_value_fits<E>(value))
+        {
+            return _find_dispatch(first, last, value, std::false_type());
+        }
+        return first + _simd_find<_CMP_EQ>((const E *)lp::to_address(first), (size_t)(last - first), (E)value, (E)value);
+    }
+
+    // 第一个等于value的元素,没有时返回last
+    template <class InputIterator, class T>
+    inline InputIterator find(InputIterator first, InputIterator last, const T &value)
+    {
+        return _find_dispatch(first, last, value, _is_simd_value<InputIterator, T>());
+    }
+    // endregion
+
+    // region:count,count_if,copy_if
+    template <class InputIterator, class Predicate>
+    inline typename iterator_traits<InputIterator>::difference_type
+    _count_if_dispatch(InputIterator first, InputIterator last, Predicate pred, std::false_type)
+    {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first)
+        {
+            if (pred(*first))
+            {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    template <class InputIterator, class Predicate>
+    inline typename iterator_traits<InputIterator>::difference_type
+    _count_if_dispatch(InputIterator first, InputIterator last, Predicate pred, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type;
+        return _simd_count<_simd_pred_op<InputIterator, Predicate>::value>((const E *)lp::to_address(first),
+                                                                            (size_t)(last - first), pred.a, pred.b);
+    }
+
+    template <class InputIterator, class Predicate>
+    inline typename iterator_traits<InputIterator>::difference_type
+    count_if(InputIterator first, InputIterator last, Predicate pred)
+    {
+        return _count_if_dispatch(first, last, pred, _is_simd_pred<InputIterator, Predicate>());
+    }
+
+    template <class InputIterator, class T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    _count_dispatch(InputIterator first, InputIterator last, const T &value, std::false_type)
+    {
+        typename iterator_traits<InputIterator>::difference_type n = 0;
+        for (; first != last; ++first)
+        {
+            if (*first == value)
+            {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    template <class InputIterator, class T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    _count_dispatch(InputIterator first, InputIterator last, const T &value, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type;
+        if (!_simd_value_fits<E>(value))
+        {
+            return _count_dispatch(first, last, value, std::false_type());
+        }
+        return _simd_count<_CMP_EQ>((const E *)lp::to_address(first), (size_t)(last - first), (E)value, (E)value);
+    }
+
+    template <class InputIterator, class T>
+    inline typename iterator_traits<InputIterator>::difference_type
+    count(InputIterator first, InputIterator last, const T &value)
+    {
+        return _count_dispatch(first, last, value, _is_simd_value<InputIterator, T>());
+    }
+
+    // 把满足pred的元素依次复制到result开始的区间,返回result的尾后位置
+    template <class InputIterator, class OutputIterator, class Predicate>
+    inline OutputIterator copy_if(InputIterator first, InputIterator last, OutputIterator result, Predicate pred)
+    {
+        for (; first != last; ++first)
+        {
+            if (pred(*first))
+            {
+                *result = *first;
+                ++result;
+            }
+        }
+        return result;
+    }
+    // endregion
+
+    // region:mismatch
+    template <class InputIterator1, class InputIterator2>
+    inline std::pair<InputIterator1, InputIterator2>
+    _mismatch_dispatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type)
+    {
+        for (; first1 != last1 && *first1 == *first2; ++first1, ++first2)
+        {
+        }
+        return std::pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline std::pair<InputIterator1, InputIterator2>
+    _mismatch_dispatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator1>::value_type>::type;
+        const size_t i = _simd_mismatch((const E *)lp::to_address(first1), (const E *)lp::to_address(first2), (size_t)(last1 - first1));
+        return std::pair<InputIterator1, InputIterator2>(first1 + i, first2 + i);
+    }
+
+    // [first1,last1)与first2开始的等长区间中第一对不相等的元素
+    template <class InputIterator1, class InputIterator2>
+    inline std::pair<InputIterator1, InputIterator2> mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+    {
+        return _mismatch_dispatch(first1, last1, first2,
+                                  std::integral_constant<bool, _is_contiguous_same<InputIterator1, InputIterator2>::value &&
+                                                                   _is_simd_scan<InputIterator1>::value>());
+    }
+
+    template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+    inline std::pair<InputIterator1, InputIterator2>
+    mismatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred)
+    {
+        for (; first1 != last1 && pred(*first1, *first2); ++first1, ++first2)
+        {
+        }
+        return std::pair<InputIterator1, InputIterator2>(first1, first2);
+    }
+    // endregion
+
+    // region:min_element,max_element,minmax_element
+    // 第一个最小的元素
+    template <class ForwardIterator, class Compare>
+    ForwardIterator min_element(ForwardIterator first, ForwardIterator last, Compare comp)
+    {
+        ForwardIterator result = first;
+        if (first != last)
+        {
+            while (++first != last)
+            {
+                if (comp(*first, *result))
+                {
+                    result = first;
+                }
+            }
+        }
+        return result;
+    }
+
+    // 第一个最大的元素
+    template <class ForwardIterator, class Compare>
+    ForwardIterator max_element(ForwardIterator first, ForwardIterator last, Compare comp)
+    {
+        ForwardIterator result = first;
+        if (first != last)
+        {
+            while (++first != last)
+            {
+                if (comp(*result, *first))
+                {
+                    result = first;
+                }
+            }
+        }
+        return result;
+    }
+
+    // 第一个最小的元素与最后一个最大的元素,与std::minmax_element相同
+    template <class ForwardIterator, class Compare>
+    std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first, ForwardIterator last, Compare comp)
+    {
+        std::pair<ForwardIterator, ForwardIterator> result(first, first);
+        if (first != last)
+        {
+            while (++first != last)
+            {
+                if (comp(*first, *result.first))
+                {
+                    result.first = first;
+                }
+                if (!comp(*first, *result.second))
+                {
+                    result.second = first;
+                }
+            }
+        }
+        return result;
+    }
+
+    // 向量内核一次求出最小与最大元素的下标,LastMax决定相等的最大元素取最后一个还是第一个
+    template <bool LastMax, class ForwardIterator>
+    inline std::pair<ForwardIterator, ForwardIterator> _simd_minmax_element(ForwardIterator first, ForwardIterator last)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<ForwardIterator>::value_type>::type;
+        if (first == last)
+        {
+            return std::pair<ForwardIterator, ForwardIterator>(first, first);
+        }
+        size_t lo = 0, hi = 0;
+        _simd_minmax<LastMax>((const E *)lp::to_address(first), (size_t)(last - first), &lo, &hi);
+        return std::pair<ForwardIterator, ForwardIterator>(first + lo, first + hi);
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator _min_element_dispatch(ForwardIterator first, ForwardIterator last, std::false_type)
+    {
+        return lp::min_element(first, last, _less());
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator _min_element_dispatch(ForwardIterator first, ForwardIterator last, std::true_type)
+    {
+        return _simd_minmax_element<false>(first, last).first;
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator min_element(ForwardIterator first, ForwardIterator last)
+    {
+        return _min_element_dispatch(first, last, _is_simd_scan<ForwardIterator>());
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator _max_element_dispatch(ForwardIterator first, ForwardIterator last, std::false_type)
+    {
+        return lp::max_element(first, last, _less());
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator _max_element_dispatch(ForwardIterator first, ForwardIterator last, std::true_type)
+    {
+        return _simd_minmax_element<false>(first, last).second;
+    }
+
+    template <class ForwardIterator>
+    inline ForwardIterator max_element(ForwardIterator first, ForwardIterator last)
+    {
+        return _max_element_dispatch(first, last, _is_simd_scan<ForwardIterator>());
+    }
+
+    template <class ForwardIterator>
+    inline std::pair<ForwardIterator, ForwardIterator>
+    _minmax_element_dispatch(ForwardIterator first, ForwardIterator last, std::false_type)
+    {
+        return lp::minmax_element(first, last, _less());
+    }
+
+    template <class ForwardIterator>
+    inline std::pair<ForwardIterator, ForwardIterator>
+    _minmax_element_dispatch(ForwardIterator first, ForwardIterator last, std::true_type)
+    {
+        return _simd_minmax_element<true>(first, last);
+    }
+
+    template <class ForwardIterator>
+    inline std::pair<ForwardIterator, ForwardIterator> minmax_element(ForwardIterator first, ForwardIterator last)
+    {
+        return _minmax_element_dispatch(first, last, _is_simd_scan<ForwardIterator>());
+    }
+    // endregion
+
+    // region:is_sorted
+    template <class ForwardIterator, class Compare>
+    bool is_sorted(ForwardIterator first, ForwardIterator last, Compare comp)
+    {
+        if (first == last)
+        {
+            return true;
+        }
+        for (ForwardIterator next = first; ++next != last; first = next)
+        {
+            if (comp(*next, *first))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class ForwardIterator>
+    inline bool is_sorted(ForwardIterator first, ForwardIterator last)
+    {
+        return lp::is_sorted(first, last, _less());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_ALGO_H
@@ -0,0 +1,586 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+基本算法:iter_swap,max,min,copy,copy_backward,move,move_backward,fill,fill_n,equal,lexicographical_compare
+每个算法先看能否直接操作内存,不能再按lp::iterator_traits的迭代器类型选择循环:
+ * 两端都是连续迭代器(原生指针或contiguous_iterator_tag),元素类型相同且赋值是平凡的:
+   copy/move系列对lp::to_address得到的地址用memmove(区间可以重叠)
+ * 连续迭代器,元素为1字节且赋值是平凡的:fill/fill_n用memset
+ * 两端都是连续迭代器,元素为整数,枚举或指针(没有填充位,按位相等即相等):equal用memcmp
+ * 两端都是连续迭代器,元素为float或double:equal用向量比较(lp_simd_scan.h)
+ * 连续迭代器,元素为无符号的单字节类型(memcmp按unsigned char比较):lexicographical_compare用memcmp
+ * 随机访问迭代器用n计数的循环,不必每次比较两个迭代器,编译器更容易展开和向量化
+ * 其他迭代器逐个比较first != last
+*/
+#ifndef LP_ALGOBASE_H
+#define LP_ALGOBASE_H
+
+#include <climits>     //for CHAR_MIN
+#include <cstddef>     //for size_t
+#include <cstring>     //for memmove,memset,memcmp
+#include <type_traits> //for std::is_trivially_copy_assignable等
+#include <utility>     //for std::move,std::swap
+#include "../2_iterator/lp_iterator.h"
+#include "lp_simd_scan.h" //for _simd_mismatch
+
+namespace lp
+{
+    // region:函数对象
+    // 算法的默认比较,比较两个元素用operator<
+    struct _less
+    {
+        template <class T, class U>
+        bool operator()(const T &a, const U &b) const { return a < b; }
+    };
+    // endregion
+
+    // region:iter_swap
+    // 交换两个迭代器所指的元素,先找元素类型自己的swap(ADL),再用std::swap
+    template <class ForwardIterator1, class ForwardIterator2>
+    inline void iter_swap(ForwardIterator1 a, ForwardIterator2 b)
+    {
+        using std::swap;
+        swap(*a, *b);
+    }
+    // endregion
+
+    // region:max,min
+    template <class T>
+    inline const T &max(const T &a, const T &b)
+    {
+        return a < b ? b : a;
+    }
+
+    template <class T, class Compare>
+    inline const T &max(const T &a, const T &b, Compare comp)
+    {
+        return comp(a, b) ? b : a;
+    }
+
+    template <class T>
+    inline const T &min(const T &a, const T &b)
+    {
+        return b < a ? b : a;
+    }
+
+    template <class T, class Compare>
+    inline const T &min(const T &a, const T &b, Compare comp)
+    {
+        return comp(b, a) ? b : a;
+    }
+    // endregion
+
+    // region:直接操作内存的条件
+    // 两个都是连续迭代器,元素类型相同(可以一个有const一个没有)且不是volatile,两段内存可以按位比较或搬动
+    template <class Iterator>
+    struct _is_volatile_element
+        : std::is_volatile<typename std::remove_reference<typename iterator_traits<Iterator>::reference>::type>
+    {
+    };
+
+    template <class Iterator1, class Iterator2,
+              bool = is_contiguous_iterator<Iterator1>::value && is_contiguous_iterator<Iterator2>::value>
+    struct _is_contiguous_same : std::false_type
+    {
+    };
+
+    template <class Iterator1, class Iterator2>
+    struct _is_contiguous_same<Iterator1, Iterator2, true>
+        : std::integral_constant<bool, std::is_same<typename std::remove_cv<typename iterator_traits<Iterator1>::value_type>::type,
+                                                    typename std::remove_cv<typename iterator_traits<Iterator2>::value_type>::type>::value &&
+                                           !_is_volatile_element<Iterator1>::value && !_is_volatile_element<Iterator2>::value>
+    {
+    };
+
+    // 可以通过迭代器写入元素
+    template <class Iterator>
+    struct _is_writable
+        : std::integral_constant<bool, !std::is_const<typename std::remove_reference<typename iterator_traits<Iterator>::reference>::type>::value>
+    {
+    };
+
+    // [first,last)与result可以按位搬动,且Assignable表示的赋值是平凡的
+    template <class InputIterator, class OutputIterator, template <class> class Assignable,
+              bool = _is_contiguous_same<InputIterator, OutputIterator>::value>
+    struct _is_memmove_assignable : std::false_type
+    {
+    };
+
+    template <class InputIterator, class OutputIterator, template <class> class Assignable>
+    struct _is_memmove_assignable<InputIterator, OutputIterator, Assignable, true>
+        : std::integral_constant<bool, _is_writable<OutputIterator>::value &&
+                                           Assignable<typename iterator_traits<OutputIterator>::value_type>::value>
+    {
+    };
+
+    template <class InputIterator, class OutputIterator>
+    using _is_memmove_copyable = _is_memmove_assignable<InputIterator, OutputIterator, std::is_trivially_copy_assignable>;
+
+    template <class InputIterator, class OutputIterator>
+    using _is_memmove_movable = _is_memmove_assignable<InputIterator, OutputIterator, std::is_trivially_move_assignable>;
+
+    // 连续迭代器,1字节且赋值平凡的元素可以用memset填充
+    template <class ForwardIterator, bool = is_contiguous_iterator<ForwardIterator>::value>
+    struct _is_memset_fillable : std::false_type
+    {
+    };
+
+    template <class ForwardIterator>
+    struct _is_memset_fillable<ForwardIterator, true>
+        : std::integral_constant<bool, 1 == sizeof(typename iterator_traits<ForwardIterator>::value_type) &&
+                                           _is_writable<ForwardIterator>::value && !_is_volatile_element<ForwardIterator>::value &&
+                                           std::is_trivially_copy_assignable<typename iterator_traits<ForwardIterator>::value_type>::value>
+    {
+    };
+
+    // 没有填充位,也没有+0/-0与NaN这样按位不同却相等(或按位相同却不等)的值
+    template <class T>
+    struct _is_bitwise_comparable
+        : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>
+    {
+    };
+
+    template <class InputIterator1, class InputIterator2, bool = _is_contiguous_same<InputIterator1, InputIterator2>::value>
+    struct _is_memcmp_equal : std::false_type
+    {
+    };
+
+    template <class InputIterator1, class InputIterator2>
+    struct _is_memcmp_equal<InputIterator1, InputIterator2, true>
+        : _is_bitwise_comparable<typename std::remove_cv<typename iterator_traits<InputIterator1>::value_type>::type>
+    {
+    };
+
+    // 连续迭代器,元素为算术类型,可以用lp_simd_scan.h的向量内核扫描
+    template <class Iterator, bool = is_contiguous_iterator<Iterator>::value>
+    struct _is_simd_scan : std::false_type
+    {
+    };
+
+    template <class Iterator>
+    struct _is_simd_scan<Iterator, true>
+        : std::integral_constant<bool, !_is_volatile_element<Iterator>::value &&
+                                           _is_simd_scannable<typename std::remove_cv<typename iterator_traits<Iterator>::value_type>::type>::value>
+    {
+    };
+
+    // 两端是同一种浮点数的连续区间,不能按位比较,但可以向量比较
+    template <class InputIterator1, class InputIterator2, bool = _is_contiguous_same<InputIterator1, InputIterator2>::value>
+    struct _is_simd_equal : std::false_type
+    {
+    };
+
+    template <class InputIterator1, class InputIterator2>
+    struct _is_simd_equal<InputIterator1, InputIterator2, true>
+        : std::is_floating_point<typename std::remove_cv<typename iterator_traits<InputIterator1>::value_type>::type>
+    {
+    };
+
+    // memcmp按unsigned char比较字节,只有无符号的单字节类型的大小关系与之相同
+    template <class T>
+    struct _is_byte_ordered
+        : std::integral_constant<bool, std::is_same<T, unsigned char>::value ||
+                                           (std::is_same<T, char>::value && 0 == CHAR_MIN)>
+    {
+    };
+
+    template <class InputIterator1, class InputIterator2, bool = _is_contiguous_same<InputIterator1, InputIterator2>::value>
+    struct _is_memcmp_ordered : std::false_type
+    {
+    };
+
+    template <class InputIterator1, class InputIterator2>
+    struct _is_memcmp_ordered<InputIterator1, InputIterator2, true>
+        : _is_byte_ordered<typename std::remove_cv<typename iterator_traits<InputIterator1>::value_type>::type>
+    {
+    };
+    // endregion
+
+    // region:copy
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _copy(InputIterator first, InputIterator last, OutputIterator result, input_iterator_tag)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            *result = *first;
+        }
+        return result;
+    }
+
+    template <class RandomAccessIterator, class OutputIterator>
+    inline OutputIterator _copy(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result, random_access_iterator_tag)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance n = last - first; n > 0; --n, ++first, ++result)
+        {
+            *result = *first;
+        }
+        return result;
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _copy_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::false_type)
+    {
+        return _copy(first, last, result, iterator_category(first));
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _copy_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::true_type)
+    {
+        using T = typename iterator_traits<OutputIterator>::value_type;
+        const ptrdiff_t n = last - first;
+        if (n != 0)
+        {
+            memmove((void *)lp::to_address(result), (const void *)lp::to_address(first), n * sizeof(T));
+        }
+        return result + n;
+    }
+
+    // 把[first,last)赋值到result开始的区间,返回result的尾后位置
+    // result不能在(first,last)之内,要向后平移请用copy_backward
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator copy(InputIterator first, InputIterator last, OutputIterator result)
+    {
+        return _copy_dispatch(first, last, result, _is_memmove_copyable<InputIterator, OutputIterator>());
+    }
+    // endregion
+
+    // region:copy_backward
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                 BidirectionalIterator2 result, bidirectional_iterator_tag)
+    {
+        while (first != last)
+        {
+            *--result = *--last;
+        }
+        return result;
+    }
+
+    template <class RandomAccessIterator, class BidirectionalIterator>
+    inline BidirectionalIterator _copy_backward(RandomAccessIterator first, RandomAccessIterator last,
+                                                BidirectionalIterator result, random_access_iterator_tag)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance n = last - first; n > 0; --n)
+        {
+            *--result = *--last;
+        }
+        return result;
+    }
+
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _copy_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                          BidirectionalIterator2 result, std::false_type)
+    {
+        return _copy_backward(first, last, result, iterator_category(first));
+    }
+
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _copy_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                          BidirectionalIterator2 result, std::true_type)
+    {
+        using T = typename iterator_traits<BidirectionalIterator2>::value_type;
+        const ptrdiff_t n = last - first;
+        result -= n;
+        if (n != 0)
+        {
+            memmove((void *)lp::to_address(result), (const void *)lp::to_address(first), n * sizeof(T));
+        }
+        return result;
+    }
+
+    // 把[first,last)赋值到以result结尾的区间,从后往前进行,返回目标区间的头
+    // result不能在(first,last]之内
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 copy_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result)
+    {
+        return _copy_backward_dispatch(first, last, result,
+                                       _is_memmove_copyable<BidirectionalIterator1, BidirectionalIterator2>());
+    }
+    // endregion
+
+    // region:move
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _move(InputIterator first, InputIterator last, OutputIterator result, input_iterator_tag)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            *result = std::move(*first);
+        }
+        return result;
+    }
+
+    template <class RandomAccessIterator, class OutputIterator>
+    inline OutputIterator _move(RandomAccessIterator first, RandomAccessIterator last, OutputIterator result, random_access_iterator_tag)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance n = last - first; n > 0; --n, ++first, ++result)
+        {
+            *result = std::move(*first);
+        }
+        return result;
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _move_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::false_type)
+    {
+        return _move(first, last, result, iterator_category(first));
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator _move_dispatch(InputIterator first, InputIterator last, OutputIterator result, std::true_type)
+    {
+        return _copy_dispatch(first, last, result, std::true_type());
+    }
+
+    // 与copy相同,但移动赋值,[first,last)中的元素变为"已移动"状态
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator move(InputIterator first, InputIterator last, OutputIterator result)
+    {
+        return _move_dispatch(first, last, result, _is_memmove_movable<InputIterator, OutputIterator>());
+    }
+    // endregion
+
+    // region:move_backward
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                 BidirectionalIterator2 result, bidirectional_iterator_tag)
+    {
+        while (first != last)
+        {
+            *--result = std::move(*--last);
+        }
+        return result;
+    }
+
+    template <class RandomAccessIterator, class BidirectionalIterator>
+    inline BidirectionalIterator _move_backward(RandomAccessIterator first, RandomAccessIterator last,
+                                                BidirectionalIterator result, random_access_iterator_tag)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance n = last - first; n > 0; --n)
+        {
+            *--result = std::move(*--last);
+        }
+        return result;
+    }
+
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _move_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                          BidirectionalIterator2 result, std::false_type)
+    {
+        return _move_backward(first, last, result, iterator_category(first));
+    }
+
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 _move_backward_dispatch(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                          BidirectionalIterator2 result, std::true_type)
+    {
+        return _copy_backward_dispatch(first, last, result, std::true_type());
+    }
+
+    // 与copy_backward相同,但移动赋值
+    template <class BidirectionalIterator1, class BidirectionalIterator2>
+    inline BidirectionalIterator2 move_backward(BidirectionalIterator1 first, BidirectionalIterator1 last,
+                                                BidirectionalIterator2 result)
+    {
+        return _move_backward_dispatch(first, last, result,
+                                       _is_memmove_movable<BidirectionalIterator1, BidirectionalIterator2>());
+    }
+    // endregion
+
+    // region:fill,fill_n
+    template <class ForwardIterator, class T>
+    inline void _fill(ForwardIterator first, ForwardIterator last, const T &value, forward_iterator_tag)
+    {
+        for (; first != last; ++first)
+        {
+            *first = value;
+        }
+    }
+
+    template <class RandomAccessIterator, class T>
+    inline void _fill(RandomAccessIterator first, RandomAccessIterator last, const T &value, random_access_iterator_tag)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (Distance n = last - first; n > 0; --n, ++first)
+        {
+            *first = value;
+        }
+    }
+
+    template <class OutputIterator, class Size, class T>
+    inline OutputIterator _fill_n_dispatch(OutputIterator first, Size n, const T &value, std::false_type)
+    {
+        typename std::conditional<std::is_scalar<T>::value, const T, const T &>::type tmp = value; // 同_fill_dispatch
+        for (; n > 0; --n, ++first)
+        {
+            *first = tmp;
+        }
+        return first;
+    }
+
+    template <class OutputIterator, class Size, class T>
+    inline OutputIterator _fill_n_dispatch(OutputIterator first, Size n, const T &value, std::true_type)
+    {
+        if (n <= 0)
+        {
+            return first;
+        }
+        // 先转换为元素类型,例如bool的true应写入1
+        const typename iterator_traits<OutputIterator>::value_type tmp = value;
+        unsigned char byte;
+        memcpy(&byte, &tmp, 1);
+        memset((void *)lp::to_address(first), byte, (size_t)n);
+        return first + n;
+    }
+
+    template <class ForwardIterator, class T>
+    inline void _fill_dispatch(ForwardIterator first, ForwardIterator last, const T &value, std::false_type)
+    {
+        // value可能是区间中的元素,每次赋值后都要重新读取;标量先复制到局部变量,循环才能向量化
+        typename std::conditional<std::is_scalar<T>::value, const T, const T &>::type tmp = value;
+        _fill(first, last, tmp, iterator_category(first));
+    }
+
+    template <class ForwardIterator, class T>
+    inline void _fill_dispatch(ForwardIterator first, ForwardIterator last, const T &value, std::true_type)
+    {
+        _fill_n_dispatch(first, last - first, value, std::true_type());
+    }
+
+    // 把value赋值给[first,last)中的每个元素
+    template <class ForwardIterator, class T>
+    inline void fill(ForwardIterator first, ForwardIterator last, const T &value)
+    {
+        _fill_dispatch(first, last, value, _is_memset_fillable<ForwardIterator>());
+    }
+
+    // 把value赋值给[first,first+n)中的每个元素,返回first+n
+    template <class OutputIterator, class Size, class T>
+    inline OutputIterator fill_n(OutputIterator first, Size n, const T &value)
+    {
+        return _fill_n_dispatch(first, n, value, _is_memset_fillable<OutputIterator>());
+    }
+    // endregion
+
+    // region:equal
+    template <class InputIterator1, class InputIterator2>
+    inline bool _equal_simd(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type)
+    {
+        for (; first1 != last1; ++first1, ++first2)
+        {
+            if (!(*first1 == *first2))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool _equal_simd(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::true_type)
+    {
+        using T = typename std::remove_cv<typename iterator_traits<InputIterator1>::value_type>::type;
+        const size_t n = last1 - first1;
+        return 0 == n || n == _simd_mismatch((const T *)lp::to_address(first1), (const T *)lp::to_address(first2), n);
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool _equal_dispatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::false_type)
+    {
+        return _equal_simd(first1, last1, first2, _is_simd_equal<InputIterator1, InputIterator2>());
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool _equal_dispatch(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, std::true_type)
+    {
+        using T = typename iterator_traits<InputIterator1>::value_type;
+        const size_t n = last1 - first1;
+        return 0 == n || 0 == memcmp((const void *)lp::to_address(first1), (const void *)lp::to_address(first2), n * sizeof(T));
+    }
+
+    // [first1,last1)与first2开始的等长区间是否逐个相等
+    template <class InputIterator1, class InputIterator2>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+    {
+        return _equal_dispatch(first1, last1, first2, _is_memcmp_equal<InputIterator1, InputIterator2>());
+    }
+
+    template <class InputIterator1, class InputIterator2, class BinaryPredicate>
+    inline bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred)
+    {
+        for (; first1 != last1; ++first1, ++first2)
+        {
+            if (!pred(*first1, *first2))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    // endregion
+
+    // region:lexicographical_compare
+    template <class InputIterator1, class InputIterator2, class Compare>
+    inline bool _lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                         InputIterator2 first2, InputIterator2 last2, Compare comp)
+    {
+        for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+        {
+            if (comp(*first1, *first2))
+            {
+                return true;
+            }
+            if (comp(*first2, *first1))
+            {
+                return false;
+            }
+        }
+        return first1 == last1 && first2 != last2;
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool _lexicographical_compare_dispatch(InputIterator1 first1, InputIterator1 last1,
+                                                  InputIterator2 first2, InputIterator2 last2, std::false_type)
+    {
+        return _lexicographical_compare(first1, last1, first2, last2, _less());
+    }
+
+    template <class InputIterator1, class InputIterator2>
+    inline bool _lexicographical_compare_dispatch(InputIterator1 first1, InputIterator1 last1,
+                                                  InputIterator2 first2, InputIterator2 last2, std::true_type)
+    {
+        const size_t len1 = last1 - first1;
+        const size_t len2 = last2 - first2;
+        const size_t n = lp::min(len1, len2);
+        const int result = 0 == n ? 0 : memcmp((const void *)lp::to_address(first1), (const void *)lp::to_address(first2), n);
+        return result != 0 ? result < 0 : len1 < len2;
+    }
+
+    // 以字典序比较[first1,last1)与[first2,last2),前者小于后者时返回true
+    template <class InputIterator1, class InputIterator2>
+    inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2)
+    {
+        return _lexicographical_compare_dispatch(first1, last1, first2, last2,
+                                                 _is_memcmp_ordered<InputIterator1, InputIterator2>());
+    }
+
+    template <class InputIterator1, class InputIterator2, class Compare>
+    inline bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2, Compare comp)
+    {
+        return _lexicographical_compare(first1, last1, first2, last2, comp);
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_ALGOBASE_H
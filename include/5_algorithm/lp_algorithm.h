@@ -0,0 +1,15 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+#ifndef LP_ALGORITHM_H
+#define LP_ALGORITHM_H
+#include "lp_algobase.h" //基本算法:copy,fill,equal等
+#include "lp_heap.h"     //堆算法
+#include "lp_sort.h"     //排序:sort,stable_sort,radix_sort
+#include "lp_algo.h"     //其他算法:transform,count_if等
+#include "lp_numeric.h"  //数值算法:accumulate,reduce,*_scan
+#include "lp_parallel_algo.h" //以上算法的并行版本
+#endif // LP_ALGORITHM_H
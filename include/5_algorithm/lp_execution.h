@@ -0,0 +1,112 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+执行策略,作为并行版本算法的第一个参数,与C++17的std::execution对应:
+ * lp::execution::seq       顺序执行
+ * lp::execution::par       在lp::thread_pool上并行执行
+ * lp::execution::par_unseq 并行,且允许每个线程内向量化
+par(n)/par_unseq(n)把并行度限制为n个线程,便于测试扩展性
+*/
+#ifndef LP_EXECUTION_H
+#define LP_EXECUTION_H
+
+#include <cstddef>     //for size_t
+#include <type_traits> //for std::true_type
+#include "lp_thread_pool.h"
+#include "../2_iterator/lp_iterator.h"
+
+namespace lp
+{
+    namespace execution
+    {
+        struct sequenced_policy
+        {
+        };
+
+        struct parallel_policy
+        {
+            size_t threads; // 最多使用的线程数,0表示线程池的全部线程
+
+            parallel_policy operator()(size_t n) const
+            {
+                parallel_policy p = {n};
+                return p;
+            }
+        };
+
+        struct parallel_unsequenced_policy
+        {
+            size_t threads;
+
+            parallel_unsequenced_policy operator()(size_t n) const
+            {
+                parallel_unsequenced_policy p = {n};
+                return p;
+            }
+        };
+
+        constexpr sequenced_policy seq = sequenced_policy();
+        constexpr parallel_policy par = {0};
+        constexpr parallel_unsequenced_policy par_unseq = {0};
+    } // namespace execution
+
+    template <class T>
+    struct is_execution_policy : std::false_type
+    {
+    };
+    template <>
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type
+    {
+    };
+    template <>
+    struct is_execution_policy<execution::parallel_policy> : std::true_type
+    {
+    };
+    template <>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type
+    {
+    };
+
+    // 用于并行算法重载的返回类型,ExecutionPolicy不是执行策略时该重载不参与重载决议
+    template <class ExecutionPolicy, class T>
+    using _enable_if_execution_policy =
+        typename std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T>::type;
+
+    // 迭代器都是随机访问迭代器时才能把区间切分给多个线程,否则并行版本退回顺序版本
+    template <class... Iterators>
+    struct _all_random_access;
+
+    template <>
+    struct _all_random_access<> : std::true_type
+    {
+    };
+
+    template <class Iterator, class... Rest>
+    struct _all_random_access<Iterator, Rest...>
+        : std::integral_constant<bool, is_random_access_iterator<Iterator>::value && _all_random_access<Rest...>::value>
+    {
+    };
+
+    // 策略允许使用的线程数
+    inline size_t _policy_threads(const execution::sequenced_policy &)
+    {
+        return 1;
+    }
+    inline size_t _policy_threads(const execution::parallel_policy &p)
+    {
+        size_t all = thread_pool::instance().concurrency();
+        return 0 == p.threads || p.threads > all ? all : p.threads;
+    }
+    inline size_t _policy_threads(const execution::parallel_unsequenced_policy &p)
+    {
+        size_t all = thread_pool::instance().concurrency();
+        return 0 == p.threads || p.threads > all ? all : p.threads;
+    }
+} // namespace lp
+
+#endif // LP_EXECUTION_H
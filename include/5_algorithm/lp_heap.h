@@ -0,0 +1,149 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+堆算法:push_heap,pop_heap,make_heap,sort_heap
+以随机访问区间[first,last)表示一个完全二叉树,节点i的子节点为2i+1与2i+2
+默认是大顶堆(comp为less),first指向最大的元素
+sort在递归过深时用make_heap+sort_heap完成堆排序,保证最坏O(nlogn)
+*/
+#ifndef LP_HEAP_H
+#define LP_HEAP_H
+
+#include <utility> //for std::move
+#include "lp_algobase.h"
+
+namespace lp
+{
+    // region:push_heap
+    // 把value放到holeIndex处,然后向上调整,直到不大于父节点或到达topIndex
+    template <class RandomAccessIterator, class Distance, class T, class Compare>
+    void _push_heap(RandomAccessIterator first, Distance holeIndex, Distance topIndex, T value, Compare comp)
+    {
+        Distance parent = (holeIndex - 1) / 2;
+        while (holeIndex > topIndex && comp(*(first + parent), value))
+        {
+            *(first + holeIndex) = std::move(*(first + parent));
+            holeIndex = parent;
+            parent = (holeIndex - 1) / 2;
+        }
+        *(first + holeIndex) = std::move(value);
+    }
+
+    // [first,last - 1)已经是堆,把last - 1处的新元素加入堆
+    template <class RandomAccessIterator, class Compare>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        T value = std::move(*(last - 1));
+        _push_heap(first, Distance((last - first) - 1), Distance(0), std::move(value), comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void push_heap(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::push_heap(first, last, _less());
+    }
+    // endregion
+
+    // region:pop_heap
+    // 从holeIndex开始一路下沉到叶子,再把value从叶子向上调整(比边下沉边比较value少一半的比较)
+    template <class RandomAccessIterator, class Distance, class T, class Compare>
+    void _adjust_heap(RandomAccessIterator first, Distance holeIndex, Distance len, T value, Compare comp)
+    {
+        const Distance topIndex = holeIndex;
+        Distance child = 2 * holeIndex + 2;
+        while (child < len)
+        {
+            if (comp(*(first + child), *(first + (child - 1))))
+            {
+                --child;
+            }
+            *(first + holeIndex) = std::move(*(first + child));
+            holeIndex = child;
+            child = 2 * child + 2;
+        }
+        if (child == len) // 只有左子节点
+        {
+            *(first + holeIndex) = std::move(*(first + (child - 1)));
+            holeIndex = child - 1;
+        }
+        _push_heap(first, holeIndex, topIndex, std::move(value), comp);
+    }
+
+    // 把堆顶移到last - 1,[first,last - 1)重新成为堆
+    template <class RandomAccessIterator, class Compare>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (last - first < 2)
+        {
+            return;
+        }
+        --last;
+        T value = std::move(*last);
+        *last = std::move(*first);
+        _adjust_heap(first, Distance(0), Distance(last - first), std::move(value), comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void pop_heap(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::pop_heap(first, last, _less());
+    }
+    // endregion
+
+    // region:make_heap,sort_heap
+    template <class RandomAccessIterator, class Compare>
+    void make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        const Distance len = last - first;
+        if (len < 2)
+        {
+            return;
+        }
+        // 从最后一个非叶子节点开始逐个下沉
+        for (Distance parent = (len - 2) / 2;; --parent)
+        {
+            T value = std::move(*(first + parent));
+            _adjust_heap(first, parent, len, std::move(value), comp);
+            if (0 == parent)
+            {
+                return;
+            }
+        }
+    }
+
+    template <class RandomAccessIterator>
+    inline void make_heap(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::make_heap(first, last, _less());
+    }
+
+    // [first,last)是堆,排序后不再是堆
+    template <class RandomAccessIterator, class Compare>
+    void sort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        while (last - first > 1)
+        {
+            lp::pop_heap(first, last--, comp);
+        }
+    }
+
+    template <class RandomAccessIterator>
+    inline void sort_heap(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::sort_heap(first, last, _less());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_HEAP_H
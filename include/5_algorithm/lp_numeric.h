@@ -0,0 +1,157 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+数值算法:accumulate,reduce,inclusive_scan,exclusive_scan
+ * accumulate严格从左到右累加
+ * reduce,*_scan与C++17相同,要求op满足结合律,并行版本(lp_parallel_algo.h)会改变计算的分组
+ * 连续迭代器上用默认加法时向量化(lp_simd_scan.h):整数元素累加到整数init(按init的类型回绕,与逐个相加相同),
+   reduce还包括init与元素同为float或double的情况(改变了相加的顺序)
+*/
+#ifndef LP_NUMERIC_H
+#define LP_NUMERIC_H
+
+#include <utility> //for std::move
+#include "lp_algobase.h"
+
+namespace lp
+{
+    // 数值算法的默认运算
+    struct _plus
+    {
+        template <class T, class U>
+        auto operator()(T &&a, U &&b) const -> decltype(std::forward<T>(a) + std::forward<U>(b))
+        {
+            return std::forward<T>(a) + std::forward<U>(b);
+        }
+    };
+
+    // region:accumulate,reduce
+    template <class InputIterator, class T, class BinaryOperation>
+    inline T accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op)
+    {
+        for (; first != last; ++first)
+        {
+            init = op(std::move(init), *first);
+        }
+        return init;
+    }
+
+    // 整数元素累加到整数init时,分组相加与逐个相加的结果相同;Reorder为true时(reduce)还允许float与double
+    template <class InputIterator, class T, bool Reorder, bool = _is_simd_scan<InputIterator>::value>
+    struct _is_simd_sum : std::false_type
+    {
+    };
+
+    template <class E, class T, bool Reorder>
+    struct _is_simd_sum_type
+        : std::integral_constant<bool, (std::is_integral<E>::value && std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+                                           (Reorder && std::is_floating_point<T>::value && std::is_same<E, T>::value)>
+    {
+    };
+
+    template <class InputIterator, class T, bool Reorder>
+    struct _is_simd_sum<InputIterator, T, Reorder, true>
+        : _is_simd_sum_type<typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type, T, Reorder>
+    {
+    };
+
+    template <class InputIterator, class T>
+    inline T _sum_dispatch(InputIterator first, InputIterator last, T init, std::false_type)
+    {
+        return lp::accumulate(first, last, std::move(init), _plus());
+    }
+
+    template <class InputIterator, class T>
+    inline T _sum_dispatch(InputIterator first, InputIterator last, T init, std::true_type)
+    {
+        using E = typename std::remove_cv<typename iterator_traits<InputIterator>::value_type>::type;
+        return _simd_sum((const E *)lp::to_address(first), (size_t)(last - first), init);
+    }
+
+    template <class InputIterator, class T>
+    inline T accumulate(InputIterator first, InputIterator last, T init)
+    {
+        return _sum_dispatch(first, last, std::move(init), _is_simd_sum<InputIterator, T, false>());
+    }
+
+    template <class InputIterator, class T, class BinaryOperation>
+    inline T reduce(InputIterator first, InputIterator last, T init, BinaryOperation op)
+    {
+        return lp::accumulate(first, last, std::move(init), op);
+    }
+
+    template <class InputIterator, class T>
+    inline T reduce(InputIterator first, InputIterator last, T init)
+    {
+        return _sum_dispatch(first, last, std::move(init), _is_simd_sum<InputIterator, T, true>());
+    }
+
+    template <class InputIterator>
+    inline typename iterator_traits<InputIterator>::value_type reduce(InputIterator first, InputIterator last)
+    {
+        using T = typename iterator_traits<InputIterator>::value_type;
+        return lp::reduce(first, last, T());
+    }
+    // endregion
+
+    // region:inclusive_scan
+    // result[i] = init op first[0] op ... op first[i],result可以等于first(原地计算)
+    template <class InputIterator, class OutputIterator, class BinaryOperation, class T>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op, T init)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            init = op(std::move(init), *first);
+            *result = init;
+        }
+        return result;
+    }
+
+    // 没有init时从first[0]开始
+    template <class InputIterator, class OutputIterator, class BinaryOperation>
+    OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result, BinaryOperation op)
+    {
+        if (first == last)
+        {
+            return result;
+        }
+        typename iterator_traits<InputIterator>::value_type init = *first;
+        *result = init;
+        return lp::inclusive_scan(++first, last, ++result, op, std::move(init));
+    }
+
+    template <class InputIterator, class OutputIterator>
+    inline OutputIterator inclusive_scan(InputIterator first, InputIterator last, OutputIterator result)
+    {
+        return lp::inclusive_scan(first, last, result, _plus());
+    }
+    // endregion
+
+    // region:exclusive_scan
+    // result[i] = init op first[0] op ... op first[i - 1],result可以等于first(原地计算)
+    template <class InputIterator, class OutputIterator, class T, class BinaryOperation>
+    OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init, BinaryOperation op)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            T value = op(init, *first); // 先读*first,原地计算时*result就是*first
+            *result = std::move(init);
+            init = std::move(value);
+        }
+        return result;
+    }
+
+    template <class InputIterator, class OutputIterator, class T>
+    inline OutputIterator exclusive_scan(InputIterator first, InputIterator last, OutputIterator result, T init)
+    {
+        return lp::exclusive_scan(first, last, result, std::move(init), _plus());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_NUMERIC_H
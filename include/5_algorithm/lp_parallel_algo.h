@@ -0,0 +1,485 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+算法的并行版本,第一个参数为执行策略,例如
+    lp::sort(lp::execution::par, v.begin(), v.end());
+    double sum = lp::reduce(lp::execution::par, v.begin(), v.end(), 0.0);
+包括for_each,transform,reduce,count_if,copy_if,inclusive_scan,exclusive_scan,sort
+ * 所有迭代器都是随机访问迭代器,且区间不小于_PAR_ALGO_GRAIN的两倍时,在lp::thread_pool上执行
+ * 其他情况(包括execution::seq)退回顺序版本,结果相同
+ * reduce和*_scan要求op满足结合律,并行时的分组与顺序版本不同(浮点数的结果可能有舍入差异)
+ * 函数对象可能被多个线程同时调用;任何一段抛出异常,等其他段结束后重新抛出第一个异常
+*/
+#ifndef LP_PARALLEL_ALGO_H
+#define LP_PARALLEL_ALGO_H
+
+#include <cstddef>     //for size_t
+#include <new>         //for placement new
+#include <type_traits> //for std::aligned_storage
+#include <utility>     //for std::move
+#include <vector>      //for std::vector
+#include "lp_execution.h"
+#include "lp_algo.h"
+#include "lp_numeric.h"
+
+namespace lp
+{
+    enum
+    {
+        _PAR_ALGO_GRAIN = 32 * 1024 // 每段至少这么多个元素,更小的区间不值得交给其他线程
+    };
+
+    // region:并行算法的框架
+    inline size_t _par_algo_chunks(size_t threads, size_t n)
+    {
+        size_t chunks = n / _PAR_ALGO_GRAIN;
+        return chunks < threads ? chunks : threads;
+    }
+
+    // 把[0,n)均分为chunks段,对第i段[b,e)调用f(i,b,e);各段的边界在多趟计算中保持一致
+    template <class F>
+    inline void _par_for_each_chunk(size_t n, size_t chunks, F f)
+    {
+        parallel_chunks(chunks, chunks, [&](size_t b, size_t e)
+                        {
+                            for (size_t i = b; i < e; ++i)
+                            {
+                                f(i, n * i / chunks, n * (i + 1) / chunks);
+                            } });
+    }
+
+    // 每段的中间结果,T不必有默认构造函数
+    template <class T>
+    class _par_partials
+    {
+    public:
+        explicit _par_partials(size_t n) : slots(n), filled(n, 0) {}
+        ~_par_partials()
+        {
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                if (filled[i])
+                {
+                    (*this)[i].~T();
+                }
+            }
+        }
+        _par_partials(const _par_partials &) = delete;
+        _par_partials &operator=(const _par_partials &) = delete;
+
+        // 每个位置只能设置一次,不同位置可以由不同线程同时设置
+        template <class U>
+        void set(size_t i, U &&value)
+        {
+            new (&slots[i]) T(std::forward<U>(value));
+            filled[i] = 1;
+        }
+        T &operator[](size_t i) { return *reinterpret_cast<T *>(&slots[i]); }
+
+    private:
+        std::vector<typename std::aligned_storage<sizeof(T), alignof(T)>::type> slots;
+        std::vector<char> filled; // 不用vector<bool>:相邻的位不能由不同线程同时写
+    };
+    // endregion
+
+    // region:for_each
+    template <class ForwardIterator, class Function>
+    inline void _par_for_each(size_t, ForwardIterator first, ForwardIterator last, Function f, std::false_type)
+    {
+        lp::for_each(first, last, f);
+    }
+
+    template <class RandomAccessIterator, class Function>
+    void _par_for_each(size_t threads, RandomAccessIterator first, RandomAccessIterator last, Function f, std::true_type)
+    {
+        size_t n = last - first;
+        parallel_chunks(n, _par_algo_chunks(threads, n), [&](size_t b, size_t e)
+                        { lp::for_each(first + b, first + e, f); });
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class Function>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    for_each(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last, Function f)
+    {
+        _par_for_each(_policy_threads(policy), first, last, f, _all_random_access<ForwardIterator>());
+    }
+    // endregion
+
+    // region:transform
+    template <class ForwardIterator1, class ForwardIterator2, class UnaryOperation>
+    inline ForwardIterator2 _par_transform(size_t, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                                           UnaryOperation op, std::false_type)
+    {
+        return lp::transform(first, last, result, op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class UnaryOperation>
+    RandomAccessIterator2 _par_transform(size_t threads, RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                         RandomAccessIterator2 result, UnaryOperation op, std::true_type)
+    {
+        size_t n = last - first;
+        parallel_chunks(n, _par_algo_chunks(threads, n), [&](size_t b, size_t e)
+                        { lp::transform(first + b, first + e, result + b, op); });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class UnaryOperation>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    transform(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result, UnaryOperation op)
+    {
+        return _par_transform(_policy_threads(policy), first, last, result, op,
+                              _all_random_access<ForwardIterator1, ForwardIterator2>());
+    }
+
+    template <class ForwardIterator1, class ForwardIterator2, class ForwardIterator3, class BinaryOperation>
+    inline ForwardIterator3 _par_transform(size_t, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2,
+                                           ForwardIterator3 result, BinaryOperation op, std::false_type)
+    {
+        return lp::transform(first1, last1, first2, result, op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class BinaryOperation>
+    RandomAccessIterator3 _par_transform(size_t threads, RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                         RandomAccessIterator2 first2, RandomAccessIterator3 result, BinaryOperation op,
+                                         std::true_type)
+    {
+        size_t n = last1 - first1;
+        parallel_chunks(n, _par_algo_chunks(threads, n), [&](size_t b, size_t e)
+                        { lp::transform(first1 + b, first1 + e, first2 + b, result + b, op); });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class ForwardIterator3,
+              class BinaryOperation>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator3>
+    transform(ExecutionPolicy &&policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2,
+              ForwardIterator3 result, BinaryOperation op)
+    {
+        return _par_transform(_policy_threads(policy), first1, last1, first2, result, op,
+                              _all_random_access<ForwardIterator1, ForwardIterator2, ForwardIterator3>());
+    }
+    // endregion
+
+    // region:reduce
+    template <class ForwardIterator, class T, class BinaryOperation>
+    inline T _par_reduce(size_t, ForwardIterator first, ForwardIterator last, T init, BinaryOperation op, std::false_type)
+    {
+        return lp::reduce(first, last, std::move(init), op);
+    }
+
+    // 各段以自己的第一个元素为初值求和,最后按段的顺序合并
+    template <class RandomAccessIterator, class T, class BinaryOperation>
+    T _par_reduce(size_t threads, RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op, std::true_type)
+    {
+        size_t n = last - first;
+        size_t chunks = _par_algo_chunks(threads, n);
+        if (chunks <= 1)
+        {
+            return lp::reduce(first, last, std::move(init), op);
+        }
+        _par_partials<T> sums(chunks);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            {
+                                T acc = first[b];
+                                sums.set(i, lp::accumulate(first + (b + 1), first + e, std::move(acc), op)); });
+        for (size_t i = 0; i < chunks; ++i)
+        {
+            init = op(std::move(init), std::move(sums[i]));
+        }
+        return init;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T, class BinaryOperation>
+    inline _enable_if_execution_policy<ExecutionPolicy, T>
+    reduce(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation op)
+    {
+        return _par_reduce(_policy_threads(policy), first, last, std::move(init), op, _all_random_access<ForwardIterator>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class T>
+    inline _enable_if_execution_policy<ExecutionPolicy, T>
+    reduce(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last, T init)
+    {
+        return lp::reduce(policy, first, last, std::move(init), _plus());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type>
+    reduce(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last)
+    {
+        using T = typename iterator_traits<ForwardIterator>::value_type;
+        return lp::reduce(policy, first, last, T(), _plus());
+    }
+    // endregion
+
+    // region:count_if
+    template <class ForwardIterator, class Predicate>
+    inline typename iterator_traits<ForwardIterator>::difference_type
+    _par_count_if(size_t, ForwardIterator first, ForwardIterator last, Predicate pred, std::false_type)
+    {
+        return lp::count_if(first, last, pred);
+    }
+
+    template <class RandomAccessIterator, class Predicate>
+    typename iterator_traits<RandomAccessIterator>::difference_type
+    _par_count_if(size_t threads, RandomAccessIterator first, RandomAccessIterator last, Predicate pred, std::true_type)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        size_t n = last - first;
+        size_t chunks = _par_algo_chunks(threads, n);
+        if (chunks <= 1)
+        {
+            return lp::count_if(first, last, pred);
+        }
+        std::vector<Distance> counts(chunks);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            { counts[i] = lp::count_if(first + b, first + e, pred); });
+        return lp::accumulate(counts.begin(), counts.end(), Distance(0));
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator, class Predicate>
+    inline _enable_if_execution_policy<ExecutionPolicy, typename iterator_traits<ForwardIterator>::difference_type>
+    count_if(ExecutionPolicy &&policy, ForwardIterator first, ForwardIterator last, Predicate pred)
+    {
+        return _par_count_if(_policy_threads(policy), first, last, pred, _all_random_access<ForwardIterator>());
+    }
+    // endregion
+
+    // region:copy_if
+    template <class ForwardIterator1, class ForwardIterator2, class Predicate>
+    inline ForwardIterator2 _par_copy_if(size_t, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                                         Predicate pred, std::false_type)
+    {
+        return lp::copy_if(first, last, result, pred);
+    }
+
+    // 两趟:先数出每段要复制的元素个数,得到各段在result中的起点,再各自复制;pred对每个元素调用两次
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class Predicate>
+    RandomAccessIterator2 _par_copy_if(size_t threads, RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                       RandomAccessIterator2 result, Predicate pred, std::true_type)
+    {
+        size_t n = last - first;
+        size_t chunks = _par_algo_chunks(threads, n);
+        if (chunks <= 1)
+        {
+            return lp::copy_if(first, last, result, pred);
+        }
+        std::vector<size_t> offsets(chunks + 1);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            { offsets[i + 1] = lp::count_if(first + b, first + e, pred); });
+        lp::inclusive_scan(offsets.begin(), offsets.end(), offsets.begin());
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            { lp::copy_if(first + b, first + e, result + offsets[i], pred); });
+        return result + offsets[chunks];
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class Predicate>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    copy_if(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result, Predicate pred)
+    {
+        return _par_copy_if(_policy_threads(policy), first, last, result, pred,
+                            _all_random_access<ForwardIterator1, ForwardIterator2>());
+    }
+    // endregion
+
+    // region:inclusive_scan,exclusive_scan
+    // 三趟:各段求和(最后一段不需要);按顺序算出每段之前的前缀;各段以自己的前缀为初值做顺序扫描
+    // 第一趟读完全部输入后才开始写,result可以等于first
+    // 求出prefix[i] = init op sums[0] op ... op sums[i - 1];init为空指针时prefix[0]不存在
+    template <class RandomAccessIterator, class T, class BinaryOperation>
+    void _par_scan_prefixes(RandomAccessIterator first, size_t n, size_t chunks, BinaryOperation op, const T *init,
+                            _par_partials<T> &prefix)
+    {
+        _par_partials<T> sums(chunks);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            {
+                                if (i + 1 == chunks)
+                                {
+                                    return;
+                                }
+                                T acc = first[b];
+                                sums.set(i, lp::accumulate(first + (b + 1), first + e, std::move(acc), op)); });
+        if (init)
+        {
+            prefix.set(0, *init);
+            for (size_t i = 1; i < chunks; ++i)
+            {
+                prefix.set(i, op(prefix[i - 1], sums[i - 1]));
+            }
+        }
+        else
+        {
+            prefix.set(1, sums[0]);
+            for (size_t i = 2; i < chunks; ++i)
+            {
+                prefix.set(i, op(prefix[i - 1], sums[i - 1]));
+            }
+        }
+    }
+
+    template <class ForwardIterator1, class ForwardIterator2, class BinaryOperation, class T>
+    inline ForwardIterator2 _par_inclusive_scan(size_t, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                                                BinaryOperation op, const T *init, std::false_type)
+    {
+        return init ? lp::inclusive_scan(first, last, result, op, *init) : lp::inclusive_scan(first, last, result, op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class BinaryOperation, class T>
+    RandomAccessIterator2 _par_inclusive_scan(size_t threads, RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                              RandomAccessIterator2 result, BinaryOperation op, const T *init, std::true_type)
+    {
+        size_t n = last - first;
+        size_t chunks = _par_algo_chunks(threads, n);
+        if (chunks <= 1)
+        {
+            return _par_inclusive_scan(threads, first, last, result, op, init, std::false_type());
+        }
+        _par_partials<T> prefix(chunks);
+        _par_scan_prefixes(first, n, chunks, op, init, prefix);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            {
+                                if (0 == i && !init)
+                                {
+                                    lp::inclusive_scan(first, first + e, result, op);
+                                }
+                                else
+                                {
+                                    lp::inclusive_scan(first + b, first + e, result + b, op, prefix[i]);
+                                } });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation, class T>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                   BinaryOperation op, T init)
+    {
+        return _par_inclusive_scan(_policy_threads(policy), first, last, result, op, &init,
+                                   _all_random_access<ForwardIterator1, ForwardIterator2>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class BinaryOperation>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                   BinaryOperation op)
+    {
+        using T = typename iterator_traits<ForwardIterator1>::value_type;
+        return _par_inclusive_scan(_policy_threads(policy), first, last, result, op, (const T *)0,
+                                   _all_random_access<ForwardIterator1, ForwardIterator2>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    inclusive_scan(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result)
+    {
+        return lp::inclusive_scan(policy, first, last, result, _plus());
+    }
+
+    template <class ForwardIterator1, class ForwardIterator2, class T, class BinaryOperation>
+    inline ForwardIterator2 _par_exclusive_scan(size_t, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                                                T init, BinaryOperation op, std::false_type)
+    {
+        return lp::exclusive_scan(first, last, result, std::move(init), op);
+    }
+
+    template <class RandomAccessIterator1, class RandomAccessIterator2, class T, class BinaryOperation>
+    RandomAccessIterator2 _par_exclusive_scan(size_t threads, RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                              RandomAccessIterator2 result, T init, BinaryOperation op, std::true_type)
+    {
+        size_t n = last - first;
+        size_t chunks = _par_algo_chunks(threads, n);
+        if (chunks <= 1)
+        {
+            return lp::exclusive_scan(first, last, result, std::move(init), op);
+        }
+        _par_partials<T> prefix(chunks);
+        _par_scan_prefixes(first, n, chunks, op, &init, prefix);
+        _par_for_each_chunk(n, chunks, [&](size_t i, size_t b, size_t e)
+                            { lp::exclusive_scan(first + b, first + e, result + b, prefix[i], op); });
+        return result + n;
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T, class BinaryOperation>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    exclusive_scan(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+                   T init, BinaryOperation op)
+    {
+        return _par_exclusive_scan(_policy_threads(policy), first, last, result, std::move(init), op,
+                                   _all_random_access<ForwardIterator1, ForwardIterator2>());
+    }
+
+    template <class ExecutionPolicy, class ForwardIterator1, class ForwardIterator2, class T>
+    inline _enable_if_execution_policy<ExecutionPolicy, ForwardIterator2>
+    exclusive_scan(ExecutionPolicy &&policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result, T init)
+    {
+        return lp::exclusive_scan(policy, first, last, result, std::move(init), _plus());
+    }
+    // endregion
+
+    // region:sort
+    // 并行快速排序:划分后左半段交给线程池,自己继续划分右半段,短于grain的区间顺序排序
+    // 递归深度限制与顺序版本相同,超过后用堆排序
+    template <class RandomAccessIterator, class Size, class Compare>
+    void _par_sort_loop(RandomAccessIterator first, RandomAccessIterator last, Size depth_limit,
+                        ptrdiff_t grain, Compare comp, task_group &group)
+    {
+        while (last - first > grain)
+        {
+            if (0 == depth_limit)
+            {
+                _heap_sort(first, last, comp);
+                return;
+            }
+            --depth_limit;
+            RandomAccessIterator cut = _unguarded_partition_pivot(first, last, comp);
+            group.run([=, &group]
+                      { _par_sort_loop(first, cut, depth_limit, grain, comp, group); });
+            first = cut;
+        }
+        lp::sort(first, last, comp);
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void _par_sort(size_t, RandomAccessIterator first, RandomAccessIterator last, Compare comp, std::false_type)
+    {
+        lp::sort(first, last, comp);
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    void _par_sort(size_t threads, RandomAccessIterator first, RandomAccessIterator last, Compare comp, std::true_type)
+    {
+        ptrdiff_t n = last - first;
+        if (threads <= 1 || n < 2 * _PAR_ALGO_GRAIN)
+        {
+            lp::sort(first, last, comp);
+            return;
+        }
+        // 每个线程约8段,线程池靠偷任务平衡划分不均的段
+        ptrdiff_t grain = lp::max(n / (ptrdiff_t)(threads * 8), (ptrdiff_t)_PAR_ALGO_GRAIN);
+        task_group group;
+        _par_sort_loop(first, last, _lg(n) * 2, grain, comp, group);
+        group.wait();
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator, class Compare>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    sort(ExecutionPolicy &&policy, RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        _par_sort(_policy_threads(policy), first, last, comp, _all_random_access<RandomAccessIterator>());
+    }
+
+    template <class ExecutionPolicy, class RandomAccessIterator>
+    inline _enable_if_execution_policy<ExecutionPolicy, void>
+    sort(ExecutionPolicy &&policy, RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::sort(policy, first, last, _less());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_PARALLEL_ALGO_H
@@ -0,0 +1,648 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+连续的算术类型区间上的向量化扫描:查找,计数,比较,最值,求和
+供find,find_if,count,count_if,mismatch,equal,min_element,max_element,minmax_element,accumulate,reduce使用
+ * 元素为整数(bool除外),float或double,区间由连续迭代器(原生指针或contiguous_iterator_tag)给出
+ * 内核用GCC的向量扩展(vector_size)写一遍,以SSE2,AVX2,AVX-512(avx512f+avx512bw)三种宽度
+   各实例化一次,每种用__attribute__((target))单独编译,不需要-mavx2等编译选项
+ * 第一次使用时按CPUID选出CPU支持的最宽的一种,simd_scan_level()可以改成更低的级别做对比
+ * 其他平台和编译器只有逐个元素的通用内核
+find_if/count_if只对下面的比较谓词向量化,其他谓词仍逐个调用:
+    value_eq(v) value_ne(v) value_lt(v) value_le(v) value_gt(v) value_ge(v) value_between(lo,hi)
+    例如 lp::count_if(v.begin(), v.end(), lp::value_between(10, 20)) 统计10 <= x <= 20的元素个数
+    谓词的类型参数须与元素类型相同,例如uint8_t的区间用lp::value_lt<uint8_t>(16)
+浮点数的比较与逐个比较相同(-0.0 == +0.0,NaN与任何数都不相等);
+最值遇到NaN时退回逐个比较,min_element/max_element的结果与std的相同
+*/
+#ifndef LP_SIMD_SCAN_H
+#define LP_SIMD_SCAN_H
+
+#include <cstddef>     //for size_t
+#include <cstring>     //for memcpy
+#include <stdint.h>    //for uint64_t
+#include <type_traits> //for std::is_integral等
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define _LP_SCAN_X86
+#ifndef _LP_TARGET
+#define _LP_TARGET(isa) __attribute__((target(isa)))
+#endif
+#define _LP_ALWAYS_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace lp
+{
+    // SIMD级别,lp::simd(lp_simd.h)与扫描算法共用
+    enum
+    {
+        _SIMD_GENERIC,
+        _SIMD_SSE2,
+        _SIMD_AVX2,
+        _SIMD_AVX512,
+        _SIMD_LEVELS
+    };
+
+    // region:比较谓词
+    enum
+    {
+        _CMP_EQ,
+        _CMP_NE,
+        _CMP_LT,
+        _CMP_LE,
+        _CMP_GT,
+        _CMP_GE,
+        _CMP_BETWEEN // a <= x <= b
+    };
+
+    template <class T, int Op>
+    struct _cmp_pred
+    {
+        T a, b;
+        template <class U>
+        bool operator()(const U &x) const
+        {
+            return _CMP_EQ == Op ? x == a : _CMP_NE == Op ? x != a : _CMP_LT == Op ? x < a : _CMP_LE == Op ? x <= a : _CMP_GT == Op ? x > a : _CMP_GE == Op ? x >= a : a <= x && x <= b;
+        }
+    };
+
+    template <class T>
+    inline _cmp_pred<T, _CMP_EQ> value_eq(T v)
+    {
+        return _cmp_pred<T, _CMP_EQ>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_NE> value_ne(T v)
+    {
+        return _cmp_pred<T, _CMP_NE>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_LT> value_lt(T v)
+    {
+        return _cmp_pred<T, _CMP_LT>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_LE> value_le(T v)
+    {
+        return _cmp_pred<T, _CMP_LE>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_GT> value_gt(T v)
+    {
+        return _cmp_pred<T, _CMP_GT>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_GE> value_ge(T v)
+    {
+        return _cmp_pred<T, _CMP_GE>{v, v};
+    }
+    template <class T>
+    inline _cmp_pred<T, _CMP_BETWEEN> value_between(T lo, T hi)
+    {
+        return _cmp_pred<T, _CMP_BETWEEN>{lo, hi};
+    }
+    // endregion
+
+    // region:通用内核
+    // 第一个满足比较的下标,没有时返回n
+    template <int Op, class E>
+    size_t _generic_find(const E *p, size_t n, E a, E b)
+    {
+        _cmp_pred<E, Op> pred = {a, b};
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (pred(p[i]))
+            {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    template <int Op, class E>
+    size_t _generic_count(const E *p, size_t n, E a, E b)
+    {
+        _cmp_pred<E, Op> pred = {a, b};
+        size_t c = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            c += pred(p[i]) ? 1 : 0;
+        }
+        return c;
+    }
+
+    // 第一个不相等的下标,全部相等时返回n
+    template <class E>
+    size_t _generic_mismatch(const E *p, const E *q, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!(p[i] == q[i]))
+            {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    // 第一个最小值的下标与第一个(LastMax为true时最后一个)最大值的下标,n > 0;总是返回true
+    template <bool LastMax, class E>
+    bool _generic_minmax(const E *p, size_t n, size_t *min_at, size_t *max_at)
+    {
+        size_t lo = 0, hi = 0;
+        for (size_t i = 1; i < n; ++i)
+        {
+            if (p[i] < p[lo])
+            {
+                lo = i;
+            }
+            if (LastMax ? !(p[i] < p[hi]) : p[hi] < p[i])
+            {
+                hi = i;
+            }
+        }
+        *min_at = lo;
+        *max_at = hi;
+        return true;
+    }
+
+    // init加上所有元素;整数按T的宽度回绕,浮点数按顺序相加
+    template <class T, class E>
+    T _generic_sum(const E *p, size_t n, T init)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            init = init + p[i];
+        }
+        return init;
+    }
+    // endregion
+
+#ifdef _LP_SCAN_X86
+    // region:向量内核
+    // 内核只以指针和标量为参数,向量只在内核内部使用,总是内联进带target的包装函数
+    template <class E, size_t W>
+    struct _vec
+    {
+        typedef E type __attribute__((vector_size(W)));
+    };
+
+    // 比较结果转换成的无符号整数向量;AVX-512下比较结果直接做&,|会被拆成逐个元素,转换后不会
+    template <class V>
+    struct _vmask
+    {
+        typedef typename std::remove_reference<decltype((V() == V())[0])>::type lane;
+        typedef typename _vec<typename std::make_unsigned<lane>::type, sizeof(V)>::type type;
+    };
+
+    // m = x与a,b按Op比较的结果,每个元素全1(真)或全0;向量不作为返回值,避免-Wpsabi
+    template <int Op, class M, class V>
+    _LP_ALWAYS_INLINE void _cmp(M &m, const V &x, const V &a, const V &b)
+    {
+        switch (Op)
+        {
+        case _CMP_EQ:
+            m = (M)(x == a);
+            break;
+        case _CMP_NE:
+            m = (M)(x != a);
+            break;
+        case _CMP_LT:
+            m = (M)(x < a);
+            break;
+        case _CMP_LE:
+            m = (M)(x <= a);
+            break;
+        case _CMP_GT:
+            m = (M)(x > a);
+            break;
+        case _CMP_GE:
+            m = (M)(x >= a);
+            break;
+        default:
+            m = (M)(x >= a) & (M)(x <= b);
+            break;
+        }
+    }
+
+    // 向量中是否有非0的元素
+    template <class M>
+    _LP_ALWAYS_INLINE bool _vany(const M &m)
+    {
+        typedef typename _vec<uint64_t, sizeof(M)>::type U;
+        const U words = (U)m;
+        uint64_t any = 0;
+        for (size_t k = 0; k < sizeof(M) / 8; ++k)
+        {
+            any |= words[k];
+        }
+        return 0 != any;
+    }
+
+    // 一次检查4个向量,命中后在这4个向量里逐个找
+    template <size_t W, int Op, class E>
+    _LP_ALWAYS_INLINE size_t _vfind(const E *p, size_t n, E a, E b)
+    {
+        typedef typename _vec<E, W>::type V;
+        typedef typename _vmask<V>::type M;
+        const size_t L = W / sizeof(E);
+        const V va = V() + a, vb = V() + b;
+        size_t i = 0;
+        for (; i + 4 * L <= n; i += 4 * L)
+        {
+            V x0, x1, x2, x3;
+            memcpy(&x0, p + i, W);
+            memcpy(&x1, p + i + L, W);
+            memcpy(&x2, p + i + 2 * L, W);
+            memcpy(&x3, p + i + 3 * L, W);
+            M m0, m1, m2, m3;
+            _cmp<Op>(m0, x0, va, vb);
+            _cmp<Op>(m1, x1, va, vb);
+            _cmp<Op>(m2, x2, va, vb);
+            _cmp<Op>(m3, x3, va, vb);
+            if (_vany(m0 | m1 | m2 | m3))
+            {
+                break;
+            }
+        }
+        return i + _generic_find<Op>(p + i, n - i, a, b);
+    }
+
+    // 比较结果(全1为-1)从无符号的计数器中减去,计数器在溢出之前并入总数
+    template <size_t W, int Op, class E>
+    _LP_ALWAYS_INLINE size_t _vcount(const E *p, size_t n, E a, E b)
+    {
+        typedef typename _vec<E, W>::type V;
+        typedef typename _vmask<V>::type M;
+        typedef typename std::remove_reference<decltype(M()[0])>::type U;
+        const size_t L = W / sizeof(E);
+        // 每轮每个计数器最多加4
+        const size_t flush = sizeof(U) >= 4 ? ((size_t)1 << 30) - 1 : ((size_t)1 << (8 * sizeof(U))) / 4 - 1;
+        const V va = V() + a, vb = V() + b;
+        size_t total = 0, i = 0;
+        while (i + 4 * L <= n)
+        {
+            M acc = M();
+            for (size_t k = 0; k < flush && i + 4 * L <= n; ++k, i += 4 * L)
+            {
+                V x0, x1, x2, x3;
+                memcpy(&x0, p + i, W);
+                memcpy(&x1, p + i + L, W);
+                memcpy(&x2, p + i + 2 * L, W);
+                memcpy(&x3, p + i + 3 * L, W);
+                M m0, m1, m2, m3;
+                _cmp<Op>(m0, x0, va, vb);
+                _cmp<Op>(m1, x1, va, vb);
+                _cmp<Op>(m2, x2, va, vb);
+                _cmp<Op>(m3, x3, va, vb);
+                acc -= m0 + m1 + (m2 + m3);
+            }
+            for (size_t k = 0; k < L; ++k)
+            {
+                total += acc[k];
+            }
+        }
+        return total + _generic_count<Op>(p + i, n - i, a, b);
+    }
+
+    template <size_t W, class E>
+    _LP_ALWAYS_INLINE size_t _vmismatch(const E *p, const E *q, size_t n)
+    {
+        typedef typename _vec<E, W>::type V;
+        typedef typename _vmask<V>::type M;
+        const size_t L = W / sizeof(E);
+        size_t i = 0;
+        for (; i + 2 * L <= n; i += 2 * L)
+        {
+            V x0, x1, y0, y1;
+            memcpy(&x0, p + i, W);
+            memcpy(&x1, p + i + L, W);
+            memcpy(&y0, q + i, W);
+            memcpy(&y1, q + i + L, W);
+            if (_vany((M)(x0 != y0) | (M)(x1 != y1)))
+            {
+                break;
+            }
+        }
+        return i + _generic_mismatch(p + i, q + i, n - i);
+    }
+
+    // 按块求最值:每块用向量求出块内的最值,记下最值所在的块,最后只在那一块里找下标
+    // 遇到NaN返回false,由调用者逐个比较
+    template <size_t W, bool LastMax, class E>
+    _LP_ALWAYS_INLINE bool _vminmax(const E *p, size_t n, size_t *min_at, size_t *max_at)
+    {
+        typedef typename _vec<E, W>::type V;
+        const size_t L = W / sizeof(E), B = 64 * L;
+        E best_min = p[0], best_max = p[0];
+        size_t min_block = 0, max_block = 0;
+        bool nan = false;
+        for (size_t block = 0; block < n; block += B)
+        {
+            size_t end = block + B < n ? block + B : n, i = block;
+            E lo = p[block], hi = p[block];
+            if (end - block >= L)
+            {
+                V mn, mx, x;
+                memcpy(&mn, p + block, W);
+                mx = mn;
+                typename _vmask<V>::type odd = (typename _vmask<V>::type)(mn != mn);
+                for (i = block + L; i + L <= end; i += L)
+                {
+                    memcpy(&x, p + i, W);
+                    mn = x < mn ? x : mn;
+                    mx = x > mx ? x : mx;
+                    odd |= (typename _vmask<V>::type)(x != x);
+                }
+                if (_vany(odd))
+                {
+                    nan = true;
+                    break;
+                }
+                lo = mn[0];
+                hi = mx[0];
+                for (size_t k = 1; k < L; ++k)
+                {
+                    lo = mn[k] < lo ? mn[k] : lo;
+                    hi = mx[k] > hi ? mx[k] : hi;
+                }
+            }
+            for (; i < end; ++i)
+            {
+                if (p[i] != p[i])
+                {
+                    nan = true;
+                }
+                lo = p[i] < lo ? p[i] : lo;
+                hi = p[i] > hi ? p[i] : hi;
+            }
+            if (nan)
+            {
+                break;
+            }
+            if (lo < best_min)
+            {
+                best_min = lo;
+                min_block = block;
+            }
+            if (LastMax ? !(hi < best_max) : best_max < hi)
+            {
+                best_max = hi;
+                max_block = block;
+            }
+        }
+        if (nan)
+        {
+            return false;
+        }
+        size_t i = min_block;
+        while (!(p[i] == best_min))
+        {
+            ++i;
+        }
+        *min_at = i;
+        if (LastMax)
+        {
+            i = (max_block + B < n ? max_block + B : n) - 1;
+            while (!(p[i] == best_max))
+            {
+                --i;
+            }
+        }
+        else
+        {
+            i = max_block;
+            while (!(p[i] == best_max))
+            {
+                ++i;
+            }
+        }
+        *max_at = i;
+        return true;
+    }
+
+    // 整数:元素转换为T后在T宽度的无符号数上累加(与逐个相加同样回绕);浮点数(T与E相同):4组向量分别累加
+    // 每次读取W字节的元素(元素比T宽时读取W字节的T),累加器最多是元素的2倍宽,由编译器拆成多个向量
+    template <size_t W, class T, class E>
+    _LP_ALWAYS_INLINE T _vsum(const E *p, size_t n, T init, std::false_type)
+    {
+        typedef typename std::conditional<std::is_integral<T>::value, std::make_unsigned<T>, std::common_type<T>>::type::type U;
+        const size_t L = W / (sizeof(T) < sizeof(E) ? sizeof(T) : sizeof(E));
+        typedef typename _vec<U, L * sizeof(U)>::type VU;
+        typedef typename _vec<E, L * sizeof(E)>::type VE;
+        VU acc0 = VU(), acc1 = VU(), acc2 = VU(), acc3 = VU();
+        size_t i = 0;
+        for (; i + 4 * L <= n; i += 4 * L)
+        {
+            VE x0, x1, x2, x3;
+            memcpy(&x0, p + i, sizeof(VE));
+            memcpy(&x1, p + i + L, sizeof(VE));
+            memcpy(&x2, p + i + 2 * L, sizeof(VE));
+            memcpy(&x3, p + i + 3 * L, sizeof(VE));
+            acc0 += __builtin_convertvector(x0, VU);
+            acc1 += __builtin_convertvector(x1, VU);
+            acc2 += __builtin_convertvector(x2, VU);
+            acc3 += __builtin_convertvector(x3, VU);
+        }
+        acc0 += acc1 + (acc2 + acc3);
+        U sum = U();
+        for (size_t k = 0; k < L; ++k)
+        {
+            sum += acc0[k];
+        }
+        return _generic_sum(p + i, n - i, (T)(init + (T)sum));
+    }
+
+    // T比元素宽2倍以上(如uint8_t累加到int64_t):一次转换为T会被拆成逐个元素,
+    // 改为先累加到2倍宽,与元素符号相同的计数器中,在溢出之前并入总数
+    template <size_t W, class T, class E>
+    _LP_ALWAYS_INLINE T _vsum(const E *p, size_t n, T init, std::true_type)
+    {
+        typedef typename std::conditional<1 == sizeof(E), int16_t, int32_t>::type S;
+        typedef typename std::conditional<std::is_signed<E>::value, S, typename std::make_unsigned<S>::type>::type I;
+        typedef typename std::make_unsigned<T>::type U;
+        const size_t L = W / sizeof(E);
+        // 每轮每个计数器加一个元素,|元素| < 2^(8 * sizeof(E)),计数器能容纳2^(8 * sizeof(E)) - 1个
+        const size_t flush = ((size_t)1 << (8 * sizeof(E) - (std::is_signed<E>::value ? 1 : 0))) - 1;
+        typedef typename _vec<I, L * sizeof(I)>::type VI;
+        typedef typename _vec<E, W>::type VE;
+        U sum = U();
+        size_t i = 0;
+        while (i + 4 * L <= n)
+        {
+            VI acc0 = VI(), acc1 = VI(), acc2 = VI(), acc3 = VI();
+            for (size_t k = 0; k < flush && i + 4 * L <= n; ++k, i += 4 * L)
+            {
+                VE x0, x1, x2, x3;
+                memcpy(&x0, p + i, W);
+                memcpy(&x1, p + i + L, W);
+                memcpy(&x2, p + i + 2 * L, W);
+                memcpy(&x3, p + i + 3 * L, W);
+                acc0 += __builtin_convertvector(x0, VI);
+                acc1 += __builtin_convertvector(x1, VI);
+                acc2 += __builtin_convertvector(x2, VI);
+                acc3 += __builtin_convertvector(x3, VI);
+            }
+            for (size_t k = 0; k < L; ++k)
+            {
+                sum += (U)(T)acc0[k] + (U)(T)acc1[k] + (U)(T)acc2[k] + (U)(T)acc3[k];
+            }
+        }
+        return _generic_sum(p + i, n - i, (T)(init + (T)sum));
+    }
+
+    template <size_t W, class T, class E>
+    _LP_ALWAYS_INLINE T _vsum(const E *p, size_t n, T init)
+    {
+        return _vsum<W>(p, n, init, std::integral_constant<bool, (sizeof(T) > 2 * sizeof(E))>());
+    }
+    // endregion
+
+    // region:各级别的包装函数
+    template <int Op, class E>
+    _LP_TARGET("sse2") size_t _sse2_find(const E *p, size_t n, E a, E b) { return _vfind<16, Op>(p, n, a, b); }
+    template <int Op, class E>
+    _LP_TARGET("avx2") size_t _avx2_find(const E *p, size_t n, E a, E b) { return _vfind<32, Op>(p, n, a, b); }
+    template <int Op, class E>
+    _LP_TARGET("avx512f,avx512bw") size_t _avx512_find(const E *p, size_t n, E a, E b) { return _vfind<64, Op>(p, n, a, b); }
+
+    template <int Op, class E>
+    _LP_TARGET("sse2") size_t _sse2_count(const E *p, size_t n, E a, E b) { return _vcount<16, Op>(p, n, a, b); }
+    template <int Op, class E>
+    _LP_TARGET("avx2") size_t _avx2_count(const E *p, size_t n, E a, E b) { return _vcount<32, Op>(p, n, a, b); }
+    template <int Op, class E>
+    _LP_TARGET("avx512f,avx512bw") size_t _avx512_count(const E *p, size_t n, E a, E b) { return _vcount<64, Op>(p, n, a, b); }
+
+    template <class E>
+    _LP_TARGET("sse2") size_t _sse2_mismatch(const E *p, const E *q, size_t n) { return _vmismatch<16>(p, q, n); }
+    template <class E>
+    _LP_TARGET("avx2") size_t _avx2_mismatch(const E *p, const E *q, size_t n) { return _vmismatch<32>(p, q, n); }
+    template <class E>
+    _LP_TARGET("avx512f,avx512bw") size_t _avx512_mismatch(const E *p, const E *q, size_t n) { return _vmismatch<64>(p, q, n); }
+
+    template <bool LastMax, class E>
+    _LP_TARGET("sse2") bool _sse2_minmax(const E *p, size_t n, size_t *lo, size_t *hi) { return _vminmax<16, LastMax>(p, n, lo, hi); }
+    template <bool LastMax, class E>
+    _LP_TARGET("avx2") bool _avx2_minmax(const E *p, size_t n, size_t *lo, size_t *hi) { return _vminmax<32, LastMax>(p, n, lo, hi); }
+    template <bool LastMax, class E>
+    _LP_TARGET("avx512f,avx512bw") bool _avx512_minmax(const E *p, size_t n, size_t *lo, size_t *hi) { return _vminmax<64, LastMax>(p, n, lo, hi); }
+
+    template <class T, class E>
+    _LP_TARGET("sse2") T _sse2_sum(const E *p, size_t n, T init) { return _vsum<16>(p, n, init); }
+    template <class T, class E>
+    _LP_TARGET("avx2") T _avx2_sum(const E *p, size_t n, T init) { return _vsum<32>(p, n, init); }
+    template <class T, class E>
+    _LP_TARGET("avx512f,avx512bw") T _avx512_sum(const E *p, size_t n, T init) { return _vsum<64>(p, n, init); }
+    // endregion
+#endif // _LP_SCAN_X86
+
+    // region:分发
+    // CPU支持的最高级别;AVX-512的内核按字节比较,还需要avx512bw
+    inline int _best_scan_level()
+    {
+#ifdef _LP_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        {
+            return _SIMD_AVX512;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return _SIMD_AVX2;
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return _SIMD_SSE2;
+        }
+#endif
+        return _SIMD_GENERIC;
+    }
+
+    // 扫描算法使用的级别,第一次调用时按CPUID选定;可以改为更低的级别,不能高于CPU支持的级别
+    inline int &simd_scan_level()
+    {
+        static int level = _best_scan_level();
+        return level;
+    }
+
+    // 更短的区间直接用通用内核
+    enum
+    {
+        _SIMD_SCAN_MIN = 32
+    };
+
+#ifdef _LP_SCAN_X86
+#define _LP_SCAN_DISPATCH(n, name, targs, args)              \
+    if ((n) >= _SIMD_SCAN_MIN)                               \
+    {                                                        \
+        switch (simd_scan_level())                           \
+        {                                                    \
+        case _SIMD_AVX512:                                   \
+            return _avx512_##name targs args;                \
+        case _SIMD_AVX2:                                     \
+            return _avx2_##name targs args;                  \
+        case _SIMD_SSE2:                                     \
+            return _sse2_##name targs args;                  \
+        }                                                    \
+    }                                                        \
+    return _generic_##name targs args;
+#else
+#define _LP_SCAN_DISPATCH(n, name, targs, args) return _generic_##name targs args;
+#endif
+
+    template <int Op, class E>
+    inline size_t _simd_find(const E *p, size_t n, E a, E b)
+    {
+        _LP_SCAN_DISPATCH(n, find, <Op>, (p, n, a, b))
+    }
+
+    template <int Op, class E>
+    inline size_t _simd_count(const E *p, size_t n, E a, E b)
+    {
+        _LP_SCAN_DISPATCH(n, count, <Op>, (p, n, a, b))
+    }
+
+    template <class E>
+    inline size_t _simd_mismatch(const E *p, const E *q, size_t n)
+    {
+        _LP_SCAN_DISPATCH(n, mismatch, <E>, (p, q, n))
+    }
+
+    // 向量内核遇到NaN时退回通用内核
+    template <bool LastMax, class E>
+    inline bool _simd_minmax_kernel(const E *p, size_t n, size_t *lo, size_t *hi)
+    {
+        _LP_SCAN_DISPATCH(n, minmax, <LastMax>, (p, n, lo, hi))
+    }
+
+    template <bool LastMax, class E>
+    inline void _simd_minmax(const E *p, size_t n, size_t *lo, size_t *hi)
+    {
+        if (!_simd_minmax_kernel<LastMax>(p, n, lo, hi))
+        {
+            _generic_minmax<LastMax>(p, n, lo, hi);
+        }
+    }
+
+    template <class T, class E>
+    inline T _simd_sum(const E *p, size_t n, T init)
+    {
+        _LP_SCAN_DISPATCH(n, sum, <T>, (p, n, init))
+    }
+#undef _LP_SCAN_DISPATCH
+    // endregion
+
+    // 可以向量化扫描的元素类型
+    template <class E>
+    struct _is_simd_scannable
+        : std::integral_constant<bool, (std::is_integral<E>::value && !std::is_same<E, bool>::value) ||
+                                           std::is_same<E, float>::value || std::is_same<E, double>::value>
+    {
+    };
+} // namespace lp
+
+#endif // LP_SIMD_SCAN_H
@@ -0,0 +1,1041 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+排序算法:sort,stable_sort,radix_sort,都要求随机访问迭代器
+sort是pattern-defeating quicksort(pdqsort,Orson Peters):
+ * 小于_INSERTION_SORT_THRESHOLD个元素的区间用插入排序
+ * 枢轴取三点中值,区间大于_NINTHER_THRESHOLD时取九点的近似中值
+ * 划分时与枢轴相等的元素放在右边;若枢轴与左边界外的元素相等,说明区间里有大量重复元素,
+   改为把相等的元素放在左边,左边不必再排序,few-unique的输入因此是O(nk)
+ * 划分时一次交换都没有(区间可能已经有序),先试着做有限步数的插入排序,有序/逆序的输入因此是O(n)
+ * 划分严重不均时打乱几个元素破坏输入的模式,次数超过logn后改为堆排序,保证最坏O(nlogn)
+ * 元素是算术类型且比较为默认的小于(或std::less/std::greater)时,用BlockQuicksort的无分支划分:
+   先把一块中放错边的元素的偏移记下来,再成对交换,比较的结果不参与分支
+stable_sort是带缓冲区的归并排序:
+ * 小于_STABLE_SORT_THRESHOLD个元素的区间用插入排序
+ * 两半已经首尾有序时跳过归并;整个区间严格递减时直接反转
+ * 缓冲区为元素个数的一半,来自本线程缓存的_sort_buffer_cache,反复排序时不再重新分配
+radix_sort是LSD基数排序,稳定:
+ * 键为整数或float/double,radix_sort(first,last,key)用key(x)提取键(如结构体中的某个成员)
+ * 每趟处理11位(64位的键6趟,32位的键3趟),一次遍历统计所有趟的计数;某一趟所有元素的这几位都相同时跳过这一趟
+ * 有符号整数翻转符号位,浮点数负数按位取反,正数翻转符号位,按无符号整数排序
+   (-0.0排在+0.0之前,负NaN排在最前,正NaN排在最后)
+ * 辅助空间为n个元素加上计数,与stable_sort共用缓冲区
+*/
+#ifndef LP_SORT_H
+#define LP_SORT_H
+
+#include <cstddef>     //for size_t
+#include <cstring>     //for memcpy
+#include <functional>  //for std::less,std::greater
+#include <new>         //for placement new
+#include <stdint.h>    //for uintptr_t,uint32_t,uint64_t
+#include <type_traits> //for std::is_arithmetic等
+#include <utility>     //for std::move,std::pair
+#include "../1_allocator/lp_alloc.h"
+#include "../1_allocator/lp_uninitialized.h"
+#include "lp_algobase.h"
+#include "lp_heap.h"
+
+namespace lp
+{
+    // region:排序用的缓冲区
+    enum
+    {
+        _SORT_BUFFER_ALIGN = 64,     // 缓冲区按缓存行对齐
+        _SORT_BUFFER_MIN = 4 * 1024  // 缓冲区的最小字节数,大于二级配置器的_MAX_BYTES,总是来自一级配置器,多线程下也安全
+    };
+
+    // 每个线程缓存一块由lp::alloc分配的缓冲区,只增不减,线程退出时释放
+    class _sort_buffer_cache
+    {
+    public:
+        _sort_buffer_cache() : data(0), size(0), busy(false) {}
+        ~_sort_buffer_cache()
+        {
+            destroyed() = true;
+            release();
+        }
+        _sort_buffer_cache(const _sort_buffer_cache &) = delete;
+        _sort_buffer_cache &operator=(const _sort_buffer_cache &) = delete;
+
+        // 取得至少bytes字节的缓冲区;正在使用中(比较函数里又调用了排序)时返回0
+        void *acquire(size_t bytes)
+        {
+            if (busy)
+            {
+                return 0;
+            }
+            if (bytes > size)
+            {
+                release();
+                size = bytes < (size_t)_SORT_BUFFER_MIN ? (size_t)_SORT_BUFFER_MIN : bytes;
+                data = alloc::allocate_aligned(size, _SORT_BUFFER_ALIGN);
+            }
+            busy = true;
+            return data;
+        }
+        void unlock() { busy = false; }
+        void release()
+        {
+            if (0 != data && !busy)
+            {
+                alloc::deallocate_aligned(data, size, _SORT_BUFFER_ALIGN);
+                data = 0;
+                size = 0;
+            }
+        }
+
+        // 本线程的缓存;线程退出阶段已析构时返回0
+        static _sort_buffer_cache *local()
+        {
+            if (destroyed())
+            {
+                return 0;
+            }
+            static thread_local _sort_buffer_cache cache;
+            return &cache;
+        }
+
+    private:
+        void *data;
+        size_t size;
+        bool busy;
+
+        // 析构标志放在平凡析构的bool里,缓存析构之后仍可读
+        static bool &destroyed()
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+    };
+
+    // 释放本线程缓存的排序缓冲区,例如排序完一大批数据之后
+    inline void release_sort_buffer()
+    {
+        _sort_buffer_cache *cache = _sort_buffer_cache::local();
+        if (0 != cache)
+        {
+            cache->release();
+        }
+    }
+
+    // 至少bytes字节,按align对齐的未初始化缓冲区,优先使用本线程缓存的那块
+    class _sort_buffer
+    {
+    public:
+        _sort_buffer(size_t n, size_t align)
+            : cache(0), bytes(n), alignment(align < (size_t)_SORT_BUFFER_ALIGN ? (size_t)_SORT_BUFFER_ALIGN : align)
+        {
+            if (alignment == (size_t)_SORT_BUFFER_ALIGN && 0 != (cache = _sort_buffer_cache::local()))
+            {
+                buf = cache->acquire(bytes);
+                if (0 != buf)
+                {
+                    return;
+                }
+                cache = 0;
+            }
+            bytes = bytes < (size_t)_SORT_BUFFER_MIN ? (size_t)_SORT_BUFFER_MIN : bytes;
+            buf = alloc::allocate_aligned(bytes, alignment);
+        }
+        ~_sort_buffer()
+        {
+            if (0 != cache)
+            {
+                cache->unlock();
+            }
+            else
+            {
+                alloc::deallocate_aligned(buf, bytes, alignment);
+            }
+        }
+        _sort_buffer(const _sort_buffer &) = delete;
+        _sort_buffer &operator=(const _sort_buffer &) = delete;
+
+        void *data() const { return buf; }
+
+    private:
+        _sort_buffer_cache *cache; // 为0时缓冲区是自己分配的
+        size_t bytes;
+        size_t alignment;
+        void *buf;
+    };
+    // endregion
+
+    // region:插入排序
+    // 2^k <= n的最大k
+    template <class Size>
+    inline Size _lg(Size n)
+    {
+        Size k = 0;
+        for (; n > 1; n >>= 1)
+        {
+            ++k;
+        }
+        return k;
+    }
+
+    // 把value插入到last之前的有序区间,调用者保证左边一定有不大于value的元素,不必检查边界
+    template <class RandomAccessIterator, class Compare>
+    void _unguarded_linear_insert(RandomAccessIterator last, Compare comp)
+    {
+        typename iterator_traits<RandomAccessIterator>::value_type value = std::move(*last);
+        RandomAccessIterator next = last;
+        --next;
+        while (comp(value, *next))
+        {
+            *last = std::move(*next);
+            last = next;
+            --next;
+        }
+        *last = std::move(value);
+    }
+
+    // 稳定
+    template <class RandomAccessIterator, class Compare>
+    void _insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        if (first == last)
+        {
+            return;
+        }
+        for (RandomAccessIterator i = first + 1; i != last; ++i)
+        {
+            if (comp(*i, *first))
+            {
+                // 比头还小,整段后移一格
+                typename iterator_traits<RandomAccessIterator>::value_type value = std::move(*i);
+                lp::move_backward(first, i, i + 1);
+                *first = std::move(value);
+            }
+            else
+            {
+                _unguarded_linear_insert(i, comp);
+            }
+        }
+    }
+
+    // *(first - 1)不大于区间内所有元素
+    template <class RandomAccessIterator, class Compare>
+    inline void _unguarded_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        for (RandomAccessIterator i = first; i != last; ++i)
+        {
+            _unguarded_linear_insert(i, comp);
+        }
+    }
+
+    // 插入排序,但移动的总步数超过_PARTIAL_INSERTION_SORT_LIMIT就放弃,返回是否已排好
+    enum
+    {
+        _PARTIAL_INSERTION_SORT_LIMIT = 8
+    };
+
+    template <class RandomAccessIterator, class Compare>
+    bool _partial_insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        if (first == last)
+        {
+            return true;
+        }
+        size_t moves = 0;
+        for (RandomAccessIterator i = first + 1; i != last; ++i)
+        {
+            if (comp(*i, *(i - 1)))
+            {
+                typename iterator_traits<RandomAccessIterator>::value_type value = std::move(*i);
+                RandomAccessIterator hole = i;
+                do
+                {
+                    *hole = std::move(*(hole - 1));
+                    --hole;
+                } while (hole != first && comp(value, *(hole - 1)));
+                *hole = std::move(value);
+                moves += i - hole;
+            }
+            if (moves > _PARTIAL_INSERTION_SORT_LIMIT)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    // endregion
+
+    // region:划分
+    // 把a,b,c的中值交换到result
+    template <class RandomAccessIterator, class Compare>
+    void _move_median_to_first(RandomAccessIterator result, RandomAccessIterator a, RandomAccessIterator b,
+                               RandomAccessIterator c, Compare comp)
+    {
+        if (comp(*a, *b))
+        {
+            if (comp(*b, *c))
+            {
+                lp::iter_swap(result, b);
+            }
+            else if (comp(*a, *c))
+            {
+                lp::iter_swap(result, c);
+            }
+            else
+            {
+                lp::iter_swap(result, a);
+            }
+        }
+        else if (comp(*a, *c))
+        {
+            lp::iter_swap(result, a);
+        }
+        else if (comp(*b, *c))
+        {
+            lp::iter_swap(result, c);
+        }
+        else
+        {
+            lp::iter_swap(result, b);
+        }
+    }
+
+    // 以*pivot划分[first,last),两端各有一个不小于/不大于枢轴的哨兵,循环内不检查边界
+    // 与枢轴相等的元素两边都会停下交换,大量重复元素时也能均分,并行sort用它切分任务
+    template <class RandomAccessIterator, class Compare>
+    RandomAccessIterator _unguarded_partition(RandomAccessIterator first, RandomAccessIterator last,
+                                              RandomAccessIterator pivot, Compare comp)
+    {
+        for (;;)
+        {
+            while (comp(*first, *pivot))
+            {
+                ++first;
+            }
+            --last;
+            while (comp(*pivot, *last))
+            {
+                --last;
+            }
+            if (!(first < last))
+            {
+                return first;
+            }
+            lp::iter_swap(first, last);
+            ++first;
+        }
+    }
+
+    // 三点中值放到first作枢轴,划分[first + 1,last),返回右半段的头
+    template <class RandomAccessIterator, class Compare>
+    inline RandomAccessIterator _unguarded_partition_pivot(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        RandomAccessIterator mid = first + (last - first) / 2;
+        _move_median_to_first(first, first + 1, mid, last - 1, comp);
+        return _unguarded_partition(first + 1, last, first, comp);
+    }
+
+    // 堆排序,递归过深时使用
+    template <class RandomAccessIterator, class Compare>
+    inline void _heap_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        lp::make_heap(first, last, comp);
+        lp::sort_heap(first, last, comp);
+    }
+
+    enum
+    {
+        _INSERTION_SORT_THRESHOLD = 24, // 小于此长度的区间用插入排序
+        _NINTHER_THRESHOLD = 128,       // 大于此长度的区间取九点的近似中值作枢轴
+        _PARTITION_BLOCK = 64,          // 无分支划分一次记录的元素个数,偏移用unsigned char保存
+        _CACHELINE = 64
+    };
+
+    template <class RandomAccessIterator, class Compare>
+    inline void _sort2(RandomAccessIterator a, RandomAccessIterator b, Compare comp)
+    {
+        if (comp(*b, *a))
+        {
+            lp::iter_swap(a, b);
+        }
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void _sort3(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare comp)
+    {
+        _sort2(a, b, comp);
+        _sort2(b, c, comp);
+        _sort2(a, b, comp);
+    }
+
+    // 把枢轴放到first:三点中值,或九点的近似中值
+    template <class RandomAccessIterator, class Compare>
+    void _choose_pivot(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        typename iterator_traits<RandomAccessIterator>::difference_type len = last - first, half = len / 2;
+        if (len > _NINTHER_THRESHOLD)
+        {
+            _sort3(first, first + half, last - 1, comp);
+            _sort3(first + 1, first + (half - 1), last - 2, comp);
+            _sort3(first + 2, first + (half + 1), last - 3, comp);
+            _sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            lp::iter_swap(first, first + half);
+        }
+        else
+        {
+            _sort3(first + half, first, last - 1, comp);
+        }
+    }
+
+    // 以*first为枢轴划分,小于枢轴的在左,不小于的在右,返回枢轴的最终位置,以及划分前是否已经分好(没有交换)
+    // 调用者保证区间里有不小于枢轴的元素(选枢轴时的三点之一),向右找时不必检查边界
+    template <class RandomAccessIterator, class Compare>
+    std::pair<RandomAccessIterator, bool> _partition_right(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        typename iterator_traits<RandomAccessIterator>::value_type pivot = std::move(*first);
+        RandomAccessIterator begin = first;
+        while (comp(*++first, pivot))
+        {
+        }
+        // first前面没有元素时,向左找必须检查边界
+        if (first - 1 == begin)
+        {
+            while (first < last && !comp(*--last, pivot))
+            {
+            }
+        }
+        else
+        {
+            while (!comp(*--last, pivot))
+            {
+            }
+        }
+        bool already_partitioned = first >= last;
+        // 之前交换过的一对元素就是之后查找的哨兵
+        while (first < last)
+        {
+            lp::iter_swap(first, last);
+            while (comp(*++first, pivot))
+            {
+            }
+            while (!comp(*--last, pivot))
+            {
+            }
+        }
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 把num对放错边的元素交换到对面;两边个数相等时逐对交换(逆序输入需要),否则轮转,移动次数更少
+    template <class RandomAccessIterator>
+    inline void _swap_offsets(RandomAccessIterator first, RandomAccessIterator last, const unsigned char *offsets_l,
+                              const unsigned char *offsets_r, size_t num, bool use_swaps)
+    {
+        if (use_swaps)
+        {
+            for (size_t i = 0; i < num; ++i)
+            {
+                lp::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+            }
+        }
+        else if (num > 0)
+        {
+            RandomAccessIterator l = first + offsets_l[0], r = last - offsets_r[0];
+            typename iterator_traits<RandomAccessIterator>::value_type tmp = std::move(*l);
+            *l = std::move(*r);
+            for (size_t i = 1; i < num; ++i)
+            {
+                l = first + offsets_l[i];
+                *r = std::move(*l);
+                r = last - offsets_r[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+
+    // 与_partition_right相同,但用BlockQuicksort(Edelkamp,Weiss)的方式:
+    // 左右各取一块,把放错边的元素的偏移无分支地记下来(num += !comp(...)),再成对交换
+    template <class RandomAccessIterator, class Compare>
+    std::pair<RandomAccessIterator, bool> _partition_right_branchless(RandomAccessIterator first, RandomAccessIterator last,
+                                                                      Compare comp)
+    {
+        typename iterator_traits<RandomAccessIterator>::value_type pivot = std::move(*first);
+        RandomAccessIterator begin = first;
+        while (comp(*++first, pivot))
+        {
+        }
+        if (first - 1 == begin)
+        {
+            while (first < last && !comp(*--last, pivot))
+            {
+            }
+        }
+        else
+        {
+            while (!comp(*--last, pivot))
+            {
+            }
+        }
+        bool already_partitioned = first >= last;
+        if (!already_partitioned)
+        {
+            lp::iter_swap(first, last);
+            ++first;
+
+            unsigned char offsets_l_storage[_PARTITION_BLOCK + _CACHELINE];
+            unsigned char offsets_r_storage[_PARTITION_BLOCK + _CACHELINE];
+            unsigned char *offsets_l = (unsigned char *)(((uintptr_t)offsets_l_storage + _CACHELINE - 1) & ~(uintptr_t)(_CACHELINE - 1));
+            unsigned char *offsets_r = (unsigned char *)(((uintptr_t)offsets_r_storage + _CACHELINE - 1) & ~(uintptr_t)(_CACHELINE - 1));
+            RandomAccessIterator offsets_l_base = first, offsets_r_base = last;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while (first < last)
+            {
+                // 只给空了的一边取新的一块;剩余不足两块时两边分掉剩下的元素
+                size_t num_unknown = last - first;
+                size_t left_split = 0 == num_l ? (0 == num_r ? num_unknown / 2 : num_unknown) : 0;
+                size_t right_split = 0 == num_r ? num_unknown - left_split : 0;
+
+                if (left_split >= (size_t)_PARTITION_BLOCK)
+                {
+                    for (size_t i = 0; i < (size_t)_PARTITION_BLOCK;)
+                    {
+                        offsets_l[num_l] = (unsigned char)i++;
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = (unsigned char)i++;
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = (unsigned char)i++;
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                        offsets_l[num_l] = (unsigned char)i++;
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < left_split;)
+                    {
+                        offsets_l[num_l] = (unsigned char)i++;
+                        num_l += !comp(*first, pivot);
+                        ++first;
+                    }
+                }
+
+                if (right_split >= (size_t)_PARTITION_BLOCK)
+                {
+                    for (size_t i = 0; i < (size_t)_PARTITION_BLOCK;)
+                    {
+                        offsets_r[num_r] = (unsigned char)++i;
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = (unsigned char)++i;
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = (unsigned char)++i;
+                        num_r += comp(*--last, pivot);
+                        offsets_r[num_r] = (unsigned char)++i;
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+                else
+                {
+                    for (size_t i = 0; i < right_split;)
+                    {
+                        offsets_r[num_r] = (unsigned char)++i;
+                        num_r += comp(*--last, pivot);
+                    }
+                }
+
+                size_t num = lp::min(num_l, num_r);
+                _swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (0 == num_l)
+                {
+                    start_l = 0;
+                    offsets_l_base = first;
+                }
+                if (0 == num_r)
+                {
+                    start_r = 0;
+                    offsets_r_base = last;
+                }
+            }
+
+            // 一边还有放错的元素,逐个换到分界处
+            if (0 != num_l)
+            {
+                offsets_l += start_l;
+                while (num_l--)
+                {
+                    lp::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+                }
+                first = last;
+            }
+            if (0 != num_r)
+            {
+                offsets_r += start_r;
+                while (num_r--)
+                {
+                    lp::iter_swap(offsets_r_base - offsets_r[num_r], first);
+                    ++first;
+                }
+            }
+        }
+        RandomAccessIterator pivot_pos = first - 1;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::pair<RandomAccessIterator, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 以*first为枢轴划分,不大于枢轴的在左,大于的在右,返回枢轴的最终位置
+    // 只在枢轴等于左边界外的元素时使用,此时左边全都等于枢轴
+    template <class RandomAccessIterator, class Compare>
+    RandomAccessIterator _partition_left(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        typename iterator_traits<RandomAccessIterator>::value_type pivot = std::move(*first);
+        RandomAccessIterator begin = first, end = last;
+        while (comp(pivot, *--last))
+        {
+        }
+        if (last + 1 == end)
+        {
+            while (first < last && !comp(pivot, *++first))
+            {
+            }
+        }
+        else
+        {
+            while (!comp(pivot, *++first))
+            {
+            }
+        }
+        while (first < last)
+        {
+            lp::iter_swap(first, last);
+            while (comp(pivot, *--last))
+            {
+            }
+            while (!comp(pivot, *++first))
+            {
+            }
+        }
+        *begin = std::move(*last);
+        *last = std::move(pivot);
+        return last;
+    }
+    // endregion
+
+    // region:sort
+    // 元素是算术类型,比较是默认的小于(或std::less/std::greater)时用无分支划分
+    template <class T, class Compare>
+    struct _is_branchless_sort
+        : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                           (std::is_same<Compare, _less>::value ||
+                                            std::is_same<Compare, std::less<T>>::value ||
+                                            std::is_same<Compare, std::greater<T>>::value)>
+    {
+    };
+
+    template <class RandomAccessIterator, class Compare>
+    inline std::pair<RandomAccessIterator, bool> _pdq_partition(RandomAccessIterator first, RandomAccessIterator last,
+                                                                Compare comp, std::true_type)
+    {
+        return _partition_right_branchless(first, last, comp);
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline std::pair<RandomAccessIterator, bool> _pdq_partition(RandomAccessIterator first, RandomAccessIterator last,
+                                                                Compare comp, std::false_type)
+    {
+        return _partition_right(first, last, comp);
+    }
+
+    // 划分严重不均时交换几个元素,打破导致枢轴选得差的模式
+    template <class RandomAccessIterator, class Distance>
+    void _break_patterns(RandomAccessIterator first, RandomAccessIterator pivot_pos, RandomAccessIterator last,
+                         Distance l_size, Distance r_size)
+    {
+        if (l_size >= _INSERTION_SORT_THRESHOLD)
+        {
+            lp::iter_swap(first, first + l_size / 4);
+            lp::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+            if (l_size > _NINTHER_THRESHOLD)
+            {
+                lp::iter_swap(first + 1, first + (l_size / 4 + 1));
+                lp::iter_swap(first + 2, first + (l_size / 4 + 2));
+                lp::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                lp::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+            }
+        }
+        if (r_size >= _INSERTION_SORT_THRESHOLD)
+        {
+            lp::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+            lp::iter_swap(last - 1, last - r_size / 4);
+            if (r_size > _NINTHER_THRESHOLD)
+            {
+                lp::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                lp::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                lp::iter_swap(last - 2, last - (1 + r_size / 4));
+                lp::iter_swap(last - 3, last - (2 + r_size / 4));
+            }
+        }
+    }
+
+    // leftmost为false时*(first - 1)是上一次划分的枢轴,不大于区间内所有元素
+    // bad_allowed为还允许的严重不均的划分次数
+    template <class RandomAccessIterator, class Compare, class Branchless>
+    void _pdqsort_loop(RandomAccessIterator first, RandomAccessIterator last, Compare comp, int bad_allowed,
+                       bool leftmost, Branchless branchless)
+    {
+        using Distance = typename iterator_traits<RandomAccessIterator>::difference_type;
+        for (;;)
+        {
+            Distance len = last - first;
+            if (len < _INSERTION_SORT_THRESHOLD)
+            {
+                if (leftmost)
+                {
+                    _insertion_sort(first, last, comp);
+                }
+                else
+                {
+                    _unguarded_insertion_sort(first, last, comp);
+                }
+                return;
+            }
+
+            _choose_pivot(first, last, comp);
+            // 枢轴不大于左边界外的元素,即等于它:区间里没有更小的元素,把相等的都放到左边,左边不必再排
+            if (!leftmost && !comp(*(first - 1), *first))
+            {
+                first = _partition_left(first, last, comp) + 1;
+                continue;
+            }
+
+            std::pair<RandomAccessIterator, bool> part = _pdq_partition(first, last, comp, branchless);
+            RandomAccessIterator pivot_pos = part.first;
+            Distance l_size = pivot_pos - first, r_size = last - (pivot_pos + 1);
+            if (l_size < len / 8 || r_size < len / 8)
+            {
+                if (0 == --bad_allowed)
+                {
+                    _heap_sort(first, last, comp);
+                    return;
+                }
+                _break_patterns(first, pivot_pos, last, l_size, r_size);
+            }
+            else if (part.second && _partial_insertion_sort(first, pivot_pos, comp) &&
+                     _partial_insertion_sort(pivot_pos + 1, last, comp))
+            {
+                // 划分前就已分好,两边用少量插入就排好了,多半是有序的输入
+                return;
+            }
+
+            // 递归处理左半段,循环处理右半段
+            _pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+            first = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        if (last - first > 1)
+        {
+            _pdqsort_loop(first, last, comp, (int)_lg(last - first), true, _is_branchless_sort<T, Compare>());
+        }
+    }
+
+    template <class RandomAccessIterator>
+    inline void sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::sort(first, last, _less());
+    }
+    // endregion
+
+    // region:stable_sort
+    enum
+    {
+        _STABLE_SORT_THRESHOLD = 32 // 小于此长度的区间用插入排序
+    };
+
+    // 把[first,middle)移到buf,再与[middle,last)归并回first,相等时左边的在前
+    template <class RandomAccessIterator, class T, class Compare>
+    void _merge_with_buffer(RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, T *buf,
+                            Compare comp)
+    {
+        T *buf_last = lp::uninitialized_move(first, middle, buf), *b = buf;
+        RandomAccessIterator result = first;
+        try
+        {
+            while (b != buf_last && middle != last)
+            {
+                if (comp(*middle, *b))
+                {
+                    *result = std::move(*middle);
+                    ++middle;
+                }
+                else
+                {
+                    *result = std::move(*b);
+                    ++b;
+                }
+                ++result;
+            }
+        }
+        catch (...)
+        {
+            // [result,middle)正好空出buf_last - b个位置,放回缓冲区中剩下的元素,区间里不丢元素
+            lp::move(b, buf_last, result);
+            lp::destroy(buf, buf_last);
+            throw;
+        }
+        // 右半段剩下的已在原位
+        lp::move(b, buf_last, result);
+        lp::destroy(buf, buf_last);
+    }
+
+    // buf至少能容纳(last - first) / 2个元素
+    template <class RandomAccessIterator, class T, class Compare>
+    void _merge_sort_with_buffer(RandomAccessIterator first, RandomAccessIterator last, T *buf, Compare comp)
+    {
+        if (last - first < _STABLE_SORT_THRESHOLD)
+        {
+            _insertion_sort(first, last, comp);
+            return;
+        }
+        RandomAccessIterator middle = first + (last - first) / 2;
+        _merge_sort_with_buffer(first, middle, buf, comp);
+        _merge_sort_with_buffer(middle, last, buf, comp);
+        if (comp(*middle, *(middle - 1)))
+        {
+            _merge_with_buffer(first, middle, last, buf, comp);
+        }
+    }
+
+    // 区间严格递减时反转,返回是否反转了;遇到第一对非递减的元素就停止
+    template <class RandomAccessIterator, class Compare>
+    bool _reverse_if_descending(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        for (RandomAccessIterator i = first + 1; i != last; ++i)
+        {
+            if (!comp(*i, *(i - 1)))
+            {
+                return false;
+            }
+        }
+        for (--last; first < last; ++first, --last)
+        {
+            lp::iter_swap(first, last);
+        }
+        return true;
+    }
+
+    template <class RandomAccessIterator, class Compare>
+    void stable_sort(RandomAccessIterator first, RandomAccessIterator last, Compare comp)
+    {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        size_t n = last - first;
+        if (n < (size_t)_STABLE_SORT_THRESHOLD)
+        {
+            _insertion_sort(first, last, comp);
+            return;
+        }
+        if (comp(*(last - 1), *first) && _reverse_if_descending(first, last, comp))
+        {
+            return;
+        }
+        _sort_buffer buf(n / 2 * sizeof(T), alignof(T));
+        _merge_sort_with_buffer(first, last, (T *)buf.data(), comp);
+    }
+
+    template <class RandomAccessIterator>
+    inline void stable_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::stable_sort(first, last, _less());
+    }
+    // endregion
+
+    // region:radix_sort
+    enum
+    {
+        _RADIX_BITS = 11, // 每趟处理的位数,64位的键6趟
+        _RADIX_BUCKETS = 1 << _RADIX_BITS,
+        _RADIX_SORT_THRESHOLD = 1024 // 更短的区间用stable_sort比较编码后的键
+    };
+
+    // 把键编码为无符号整数,无符号整数的顺序就是键的顺序
+    template <class Key, class Enable = void>
+    struct _radix_key;
+
+    template <class Key>
+    struct _radix_key<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_unsigned<Key>::value>::type>
+    {
+        using type = Key;
+        static type encode(Key k) { return k; }
+    };
+
+    // 有符号整数翻转符号位
+    template <class Key>
+    struct _radix_key<Key, typename std::enable_if<std::is_integral<Key>::value && std::is_signed<Key>::value>::type>
+    {
+        using type = typename std::make_unsigned<Key>::type;
+        static type encode(Key k) { return (type)((type)k ^ ((type)1 << (sizeof(Key) * 8 - 1))); }
+    };
+
+    // IEEE浮点数:负数按位取反(绝对值越大越小),正数翻转符号位(排在所有负数之后)
+    template <class Key>
+    struct _radix_key<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>
+    {
+        static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "radix_sort supports float and double keys");
+        using type = typename std::conditional<sizeof(Key) == 4, uint32_t, uint64_t>::type;
+        static type encode(Key k)
+        {
+            type bits;
+            memcpy(&bits, &k, sizeof(bits));
+            const type sign = (type)1 << (sizeof(type) * 8 - 1);
+            return 0 != (bits & sign) ? (type)~bits : (type)(bits | sign);
+        }
+    };
+
+    // 默认的键就是元素自身
+    struct _identity_key
+    {
+        template <class T>
+        const T &operator()(const T &x) const { return x; }
+    };
+
+    template <class KeyOf, class T>
+    using _radix_key_of = _radix_key<typename std::decay<decltype(std::declval<KeyOf &>()(std::declval<const T &>()))>::type>;
+
+    // 短区间的比较:按编码后的键比较,与基数排序的顺序完全相同
+    template <class KeyOf, class Encoder>
+    struct _radix_less
+    {
+        KeyOf key;
+        template <class T>
+        bool operator()(const T &a, const T &b) const { return Encoder::encode(key(a)) < Encoder::encode(key(b)); }
+    };
+
+    // 按从shift开始的一位数字把src的n个元素分配到dst,offsets为各桶的下一个位置
+    // Construct为true时dst是未初始化的缓冲区
+    template <class Encoder, class Source, class Dest, class KeyOf>
+    void _radix_scatter(Source src, size_t n, Dest dst, KeyOf &key, unsigned shift, size_t *offsets, std::false_type)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t d = (size_t)(Encoder::encode(key(src[i])) >> shift) & (_RADIX_BUCKETS - 1);
+            dst[offsets[d]++] = std::move(src[i]);
+        }
+    }
+
+    template <class Encoder, class Source, class T, class KeyOf>
+    void _radix_scatter(Source src, size_t n, T *dst, KeyOf &key, unsigned shift, size_t *offsets, std::true_type)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            size_t d = (size_t)(Encoder::encode(key(src[i])) >> shift) & (_RADIX_BUCKETS - 1);
+            new (dst + offsets[d]++) T(std::move(src[i]));
+        }
+    }
+
+    template <class RandomAccessIterator, class KeyOf>
+    void radix_sort(RandomAccessIterator first, RandomAccessIterator last, KeyOf key)
+    {
+        using T = typename iterator_traits<RandomAccessIterator>::value_type;
+        using Encoder = _radix_key_of<KeyOf, T>;
+        using U = typename Encoder::type;
+        static_assert(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                      "radix_sort moves elements between the range and a buffer and cannot recover from a throwing move");
+        enum
+        {
+            _PASSES = (sizeof(U) * 8 + _RADIX_BITS - 1) / _RADIX_BITS
+        };
+        size_t n = last - first;
+        if (n < (size_t)_RADIX_SORT_THRESHOLD)
+        {
+            _radix_less<KeyOf, Encoder> comp = {key};
+            lp::stable_sort(first, last, comp);
+            return;
+        }
+
+        // 缓冲区前面放n个元素,后面是每一趟各个桶的计数(太大,不放在栈上)
+        size_t counts_at = (n * sizeof(T) + alignof(size_t) - 1) & ~(alignof(size_t) - 1);
+        _sort_buffer buf(counts_at + sizeof(size_t) * _PASSES * _RADIX_BUCKETS, alignof(T));
+        T *tmp = (T *)buf.data();
+        size_t(*counts)[_RADIX_BUCKETS] = (size_t(*)[_RADIX_BUCKETS])((char *)buf.data() + counts_at);
+        lp::fill_n(counts[0], (size_t)_PASSES * _RADIX_BUCKETS, (size_t)0);
+
+        // 一次遍历统计每一趟各个桶的元素个数
+        for (size_t i = 0; i < n; ++i)
+        {
+            U k = Encoder::encode(key(first[i]));
+            for (unsigned p = 0; p < (unsigned)_PASSES; ++p)
+            {
+                ++counts[p][(size_t)(k >> (p * _RADIX_BITS)) & (_RADIX_BUCKETS - 1)];
+            }
+        }
+
+        bool in_buffer = false, constructed = false;
+        for (unsigned p = 0; p < (unsigned)_PASSES; ++p)
+        {
+            // 所有元素这一位都相同,这一趟不改变顺序
+            size_t *count = counts[p];
+            if (n == count[(size_t)(Encoder::encode(key(in_buffer ? tmp[0] : first[0])) >> (p * _RADIX_BITS)) & (_RADIX_BUCKETS - 1)])
+            {
+                continue;
+            }
+            size_t offset = 0;
+            for (size_t d = 0; d < (size_t)_RADIX_BUCKETS; ++d)
+            {
+                size_t c = count[d];
+                count[d] = offset;
+                offset += c;
+            }
+            unsigned shift = p * _RADIX_BITS;
+            if (in_buffer)
+            {
+                _radix_scatter<Encoder>(tmp, n, first, key, shift, count, std::false_type());
+            }
+            else if (constructed)
+            {
+                _radix_scatter<Encoder>(first, n, tmp, key, shift, count, std::false_type());
+            }
+            else
+            {
+                _radix_scatter<Encoder>(first, n, tmp, key, shift, count, std::true_type());
+                constructed = true;
+            }
+            in_buffer = !in_buffer;
+        }
+        if (in_buffer)
+        {
+            lp::move(tmp, tmp + n, first);
+        }
+        if (constructed)
+        {
+            lp::destroy(tmp, tmp + n);
+        }
+    }
+
+    template <class RandomAccessIterator>
+    inline void radix_sort(RandomAccessIterator first, RandomAccessIterator last)
+    {
+        lp::radix_sort(first, last, _identity_key());
+    }
+    // endregion
+} // namespace lp
+
+#endif // LP_SORT_H
@@ -0,0 +1,321 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+
+/*
+并行算法共用的work-stealing线程池
+ * 每个工作线程有自己的任务队列,从队尾取自己提交的任务(后进先出,缓存更热),
+   自己的队列空了就从其他线程的队首偷任务(先进先出,偷到的往往是较大的任务)
+ * 外部线程提交的任务轮流放入各个队列
+ * task_group::wait()在等待期间也执行任务,嵌套的并行调用不会因为线程都在等待而死锁
+ * thread_pool::instance()是进程内共享的线程池,工作线程数为硬件线程数减一,调用者自己算一个
+   环境变量LP_NUM_THREADS可以改变总的线程数
+*/
+#ifndef LP_THREAD_POOL_H
+#define LP_THREAD_POOL_H
+
+#include <atomic>             //for std::atomic
+#include <condition_variable> //for std::condition_variable
+#include <cstddef>            //for size_t
+#include <cstdlib>            //for getenv,atoi
+#include <deque>              //for std::deque
+#include <exception>          //for std::exception_ptr
+#include <functional>         //for std::function
+#include <memory>             //for std::unique_ptr
+#include <mutex>              //for std::mutex
+#include <thread>             //for std::thread
+#include <vector>             //for std::vector
+
+namespace lp
+{
+    class thread_pool
+    {
+    public:
+        using task = std::function<void()>;
+
+        // 创建workers个工作线程
+        explicit thread_pool(size_t workers) : stopping(false), queued(0), next_queue(0)
+        {
+            for (size_t i = 0; i < workers; ++i)
+            {
+                queues.push_back(std::unique_ptr<task_queue>(new task_queue()));
+            }
+            for (size_t i = 0; i < workers; ++i)
+            {
+                threads.push_back(std::thread(&thread_pool::worker_loop, this, i));
+            }
+        }
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock);
+                stopping = true;
+            }
+            wakeup.notify_all();
+            for (size_t i = 0; i < threads.size(); ++i)
+            {
+                threads[i].join();
+            }
+        }
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        // 进程内共享的线程池,进程结束时也不析构,避免在静态对象析构期间join
+        static thread_pool &instance()
+        {
+            static thread_pool *pool = new thread_pool(default_concurrency() - 1);
+            return *pool;
+        }
+
+        // 可同时执行任务的线程数,包括调用者
+        size_t concurrency() const { return threads.size() + 1; }
+
+        void submit(task t)
+        {
+            if (queues.empty())
+            {
+                // 没有工作线程(单核或LP_NUM_THREADS=1),直接执行
+                t();
+                return;
+            }
+            task_queue &q = *queues[queue_for_submit()];
+            {
+                std::lock_guard<std::mutex> guard(q.lock);
+                q.tasks.push_back(std::move(t));
+            }
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock);
+                ++queued;
+            }
+            wakeup.notify_one();
+        }
+
+        // 取一个任务执行,没有可执行的任务时返回false
+        bool run_one()
+        {
+            task t;
+            if (!take(t))
+            {
+                return false;
+            }
+            t();
+            return true;
+        }
+
+    private:
+        struct task_queue
+        {
+            std::mutex lock;
+            std::deque<task> tasks;
+        };
+
+        std::vector<std::unique_ptr<task_queue>> queues;
+        std::vector<std::thread> threads;
+        std::mutex sleep_lock;
+        std::condition_variable wakeup;
+        bool stopping;             // 由sleep_lock保护
+        std::atomic<size_t> queued; // 所有队列中的任务数,增加时持有sleep_lock
+        std::atomic<size_t> next_queue;
+
+        static size_t default_concurrency()
+        {
+            const char *env = getenv("LP_NUM_THREADS");
+            if (0 != env && atoi(env) > 0)
+            {
+                return (size_t)atoi(env);
+            }
+            size_t n = std::thread::hardware_concurrency();
+            return 0 == n ? 1 : n;
+        }
+
+        // 工作线程所属的线程池和编号
+        struct worker_id
+        {
+            const thread_pool *owner;
+            long index;
+        };
+        static worker_id &current_worker()
+        {
+            static thread_local worker_id id = {0, -1};
+            return id;
+        }
+        // 当前线程在本线程池中的编号,不是本线程池的工作线程时为-1
+        long worker_index() const
+        {
+            const worker_id &id = current_worker();
+            return this == id.owner ? id.index : -1;
+        }
+
+        size_t queue_for_submit()
+        {
+            long self = worker_index();
+            if (self >= 0)
+            {
+                return (size_t)self;
+            }
+            return next_queue++ % queues.size();
+        }
+
+        bool pop_back(task_queue &q, task &t)
+        {
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.tasks.empty())
+            {
+                return false;
+            }
+            t = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+
+        bool pop_front(task_queue &q, task &t)
+        {
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (q.tasks.empty())
+            {
+                return false;
+            }
+            t = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+
+        bool take(task &t)
+        {
+            if (0 == queued.load() || queues.empty())
+            {
+                return false;
+            }
+            long self = worker_index();
+            if (self >= 0 && pop_back(*queues[self], t))
+            {
+                --queued;
+                return true;
+            }
+            size_t start = self >= 0 ? (size_t)self + 1 : 0;
+            for (size_t i = 0; i < queues.size(); ++i)
+            {
+                if (pop_front(*queues[(start + i) % queues.size()], t))
+                {
+                    --queued;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void worker_loop(size_t index)
+        {
+            current_worker().owner = this;
+            current_worker().index = (long)index;
+            for (;;)
+            {
+                if (run_one())
+                {
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_lock);
+                wakeup.wait(lock, [this]
+                            { return stopping || queued.load() > 0; });
+                if (stopping)
+                {
+                    return;
+                }
+            }
+        }
+    };
+
+    // 一组任务,wait()等待全部完成,并重新抛出其中第一个异常
+    class task_group
+    {
+    public:
+        explicit task_group(thread_pool &p = thread_pool::instance()) : pool(p), pending(0) {}
+        ~task_group() { wait_all(); }
+        task_group(const task_group &) = delete;
+        task_group &operator=(const task_group &) = delete;
+
+        template <class F>
+        void run(F f)
+        {
+            ++pending;
+            pool.submit([this, f]() mutable
+                        {
+                            try
+                            {
+                                f();
+                            }
+                            catch (...)
+                            {
+                                std::lock_guard<std::mutex> guard(error_lock);
+                                if (!error)
+                                {
+                                    error = std::current_exception();
+                                }
+                            }
+                            --pending; });
+        }
+
+        void wait()
+        {
+            wait_all();
+            if (error)
+            {
+                std::exception_ptr e = error;
+                error = std::exception_ptr();
+                std::rethrow_exception(e);
+            }
+        }
+
+    private:
+        thread_pool &pool;
+        std::atomic<size_t> pending;
+        std::mutex error_lock;
+        std::exception_ptr error;
+
+        // 等待期间帮忙执行任务(可能是别的组的任务),没有任务可做时让出CPU
+        void wait_all()
+        {
+            while (0 != pending.load())
+            {
+                if (!pool.run_one())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    // 把[0,n)均分为至多chunks段,每段调用f(begin,end),调用者执行第一段
+    // 适合每个元素代价相同的循环;段数为1时不经过线程池
+    template <class F>
+    void parallel_chunks(size_t n, size_t chunks, F f, thread_pool &pool = thread_pool::instance())
+    {
+        if (chunks > n)
+        {
+            chunks = n;
+        }
+        if (chunks <= 1)
+        {
+            if (n > 0)
+            {
+                f((size_t)0, n);
+            }
+            return;
+        }
+        task_group group(pool);
+        for (size_t i = 1; i < chunks; ++i)
+        {
+            size_t begin = n * i / chunks, end = n * (i + 1) / chunks;
+            group.run([&f, begin, end]
+                      { f(begin, end); });
+        }
+        // 第一段抛出异常时,group析构会等其他段结束
+        f((size_t)0, n / chunks);
+        group.wait();
+    }
+} // namespace lp
+
+#endif // LP_THREAD_POOL_H
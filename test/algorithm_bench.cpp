@@ -0,0 +1,322 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+lp基本算法(lp_algobase.h)与libstdc++对应算法的对比
+用法: algorithm_bench [元素个数,默认1M]
+每一项先检查两者结果相同,再报告每个元素的平均耗时(ns),取最快一轮
+ * 指针区间:memmove/memset/memcmp路径
+ * std::deque:随机访问但不连续,计数循环
+ * std::list:双向迭代器,逐个比较first != last
+ * std::string元素:赋值不平凡,逐个赋值
+ * wrapped_iterator:包装指针的迭代器,声明为contiguous_iterator_tag时与指针一样走memmove/memset/memcmp,
+   声明为random_access_iterator_tag时走计数循环
+*/
+#include "3_sequence_containers/lp_vector.h"
+#include "5_algorithm/lp_algobase.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <stdint.h>
+#include <string>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ELEMS = 64 * 1024 * 1024, // 每项至少处理这么多个元素
+        _BENCH_ROUNDS = 3
+    };
+
+    // 防止编译器把结果优化掉
+    void clobber(const void *p)
+    {
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    template <class Op>
+    double best_ns(size_t n, Op op)
+    {
+        size_t reps = _BENCH_ELEMS / n + 1;
+        double best = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            clock_type::time_point start = clock_type::now();
+            for (size_t i = 0; i < reps; ++i)
+            {
+                op();
+            }
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            double ns = secs * 1e9 / reps / n;
+            best = 0 == r || ns < best ? ns : best;
+        }
+        return best;
+    }
+
+    bool all_ok = true;
+
+    void report(const char *name, bool ok, double lp_ns, double std_ns)
+    {
+        all_ok = all_ok && ok;
+        std::printf("%-36s %10.3f %10.3f %8.2fx%s\n", name, lp_ns, std_ns, std_ns / lp_ns, ok ? "" : "   MISMATCH");
+    }
+
+    template <class Container>
+    bool same(const Container &a, const Container &b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    // region:包装指针的迭代器,模拟容器自己的迭代器类
+    template <class T, class Category>
+    class wrapped_iterator : public lp::iterator<Category, T>
+    {
+    public:
+        using self = wrapped_iterator;
+        wrapped_iterator(T *p = nullptr) : ptr(p) {}
+        T &operator*() const { return *ptr; }
+        T *operator->() const { return ptr; }
+        T &operator[](ptrdiff_t n) const { return ptr[n]; }
+        self &operator++()
+        {
+            ++ptr;
+            return *this;
+        }
+        self &operator--()
+        {
+            --ptr;
+            return *this;
+        }
+        self &operator+=(ptrdiff_t n)
+        {
+            ptr += n;
+            return *this;
+        }
+        self &operator-=(ptrdiff_t n)
+        {
+            ptr -= n;
+            return *this;
+        }
+        self operator+(ptrdiff_t n) const { return self(ptr + n); }
+        self operator-(ptrdiff_t n) const { return self(ptr - n); }
+        ptrdiff_t operator-(const self &x) const { return ptr - x.ptr; }
+        bool operator==(const self &x) const { return ptr == x.ptr; }
+        bool operator!=(const self &x) const { return ptr != x.ptr; }
+        bool operator<(const self &x) const { return ptr < x.ptr; }
+
+    private:
+        T *ptr;
+    };
+
+    // 让wrapped_iterator可以像容器一样传给下面的bench_*
+    template <class T, class Category>
+    struct wrapped_range
+    {
+        using iterator = wrapped_iterator<T, Category>;
+        using const_iterator = wrapped_iterator<T, Category>;
+        T *first;
+        size_t n;
+        iterator begin() const { return iterator(first); }
+        iterator end() const { return iterator(first + n); }
+        size_t size() const { return n; }
+    };
+
+    template <class Category, class Container>
+    wrapped_range<typename Container::value_type, Category> wrap(Container &c)
+    {
+        wrapped_range<typename Container::value_type, Category> r = {&*c.begin(), c.size()};
+        return r;
+    }
+    // endregion
+
+    // region:copy,copy_backward,move
+    template <class Container>
+    void bench_copy(const char *name, const Container &src, Container &dst, Container &ref)
+    {
+        size_t n = src.size();
+        std::copy(src.begin(), src.end(), ref.begin());
+        lp::copy(src.begin(), src.end(), dst.begin());
+        bool ok = same(dst, ref);
+        double lp_ns = best_ns(n, [&]
+                               { lp::copy(src.begin(), src.end(), dst.begin()); clobber(&*dst.begin()); });
+        double std_ns = best_ns(n, [&]
+                                { std::copy(src.begin(), src.end(), ref.begin()); clobber(&*ref.begin()); });
+        report(name, ok, lp_ns, std_ns);
+    }
+
+    // 区间内后移一个位置,vector插入时的平移
+    template <class Container>
+    void bench_copy_backward(const char *name, Container &a, Container &b)
+    {
+        size_t n = a.size() - 1;
+        typename Container::iterator a_first = a.begin(), b_first = b.begin();
+        typename Container::iterator a_last = a_first, b_last = b_first;
+        std::advance(a_last, n);
+        std::advance(b_last, n);
+        lp::copy_backward(a_first, a_last, a.end());
+        std::copy_backward(b_first, b_last, b.end());
+        bool ok = same(a, b);
+        double lp_ns = best_ns(n, [&]
+                               { lp::copy_backward(a_first, a_last, a.end()); clobber(&*a.begin()); });
+        double std_ns = best_ns(n, [&]
+                                { std::copy_backward(b_first, b_last, b.end()); clobber(&*b.begin()); });
+        report(name, ok, lp_ns, std_ns);
+    }
+
+    // 移动后源区间中的string为空,每轮先恢复源区间,两边做同样的额外工作
+    void bench_move_strings(size_t n)
+    {
+        const std::string proto(48, 'm');
+        lp::vector<std::string> src(n, proto), dst(n), ref(n);
+        lp::move(src.begin(), src.end(), dst.begin());
+        lp::fill(src.begin(), src.end(), proto);
+        std::move(src.begin(), src.end(), ref.begin());
+        bool ok = same(dst, ref);
+        double lp_ns = best_ns(n, [&]
+                               { lp::move(src.begin(), src.end(), dst.begin());
+                                 lp::move(dst.begin(), dst.end(), src.begin()); });
+        double std_ns = best_ns(n, [&]
+                                { std::move(src.begin(), src.end(), ref.begin());
+                                  std::move(ref.begin(), ref.end(), src.begin()); });
+        report("move string x2", ok, lp_ns, std_ns);
+    }
+    // endregion
+
+    // region:fill
+    template <class Container, class T>
+    void bench_fill(const char *name, Container &a, Container &b, const T &value)
+    {
+        size_t n = a.size();
+        lp::fill(a.begin(), a.end(), value);
+        std::fill(b.begin(), b.end(), value);
+        bool ok = same(a, b);
+        double lp_ns = best_ns(n, [&]
+                               { lp::fill(a.begin(), a.end(), value); clobber(&*a.begin()); });
+        double std_ns = best_ns(n, [&]
+                                { std::fill(b.begin(), b.end(), value); clobber(&*b.begin()); });
+        report(name, ok, lp_ns, std_ns);
+    }
+    // endregion
+
+    // region:equal,lexicographical_compare
+    // 两个区间只有最后一个元素不同,必须比较到底
+    template <class Container>
+    void bench_equal(const char *name, const Container &a, const Container &b)
+    {
+        size_t n = a.size();
+        bool lp_result = lp::equal(a.begin(), a.end(), b.begin());
+        bool std_result = std::equal(a.begin(), a.end(), b.begin());
+        bool sink = false;
+        double lp_ns = best_ns(n, [&]
+                               { sink ^= lp::equal(a.begin(), a.end(), b.begin()); clobber(&sink); });
+        double std_ns = best_ns(n, [&]
+                                { sink ^= std::equal(a.begin(), a.end(), b.begin()); clobber(&sink); });
+        report(name, lp_result == std_result, lp_ns, std_ns);
+    }
+
+    template <class Container>
+    void bench_lexicographical_compare(const char *name, const Container &a, const Container &b)
+    {
+        size_t n = a.size();
+        bool ok = lp::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()) ==
+                      std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()) &&
+                  lp::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()) ==
+                      std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end());
+        bool sink = false;
+        double lp_ns = best_ns(n, [&]
+                               { sink ^= lp::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); clobber(&sink); });
+        double std_ns = best_ns(n, [&]
+                                { sink ^= std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()); clobber(&sink); });
+        report(name, ok, lp_ns, std_ns);
+    }
+    // endregion
+
+    void run(size_t n)
+    {
+        std::printf("== lp vs libstdc++, %zu elements, ns/elem ==\n", n);
+        std::printf("%-36s %10s %10s %9s\n", "algorithm", "lp", "std", "speedup");
+
+        lp::vector<int32_t> isrc(n), idst(n), iref(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            isrc[i] = (int32_t)(i * 2654435761u);
+        }
+        bench_copy("copy int32 (pointer)", isrc, idst, iref);
+        bench_copy_backward("copy_backward int32 (pointer)", idst, iref);
+        bench_fill("fill int32 (pointer)", idst, iref, (int32_t)7);
+
+        lp::vector<uint8_t> bsrc(n), bdst(n), bref(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            bsrc[i] = (uint8_t)(i * 31);
+        }
+        bench_copy("copy uint8 (pointer)", bsrc, bdst, bref);
+        bench_fill("fill uint8 (pointer)", bdst, bref, (uint8_t)0x5a);
+
+        lp::vector<int32_t> ia(isrc), ib(isrc);
+        ib[n - 1] ^= 1;
+        bench_equal("equal int32 (pointer)", ia, ib);
+        lp::vector<uint8_t> ba(bsrc), bb(bsrc);
+        bb[n - 1] ^= 1;
+        bench_lexicographical_compare("lexicographical_compare uint8", ba, bb);
+        lp::vector<int32_t> ic(isrc), id(isrc);
+        id[n - 1] ^= 1;
+        bench_lexicographical_compare("lexicographical_compare int32", ic, id);
+
+        // 同样的内存,换成包装指针的迭代器
+        using contiguous = lp::contiguous_iterator_tag;
+        using random_access = lp::random_access_iterator_tag;
+        wrapped_range<int32_t, contiguous> csrc = wrap<contiguous>(isrc), cdst = wrap<contiguous>(idst), cref = wrap<contiguous>(iref);
+        wrapped_range<int32_t, random_access> rsrc = wrap<random_access>(isrc), rdst = wrap<random_access>(idst),
+                                              rref = wrap<random_access>(iref);
+        bench_copy("copy int32 (contiguous wrapper)", csrc, cdst, cref);
+        bench_copy("copy int32 (random access wrapper)", rsrc, rdst, rref);
+        wrapped_range<uint8_t, contiguous> cb1 = wrap<contiguous>(bdst), cb2 = wrap<contiguous>(bref);
+        wrapped_range<uint8_t, random_access> rb1 = wrap<random_access>(bdst), rb2 = wrap<random_access>(bref);
+        bench_fill("fill uint8 (contiguous wrapper)", cb1, cb2, (uint8_t)0x33);
+        bench_fill("fill uint8 (random access wrapper)", rb1, rb2, (uint8_t)0x33);
+        wrapped_range<int32_t, contiguous> cia = wrap<contiguous>(ia), cib = wrap<contiguous>(ib);
+        wrapped_range<int32_t, random_access> ria = wrap<random_access>(ia), rib = wrap<random_access>(ib);
+        bench_equal("equal int32 (contiguous wrapper)", cia, cib);
+        bench_equal("equal int32 (random access wrapper)", ria, rib);
+
+        std::deque<int32_t> dsrc(isrc.begin(), isrc.end()), ddst(n), dref(n);
+        bench_copy("copy int32 (deque)", dsrc, ddst, dref);
+        bench_fill("fill int32 (deque)", ddst, dref, (int32_t)7);
+
+        size_t ln = n / 8 + 2; // 链表节点分散,元素个数少一些
+        std::list<int32_t> lsrc(isrc.begin(), isrc.begin() + ln), ldst(ln), lref(ln);
+        bench_copy("copy int32 (list)", lsrc, ldst, lref);
+        bench_copy_backward("copy_backward int32 (list)", ldst, lref);
+        bench_equal("equal int32 (list)", ldst, lref);
+
+        size_t sn = n / 8 + 2;
+        lp::vector<std::string> ssrc(sn, std::string(48, 's')), sdst(sn), sref(sn);
+        bench_copy("copy string", ssrc, sdst, sref);
+        bench_move_strings(sn);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = 1024 * 1024;
+    if (argc > 1 && std::atol(argv[1]) > 1)
+    {
+        n = (size_t)std::atol(argv[1]);
+    }
+    run(n);
+    if (!all_ok)
+    {
+        std::printf("lp results differ from std!\n");
+        return 1;
+    }
+    return 0;
+}
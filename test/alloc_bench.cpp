@@ -0,0 +1,310 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+配置器性能测试
+用法: alloc_bench [最大线程数]
+*/
+#include "1_allocator/lp_memory.h"
+#include "3_sequence_containers/lp_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    double seconds_since(clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    // 以malloc/free为基准的配置器,接口与lp::alloc相同
+    struct malloc_policy
+    {
+        static void *allocate(size_t n) { return malloc(n); }
+        static void deallocate(void *p, size_t) { free(p); }
+        static size_t good_size(size_t n) { return n; }
+    };
+
+    // region:多线程扩展性测试
+    // 每个线程反复申请一批大小在[8,128]之间的区块,再逆序释放
+    enum
+    {
+        _BATCH = 256,
+        _ROUNDS = 4000
+    };
+
+    template <class Alloc>
+    void small_block_worker(unsigned seed)
+    {
+        void *blocks[_BATCH];
+        size_t sizes[_BATCH];
+        for (int i = 0; i < _BATCH; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            sizes[i] = 8 + (seed >> 16) % 121;
+        }
+        for (int round = 0; round < _ROUNDS; ++round)
+        {
+            for (int i = 0; i < _BATCH; ++i)
+            {
+                blocks[i] = Alloc::allocate(sizes[i]);
+                *(char *)blocks[i] = (char)i;
+            }
+            for (int i = _BATCH - 1; i >= 0; --i)
+            {
+                Alloc::deallocate(blocks[i], sizes[i]);
+            }
+        }
+    }
+
+    template <class Alloc>
+    double small_block_ops_per_sec(int nthreads)
+    {
+        std::vector<std::thread> workers;
+        clock_type::time_point start = clock_type::now();
+        for (int t = 0; t < nthreads; ++t)
+        {
+            workers.push_back(std::thread(small_block_worker<Alloc>, 17u + t));
+        }
+        for (size_t t = 0; t < workers.size(); ++t)
+        {
+            workers[t].join();
+        }
+        double ops = 2.0 * _BATCH * _ROUNDS * nthreads;
+        return ops / seconds_since(start);
+    }
+
+    void bench_thread_scaling(int max_threads)
+    {
+        std::printf("== small blocks (8..128 bytes), alloc+free Mops/s ==\n");
+        std::printf("%8s %14s %14s %8s\n", "threads", "lp::mt_alloc", "malloc", "ratio");
+        for (int t = 1; t <= max_threads; ++t)
+        {
+            double lp_ops = small_block_ops_per_sec<lp::mt_alloc>(t);
+            double malloc_ops = small_block_ops_per_sec<malloc_policy>(t);
+            std::printf("%8d %14.1f %14.1f %8.2f\n", t, lp_ops / 1e6, malloc_ops / 1e6, lp_ops / malloc_ops);
+        }
+    }
+    // endregion
+
+    // region:规格策略测试
+    // 大小在[8,4096]之间按对数均匀分布的区块,比较各规格策略的吞吐量和内部碎片
+    using linear_8_4k = lp::_default_alloc_template<false, 0, lp::_linear_size_class<8, 4096>>;
+    using geometric_4_4k = lp::_default_alloc_template<false, 0, lp::_geometric_size_class<4, 4096>>;
+    using geometric_8_4k = lp::_default_alloc_template<false, 0, lp::_geometric_size_class<8, 4096>>;
+
+    enum
+    {
+        _SC_BLOCKS = 4096,
+        _SC_ROUNDS = 400
+    };
+
+    void make_log_uniform_sizes(size_t *sizes, int n)
+    {
+        unsigned seed = 12345u;
+        for (int i = 0; i < n; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            int shift = 3 + (seed >> 16) % 9; // 2^3 .. 2^11
+            seed = seed * 1103515245u + 12345u;
+            size_t base = size_t(1) << shift;
+            sizes[i] = base + (seed >> 8) % base;
+        }
+    }
+
+    template <class Alloc>
+    void bench_size_class(const char *name, size_t nclasses)
+    {
+        static size_t sizes[_SC_BLOCKS];
+        static void *blocks[_SC_BLOCKS];
+        make_log_uniform_sizes(sizes, _SC_BLOCKS);
+        double requested = 0, granted = 0;
+        for (int i = 0; i < _SC_BLOCKS; ++i)
+        {
+            requested += sizes[i];
+            granted += Alloc::good_size(sizes[i]);
+        }
+        clock_type::time_point start = clock_type::now();
+        for (int round = 0; round < _SC_ROUNDS; ++round)
+        {
+            for (int i = 0; i < _SC_BLOCKS; ++i)
+            {
+                blocks[i] = Alloc::allocate(sizes[i]);
+                *(char *)blocks[i] = (char)i;
+            }
+            // 隔一个释放一个,再释放剩下的,打乱free_list中的顺序
+            for (int i = 0; i < _SC_BLOCKS; i += 2)
+            {
+                Alloc::deallocate(blocks[i], sizes[i]);
+            }
+            for (int i = 1; i < _SC_BLOCKS; i += 2)
+            {
+                Alloc::deallocate(blocks[i], sizes[i]);
+            }
+        }
+        double ops = 2.0 * _SC_BLOCKS * _SC_ROUNDS;
+        std::printf("%-28s %8zu %12.1f %14.2f%%\n", name, nclasses,
+                    ops / seconds_since(start) / 1e6, 100.0 * (granted - requested) / granted);
+    }
+
+    void bench_size_classes()
+    {
+        std::printf("== size classes, blocks 8..4096 bytes (log-uniform) ==\n");
+        std::printf("%-28s %8s %12s %15s\n", "policy", "classes", "Mops/s", "internal frag");
+        bench_size_class<lp::alloc>("alloc (8..128, rest malloc)", lp::_linear_size_class<8, 128>::nclasses);
+        bench_size_class<linear_8_4k>("linear<8,4096>", lp::_linear_size_class<8, 4096>::nclasses);
+        bench_size_class<geometric_4_4k>("geometric<4,4096>", lp::_geometric_size_class<4, 4096>::nclasses);
+        bench_size_class<geometric_8_4k>("geometric<8,4096>", lp::_geometric_size_class<8, 4096>::nclasses);
+        bench_size_class<malloc_policy>("malloc", 0);
+    }
+    // endregion
+
+    // region:arena测试
+    // 模拟一次请求:构造若干vector和一条单向链表,请求结束后全部丢弃
+    struct request_node
+    {
+        request_node *next;
+        long payload[3];
+    };
+
+    template <class Alloc>
+    long build_then_discard(int elems)
+    {
+        using node_allocator = lp::simple_alloc<request_node, Alloc>;
+        long checksum = 0;
+        {
+            lp::vector<int, Alloc> ids;
+            lp::vector<double, Alloc> scores;
+            request_node *head = 0;
+            for (int i = 0; i < elems; ++i)
+            {
+                ids.push_back(i);
+                scores.push_back(i * 0.5);
+                request_node *node = node_allocator::allocate();
+                node->next = head;
+                node->payload[0] = i;
+                head = node;
+            }
+            for (request_node *p = head; 0 != p; p = p->next)
+            {
+                checksum += p->payload[0];
+            }
+            checksum += ids[elems / 2] + (long)scores[elems / 2];
+            while (0 != head)
+            {
+                request_node *next = head->next;
+                node_allocator::deallocate(head);
+                head = next;
+            }
+        }
+        return checksum;
+    }
+
+    struct arena_scope_none
+    {
+        explicit arena_scope_none(lp::arena &) {}
+    };
+
+    template <class Alloc, class Scope>
+    void bench_request(const char *name, int requests, int elems)
+    {
+        lp::arena a;
+        long checksum = 0;
+        clock_type::time_point start = clock_type::now();
+        for (int r = 0; r < requests; ++r)
+        {
+            Scope scope(a);
+            checksum += build_then_discard<Alloc>(elems);
+        }
+        double secs = seconds_since(start);
+        std::printf("%-14s %8d %14.1f %14.3f   (checksum %ld)\n", name, elems,
+                    requests / secs / 1e3, secs * 1e6 / requests, checksum);
+    }
+
+    void bench_arena()
+    {
+        std::printf("== build-then-discard requests (2 vectors + list per request) ==\n");
+        std::printf("%-14s %8s %14s %14s\n", "allocator", "elems", "Kreq/s", "us/request");
+        const int sizes[] = {16, 256, 4096};
+        for (int i = 0; i < 3; ++i)
+        {
+            int requests = 4000000 / sizes[i];
+            bench_request<lp::arena_alloc, lp::arena_scope>("arena_alloc", requests, sizes[i]);
+            bench_request<lp::alloc, arena_scope_none>("alloc", requests, sizes[i]);
+            bench_request<lp::malloc_alloc, arena_scope_none>("malloc_alloc", requests, sizes[i]);
+        }
+    }
+    // endregion
+
+    // region:标准容器测试
+    // std::map插入n个随机键,再反复删除一个旧键,插入一个新键,最后整体析构
+    template <class Allocator>
+    void bench_std_map(const char *name, int n, int churn)
+    {
+        using map_type = std::map<long, long, std::less<long>, Allocator>;
+        unsigned seed = 2024u;
+        std::vector<long> keys(n);
+        clock_type::time_point start = clock_type::now();
+        double insert_secs, churn_secs;
+        {
+            map_type m;
+            for (int i = 0; i < n; ++i)
+            {
+                seed = seed * 1103515245u + 12345u;
+                keys[i] = (long)seed;
+                m[keys[i]] = i;
+            }
+            insert_secs = seconds_since(start);
+            start = clock_type::now();
+            for (int i = 0; i < churn; ++i)
+            {
+                seed = seed * 1103515245u + 12345u;
+                int victim = (int)((seed >> 8) % n);
+                m.erase(keys[victim]);
+                keys[victim] = (long)(seed ^ (unsigned)i);
+                m[keys[victim]] = i;
+            }
+            churn_secs = seconds_since(start);
+        }
+        std::printf("%-22s %14.1f %14.1f\n", name, n / insert_secs / 1e6, churn / churn_secs / 1e6);
+    }
+
+    void bench_std_containers()
+    {
+        using node = std::pair<const long, long>;
+        std::printf("== std::map<long,long>, 1M inserts then 2M erase+insert ==\n");
+        std::printf("%-22s %14s %14s\n", "allocator", "insert Mops/s", "churn Mops/s");
+        bench_std_map<std::allocator<node>>("std::allocator", 1000000, 2000000);
+        bench_std_map<lp::allocator<node>>("lp::allocator<alloc>", 1000000, 2000000);
+        bench_std_map<lp::mt_allocator<node>>("lp::mt_allocator", 1000000, 2000000);
+    }
+    // endregion
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = (int)std::thread::hardware_concurrency();
+    if (argc > 1)
+    {
+        max_threads = std::atoi(argv[1]);
+    }
+    if (max_threads < 1)
+    {
+        max_threads = 1;
+    }
+    bench_thread_scaling(max_threads);
+    bench_size_classes();
+    bench_arena();
+    bench_std_containers();
+    return 0;
+}
@@ -0,0 +1,324 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+分配轨迹回放工具
+先用-DLP_ALLOC_TRACE编译并运行要分析的程序,得到轨迹文件(见lp_alloc_trace.h),再:
+用法: alloc_replay <轨迹文件> [配置器...]
+      配置器可选 alloc mt_alloc geometric_alloc huge_page_pool_alloc malloc_alloc malloc,默认全部
+所有线程的记录按时间戳合并后在单线程中回放,每个配置器在单独的子进程中回放,内存池互不影响
+报告吞吐量,峰值RSS,以及峰值RSS中没有被请求字节占用的比例(碎片)
+新的配置器只要在policies中加一行即可
+*/
+#include "1_allocator/lp_memory.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#if defined(__linux__)
+#include <sys/wait.h> //for waitpid
+#include <unistd.h>   //for fork,sysconf
+#endif
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // 以malloc/free为基准的配置器,接口与lp::alloc相同
+    struct malloc_policy
+    {
+        static void *allocate(size_t n) { return malloc(n); }
+        static void deallocate(void *p, size_t) { free(p); }
+        static void *reallocate(void *p, size_t, size_t new_size) { return realloc(p, new_size); }
+        static void *allocate_aligned(size_t n, size_t align) { return lp::malloc_chunk_source::allocate_aligned(n, align); }
+        static void deallocate_aligned(void *p, size_t n, size_t align) { lp::malloc_chunk_source::deallocate_aligned(p, n, align); }
+    };
+
+    // 回放用的操作:地址已换成槽位编号,realloc的前后两半已合并
+    enum
+    {
+        _REPLAY_ALLOC,
+        _REPLAY_FREE,
+        _REPLAY_REALLOC
+    };
+
+    struct replay_op
+    {
+        uint32_t op;
+        uint32_t slot;
+        uint64_t size; // 申请或调整后的字节数,realloc之前的大小由槽位记录
+        uint32_t align;
+    };
+
+    struct replay_trace
+    {
+        std::vector<replay_op> ops;
+        size_t slots;
+        size_t records;
+        size_t threads;
+        size_t unmatched; // 找不到对应申请的释放,回放时忽略
+        double seconds;   // 原程序中第一条到最后一条记录的时间
+    };
+
+    bool load_trace(const char *path, replay_trace &trace)
+    {
+        std::ifstream in(path, std::ios::binary);
+        lp::alloc_trace_header h;
+        if (!in.read((char *)&h, sizeof(h)) || 0 != memcmp(h.magic, "LPTRACE1", 8) ||
+            sizeof(lp::alloc_trace_record) != h.record_size)
+        {
+            std::fprintf(stderr, "%s: not an lp alloc trace\n", path);
+            return false;
+        }
+        std::vector<lp::alloc_trace_record> records;
+        lp::alloc_trace_record r;
+        while (in.read((char *)&r, sizeof(r)))
+        {
+            records.push_back(r);
+        }
+        // 各线程的缓冲区是分批写出的,按时间戳合并;时间戳相同的保持写出顺序
+        std::stable_sort(records.begin(), records.end(),
+                         [](const lp::alloc_trace_record &a, const lp::alloc_trace_record &b)
+                         { return a.time_ns < b.time_ns; });
+
+        std::unordered_map<uint64_t, uint32_t> live;    // 地址 -> 槽位
+        std::unordered_map<uint32_t, uint32_t> pending; // 线程 -> 正在reallocate的槽位
+        std::vector<uint32_t> free_slots;
+        trace.slots = 0;
+        trace.records = records.size();
+        trace.threads = 0;
+        trace.unmatched = 0;
+        trace.seconds = records.empty() ? 0 : (records.back().time_ns - records.front().time_ns) / 1e9;
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            const lp::alloc_trace_record &rec = records[i];
+            trace.threads = std::max(trace.threads, (size_t)rec.thread + 1);
+            replay_op op;
+            op.size = rec.size;
+            op.align = 1u << rec.align_log2;
+            if (lp::_TRACE_ALLOC == rec.op || lp::_TRACE_REALLOC_ALLOC == rec.op)
+            {
+                std::unordered_map<uint32_t, uint32_t>::iterator p = pending.find(rec.thread);
+                if (lp::_TRACE_REALLOC_ALLOC == rec.op && pending.end() != p)
+                {
+                    op.op = _REPLAY_REALLOC;
+                    op.slot = p->second;
+                    pending.erase(p);
+                }
+                else
+                {
+                    op.op = _REPLAY_ALLOC;
+                    if (free_slots.empty())
+                    {
+                        op.slot = (uint32_t)trace.slots++;
+                    }
+                    else
+                    {
+                        op.slot = free_slots.back();
+                        free_slots.pop_back();
+                    }
+                }
+                live[rec.ptr] = op.slot;
+                trace.ops.push_back(op);
+            }
+            else
+            {
+                std::unordered_map<uint64_t, uint32_t>::iterator p = live.find(rec.ptr);
+                if (live.end() == p)
+                {
+                    ++trace.unmatched;
+                    continue;
+                }
+                uint32_t slot = p->second;
+                live.erase(p);
+                if (lp::_TRACE_REALLOC_FREE == rec.op)
+                {
+                    pending[rec.thread] = slot;
+                    continue;
+                }
+                free_slots.push_back(slot);
+                op.op = _REPLAY_FREE;
+                op.slot = slot;
+                trace.ops.push_back(op);
+            }
+        }
+        return true;
+    }
+
+    // 当前进程的常驻内存(RSS),只在Linux下可用,其他平台返回0
+    size_t resident_bytes()
+    {
+#if defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        size_t total = 0, resident = 0;
+        statm >> total >> resident;
+        return resident * (size_t)sysconf(_SC_PAGESIZE);
+#else
+        return 0;
+#endif
+    }
+
+    // 每页写一个字节,让申请到的内存真正计入RSS
+    void touch(void *p, size_t from, size_t to)
+    {
+        for (size_t i = from; i < to; i += 4096)
+        {
+            ((volatile char *)p)[i] = 1;
+        }
+    }
+
+    template <class Alloc>
+    void *replay_allocate(size_t n, size_t align)
+    {
+        return align > lp::_ALIGN ? Alloc::allocate_aligned(n, align) : Alloc::allocate(n);
+    }
+
+    template <class Alloc>
+    void replay_deallocate(void *p, size_t n, size_t align)
+    {
+        if (align > lp::_ALIGN)
+        {
+            Alloc::deallocate_aligned(p, n, align);
+        }
+        else
+        {
+            Alloc::deallocate(p, n);
+        }
+    }
+
+    template <class Alloc>
+    void replay(const char *name, const replay_trace &trace)
+    {
+        std::vector<void *> blocks(trace.slots, (void *)0);
+        std::vector<uint64_t> sizes(trace.slots, 0);
+        size_t baseline = resident_bytes();
+        size_t live = 0, peak_live = 0, peak_rss = 0;
+        // 每回放一段检查一次RSS,峰值取检查到的最大值
+        const size_t sample = trace.ops.size() / 256 + 1;
+        clock_type::time_point start = clock_type::now();
+        for (size_t i = 0; i < trace.ops.size(); ++i)
+        {
+            const replay_op &op = trace.ops[i];
+            if (_REPLAY_ALLOC == op.op)
+            {
+                void *p = replay_allocate<Alloc>(op.size, op.align);
+                touch(p, 0, op.size);
+                blocks[op.slot] = p;
+                sizes[op.slot] = op.size;
+                live += op.size;
+            }
+            else if (_REPLAY_FREE == op.op)
+            {
+                replay_deallocate<Alloc>(blocks[op.slot], sizes[op.slot], op.align);
+                live -= sizes[op.slot];
+            }
+            else
+            {
+                uint64_t old_size = sizes[op.slot];
+                void *p = blocks[op.slot];
+                if (op.align > lp::_ALIGN)
+                {
+                    void *q = replay_allocate<Alloc>(op.size, op.align);
+                    memcpy(q, p, old_size < op.size ? old_size : op.size);
+                    replay_deallocate<Alloc>(p, old_size, op.align);
+                    p = q;
+                }
+                else
+                {
+                    p = Alloc::reallocate(p, old_size, op.size);
+                }
+                if (op.size > old_size)
+                {
+                    touch(p, old_size, op.size);
+                }
+                blocks[op.slot] = p;
+                sizes[op.slot] = op.size;
+                live = live - old_size + op.size;
+            }
+            peak_live = std::max(peak_live, live);
+            if (0 == i % sample)
+            {
+                peak_rss = std::max(peak_rss, resident_bytes());
+            }
+        }
+        double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+        peak_rss = std::max(peak_rss, resident_bytes());
+        size_t rss = peak_rss > baseline ? peak_rss - baseline : 0;
+        double frag = 0 == rss || rss < peak_live ? 0.0 : 100.0 * (rss - peak_live) / rss;
+        std::printf("%-22s %12.2f %14.2f %14.2f %8.1f%%\n", name, trace.ops.size() / secs / 1e6,
+                    peak_live / 1048576.0, rss / 1048576.0, frag);
+        std::fflush(stdout);
+    }
+
+    struct replay_policy
+    {
+        const char *name;
+        void (*run)(const char *, const replay_trace &);
+    };
+
+    const replay_policy policies[] = {
+        {"alloc", replay<lp::alloc>},
+        {"mt_alloc", replay<lp::mt_alloc>},
+        {"geometric_alloc", replay<lp::geometric_alloc>},
+        {"huge_page_pool_alloc", replay<lp::huge_page_pool_alloc>},
+        {"malloc_alloc", replay<lp::malloc_alloc>},
+        {"malloc", replay<malloc_policy>},
+    };
+
+    // Linux下在子进程中回放,每个配置器都从干净的内存池和RSS开始
+    void run_isolated(const replay_policy &policy, const replay_trace &trace)
+    {
+#if defined(__linux__)
+        pid_t pid = fork();
+        if (0 == pid)
+        {
+            policy.run(policy.name, trace);
+            _exit(0);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+#else
+        policy.run(policy.name, trace);
+#endif
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr, "usage: alloc_replay <trace file> [allocator...]\n");
+        return 1;
+    }
+    replay_trace trace;
+    if (!load_trace(argv[1], trace))
+    {
+        return 1;
+    }
+    std::printf("== replay of %s: %zu records, %zu threads, %.3f s recorded, %zu unmatched frees ==\n",
+                argv[1], trace.records, trace.threads, trace.seconds, trace.unmatched);
+    std::printf("%-22s %12s %14s %14s %9s\n", "allocator", "Mops/s", "peak live MB", "peak RSS MB", "frag");
+    std::fflush(stdout);
+    const size_t npolicies = sizeof(policies) / sizeof(policies[0]);
+    for (size_t i = 0; i < npolicies; ++i)
+    {
+        bool selected = argc <= 2;
+        for (int a = 2; a < argc; ++a)
+        {
+            selected = selected || 0 == strcmp(argv[a], policies[i].name);
+        }
+        if (selected)
+        {
+            run_isolated(policies[i], trace);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+uninitialized_copy/uninitialized_fill_n的吞吐量测试
+用法: memory_bench [最大区间MB数,默认1024]
+区间从64B到最大值按4倍递增,分别测试memcpy/std::fill_n与lp::simd的各级内核,
+最后一列是经uninitialized_*入口(自动选择内核与streaming)的结果
+超过LLC的区间对比普通存储与非临时存储
+最后测试并行版本(lp::execution::par(n))在最大区间上从1个线程到全部线程的扩展性,
+线程数由线程池决定,可用环境变量LP_NUM_THREADS调整
+*/
+#include "1_allocator/lp_memory.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <string>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // 每个区间大小至少处理这么多字节,取最快一轮
+    enum
+    {
+        _BENCH_BYTES = 256 * 1024 * 1024,
+        _BENCH_ROUNDS = 3
+    };
+
+    template <class Op>
+    double best_gbps(size_t bytes, Op op)
+    {
+        size_t reps = _BENCH_BYTES / bytes + 1;
+        double best = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            clock_type::time_point start = clock_type::now();
+            for (size_t i = 0; i < reps; ++i)
+            {
+                op();
+            }
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            double gbps = bytes * (double)reps / secs / 1e9;
+            best = gbps > best ? gbps : best;
+        }
+        return best;
+    }
+
+    // 防止编译器把整段拷贝或填充优化掉
+    void clobber(void *p)
+    {
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    void print_size(size_t bytes)
+    {
+        if (bytes >= 1024 * 1024)
+        {
+            std::printf("%6zu MB", bytes >> 20);
+        }
+        else if (bytes >= 1024)
+        {
+            std::printf("%6zu KB", bytes >> 10);
+        }
+        else
+        {
+            std::printf("%6zu B ", bytes);
+        }
+    }
+
+    void bench_copy(char *dst, const char *src, size_t max_bytes)
+    {
+        int best = lp::simd::best_level();
+        std::printf("== copy GB/s (LLC %zu MB, streaming from there) ==\n", lp::simd::stream_threshold() >> 20);
+        std::printf("%9s %10s", "size", "memcpy");
+        for (int level = lp::_SIMD_SSE2; level <= best; ++level)
+        {
+            std::printf(" %10s %10s", lp::simd::kernels(level).name, "+stream");
+        }
+        std::printf(" %14s\n", "uninit_copy");
+        for (size_t bytes = 64; bytes <= max_bytes; bytes *= 4)
+        {
+            print_size(bytes);
+            std::printf(" %10.2f", best_gbps(bytes, [&]
+                                             { memcpy(dst, src, bytes); clobber(dst); }));
+            for (int level = lp::_SIMD_SSE2; level <= best; ++level)
+            {
+                const lp::simd_kernels &k = lp::simd::kernels(level);
+                std::printf(" %10.2f", best_gbps(bytes, [&]
+                                                 { k.copy(dst, src, bytes, false); clobber(dst); }));
+                std::printf(" %10.2f", best_gbps(bytes, [&]
+                                                 { k.copy(dst, src, bytes, true); clobber(dst); }));
+            }
+            std::printf(" %14.2f\n", best_gbps(bytes, [&]
+                                               { lp::uninitialized_copy((const int64_t *)src, (const int64_t *)(src + bytes),
+                                                                        (int64_t *)dst);
+                                                 clobber(dst); }));
+            std::fflush(stdout);
+        }
+    }
+
+    void bench_fill(char *dst, size_t max_bytes)
+    {
+        int best = lp::simd::best_level();
+        std::printf("== fill int64 GB/s ==\n");
+        std::printf("%9s %10s", "size", "fill_n");
+        for (int level = lp::_SIMD_SSE2; level <= best; ++level)
+        {
+            std::printf(" %10s %10s", lp::simd::kernels(level).name, "+stream");
+        }
+        std::printf(" %14s\n", "uninit_fill_n");
+        const int64_t value = 0x0123456789abcdefll;
+        for (size_t bytes = 64; bytes <= max_bytes; bytes *= 4)
+        {
+            size_t n = bytes / sizeof(int64_t);
+            print_size(bytes);
+            std::printf(" %10.2f", best_gbps(bytes, [&]
+                                             { std::fill_n((int64_t *)dst, n, value); clobber(dst); }));
+            for (int level = lp::_SIMD_SSE2; level <= best; ++level)
+            {
+                const lp::simd_kernels &k = lp::simd::kernels(level);
+                std::printf(" %10.2f", best_gbps(bytes, [&]
+                                                 { k.fill(dst, bytes, (uint64_t)value, false); clobber(dst); }));
+                std::printf(" %10.2f", best_gbps(bytes, [&]
+                                                 { k.fill(dst, bytes, (uint64_t)value, true); clobber(dst); }));
+            }
+            std::printf(" %14.2f\n", best_gbps(bytes, [&]
+                                               { lp::uninitialized_fill_n((int64_t *)dst, n, value); clobber(dst); }));
+            std::fflush(stdout);
+        }
+    }
+
+    template <class Op>
+    double seconds_of(Op op)
+    {
+        clock_type::time_point start = clock_type::now();
+        op();
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    void bench_parallel(char *dst, const char *src, size_t bytes)
+    {
+        size_t all = lp::thread_pool::instance().concurrency();
+        size_t n = bytes / sizeof(int64_t);
+        size_t nstr = bytes / 4 / sizeof(std::string); // 每个string另有堆上的48字节
+        std::string *strs = (std::string *)dst;
+        const std::string proto(48, 's');
+        std::printf("== parallel uninitialized_*, %zu MB, GB/s (string: M objects/s) ==\n", bytes >> 20);
+        std::printf("%8s %12s %12s %12s %14s %14s\n", "threads", "fill_n", "value_init", "copy",
+                    "string fill", "string destroy");
+        for (size_t t = 1; t <= all; t = t * 2 <= all || t == all ? t * 2 : all)
+        {
+            lp::execution::parallel_policy policy = lp::execution::par(t);
+            double fill = seconds_of([&]
+                                     { lp::uninitialized_fill_n(policy, (int64_t *)dst, n, (int64_t)7); });
+            double value = seconds_of([&]
+                                      { lp::uninitialized_value_construct_n(policy, (int64_t *)dst, n); });
+            double copy = seconds_of([&]
+                                     { lp::uninitialized_copy(policy, (const int64_t *)src, (const int64_t *)src + n,
+                                                              (int64_t *)dst); });
+            double sfill = seconds_of([&]
+                                      { lp::uninitialized_fill_n(policy, strs, nstr, proto); });
+            double sdestroy = seconds_of([&]
+                                         { lp::destroy(policy, strs, strs + nstr); });
+            std::printf("%8zu %12.2f %12.2f %12.2f %14.2f %14.2f\n", t, bytes / fill / 1e9, bytes / value / 1e9,
+                        bytes / copy / 1e9, nstr / sfill / 1e6, nstr / sdestroy / 1e6);
+            std::fflush(stdout);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t max_mb = 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        max_mb = (size_t)std::atoi(argv[1]);
+    }
+    size_t max_bytes = max_mb * 1024 * 1024;
+    std::printf("simd: %s\n", lp::simd::active().name);
+    // 两个缓冲区都先写一遍,避免把缺页计入第一轮
+    char *src = (char *)lp::huge_page_alloc::allocate(max_bytes);
+    char *dst = (char *)lp::huge_page_alloc::allocate(max_bytes);
+    memset(src, 1, max_bytes);
+    memset(dst, 2, max_bytes);
+    bench_copy(dst, src, max_bytes);
+    bench_fill(dst, max_bytes);
+    bench_parallel(dst, src, max_bytes);
+    lp::huge_page_alloc::deallocate(src, max_bytes);
+    lp::huge_page_alloc::deallocate(dst, max_bytes);
+    return 0;
+}
@@ -1,6 +1,11 @@
 #include "1_allocator/lp_memory.h"
 #include <iostream>
 #include <string>
+#include <vector>
+#include <fstream>
+#if defined(__linux__)
+#include <unistd.h> //for sysconf
+#endif
 class TestClass
 {
 public:
@@ -22,6 +27,109 @@ public:
     ~TestClass() {}
 };
 
+// 当前进程的常驻内存(RSS),只在Linux下可用,其他平台返回0
+size_t resident_bytes()
+{
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0, resident = 0;
+    statm >> total >> resident;
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+// 测试trim:突发申请大量小区块后全部释放,trim应把完全空闲的chunk还给系统,RSS随之下降
+bool trim_test()
+{
+    const size_t nblocks = 1 << 20;
+    const size_t block_size = 64;
+    std::vector<void *> blocks(nblocks);
+    size_t rss_before = resident_bytes();
+    for (size_t i = 0; i < nblocks; ++i)
+    {
+        blocks[i] = lp::alloc::allocate(block_size);
+        memset(blocks[i], 1, block_size);
+    }
+    size_t rss_burst = resident_bytes();
+    for (size_t i = 0; i < nblocks; ++i)
+    {
+        lp::alloc::deallocate(blocks[i], block_size);
+    }
+    size_t released = lp::alloc::trim();
+    size_t rss_after = resident_bytes();
+    std::cout << "RSS before burst: " << rss_before / 1024 << " KB, after burst: " << rss_burst / 1024
+              << " KB, after trim: " << rss_after / 1024 << " KB, trim released " << released / 1024 << " KB" << std::endl;
+
+    // 区块仍可正常使用
+    void *p = lp::alloc::allocate(block_size);
+    memset(p, 2, block_size);
+    lp::alloc::deallocate(p, block_size);
+
+    if (released < nblocks * block_size)
+    {
+        return false;
+    }
+#if defined(__linux__)
+    return rss_after + nblocks * block_size / 2 < rss_burst;
+#else
+    return true;
+#endif
+}
+
+// 按alignof(T)对齐的分配:16,32,64字节对齐的小区块来自内存池,页对齐的来自一级配置器
+struct alignas(64) padded_counter
+{
+    long value;
+};
+
+struct alignas(4096) page_block
+{
+    char data[4096];
+};
+
+template <class T, class Alloc>
+bool check_aligned(int n)
+{
+    bool ok = true;
+    std::vector<T *> blocks;
+    for (int i = 1; i <= n; ++i)
+    {
+        T *p = lp::simple_alloc<T, Alloc>::allocate(i % 3 + 1);
+        ok = ok && 0 == (size_t)p % alignof(T);
+        blocks.push_back(p);
+    }
+    for (int i = 1; i <= n; ++i)
+    {
+        lp::simple_alloc<T, Alloc>::deallocate(blocks[i - 1], i % 3 + 1);
+    }
+    return ok;
+}
+
+bool aligned_test()
+{
+    struct alignas(16) v4 { float f[4]; };
+    struct alignas(32) v8 { float f[8]; };
+    bool ok = check_aligned<v4, lp::alloc>(1000) && check_aligned<v8, lp::alloc>(1000) &&
+              check_aligned<padded_counter, lp::alloc>(1000) && check_aligned<page_block, lp::alloc>(10) &&
+              check_aligned<padded_counter, lp::mt_alloc>(1000) && check_aligned<v8, lp::malloc_alloc>(100);
+    // 对齐的区块与普通区块交错申请,内存池起点的调整不能影响普通区块
+    std::vector<void *> plain;
+    for (int i = 0; i < 100; ++i)
+    {
+        plain.push_back(lp::alloc::allocate(24));
+        void *p = lp::alloc::allocate_aligned(40, 64);
+        ok = ok && 0 == (size_t)p % 64;
+        lp::alloc::deallocate_aligned(p, 40, 64);
+    }
+    for (size_t i = 0; i < plain.size(); ++i)
+    {
+        lp::alloc::deallocate(plain[i], 24);
+    }
+    return ok;
+}
+
 int main()
 {
     std::cout << "Testing LP memory management..." << std::endl;
@@ -77,11 +185,64 @@ int main()
         std::cout << arr3[i] << " ";
     std::cout << std::endl;
 
+    // 源与目标元素类型不同:以const char*逐个构造std::string
+    const char *names[3] = {"alpha", "beta", "gamma"};
+    std::string *strs = lp::simple_alloc<std::string, lp::alloc>::allocate(3);
+    lp::uninitialized_copy(names, names + 3, strs);
+
+    std::cout << "The strings after uninitialized_copy are: ";
+    for (int i = 0; i < 3; ++i)
+        std::cout << strs[i] << " ";
+    std::cout << std::endl;
+    lp::destroy(strs, strs + 3);
+    lp::simple_alloc<std::string, lp::alloc>::deallocate(strs, 3);
+
+    // 测试uninitialized_move函数,移动之后源字符串为空
+    std::string *src = lp::simple_alloc<std::string, lp::alloc>::allocate(3);
+    std::string *dst = lp::simple_alloc<std::string, lp::alloc>::allocate(3);
+    for (int i = 0; i < 3; ++i)
+        lp::construct(src + i, 20, (char)('a' + i));
+    lp::uninitialized_move(src, src + 3, dst);
+
+    std::cout << "The strings after uninitialized_move are: ";
+    for (int i = 0; i < 3; ++i)
+        std::cout << dst[i].substr(0, 3) << "(" << src[i].size() << ") ";
+    std::cout << std::endl;
+
+    lp::destroy(src, src + 3);
+    lp::destroy(dst, dst + 3);
+    lp::simple_alloc<std::string, lp::alloc>::deallocate(src, 3);
+    lp::simple_alloc<std::string, lp::alloc>::deallocate(dst, 3);
+
+    // 源与目标元素类型不同时uninitialized_move同样逐个构造
+    strs = lp::simple_alloc<std::string, lp::alloc>::allocate(3);
+    lp::uninitialized_move(names, names + 3, strs);
+    std::cout << "The strings after uninitialized_move from const char* are: ";
+    for (int i = 0; i < 3; ++i)
+        std::cout << strs[i] << " ";
+    std::cout << std::endl;
+    lp::destroy(strs, strs + 3);
+    lp::simple_alloc<std::string, lp::alloc>::deallocate(strs, 3);
+
     lp::simple_alloc<int, lp::alloc>::deallocate(arr1, 5);
     std::cout << "arr1 deallocated done!" << std::endl;
     lp::simple_alloc<int, lp::alloc>::deallocate(arr2, 5);
     std::cout << "arr2 deallocated done!" << std::endl;
     lp::simple_alloc<int, lp::alloc>::deallocate(arr3, 5);
     std::cout << "arr3 deallocated done!" << std::endl;
+
+    if (!trim_test())
+    {
+        std::cout << "trim test failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "trim test done!" << std::endl;
+
+    if (!aligned_test())
+    {
+        std::cout << "aligned test failed!" << std::endl;
+        return 1;
+    }
+    std::cout << "aligned test done!" << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+并行算法(lp_parallel_algo.h)的扩展性测试
+用法: parallel_bench [元素个数,默认16M]
+先检查每个算法在各线程数下的结果与libstdc++顺序版本相同(整数运算,分组不影响结果),
+再按线程数1,2,4,...,全部报告吞吐量(M元素/s),取最快一轮;第一行是libstdc++顺序版本
+最后用std::list检查非随机访问迭代器退回顺序版本
+线程数由环境变量LP_NUM_THREADS决定,默认为硬件线程数
+*/
+#include "5_algorithm/lp_algorithm.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <numeric>
+#include <random>
+#include <stdint.h>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ROUNDS = 3
+    };
+
+    // 每轮先调用prepare(不计时)再计时op,返回最快一轮的秒数
+    template <class Prepare, class Op>
+    double best_seconds(Prepare prepare, Op op)
+    {
+        double best = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            prepare();
+            clock_type::time_point start = clock_type::now();
+            op();
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            best = 0 == r || secs < best ? secs : best;
+        }
+        return best;
+    }
+
+    template <class Op>
+    double best_seconds(Op op)
+    {
+        return best_seconds([] {}, op);
+    }
+
+    bool all_ok = true;
+
+    void check(const char *name, size_t threads, bool ok)
+    {
+        if (!ok)
+        {
+            all_ok = false;
+            std::printf("MISMATCH: %s with %zu threads\n", name, threads);
+        }
+    }
+
+    struct is_odd
+    {
+        bool operator()(int64_t x) const { return 0 != (x & 1); }
+    };
+
+    struct mix
+    {
+        int64_t operator()(int64_t x) const { return x * 31 + (x >> 3); }
+    };
+
+    using vec = std::vector<int64_t>;
+
+    void check_all(const vec &input, size_t all)
+    {
+        size_t n = input.size();
+        vec sorted(input), expect(n), out(n);
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t t = 1; t <= all; ++t)
+        {
+            lp::execution::parallel_policy policy = lp::execution::par(t);
+
+            out = input;
+            lp::sort(policy, out.begin(), out.end());
+            check("sort", t, out == sorted);
+            out = input;
+            lp::sort(policy, out.begin(), out.end(), [](int64_t a, int64_t b)
+                     { return a > b; });
+            check("sort(greater)", t, std::equal(out.begin(), out.end(), sorted.rbegin()));
+
+            std::transform(input.begin(), input.end(), expect.begin(), mix());
+            lp::transform(policy, input.begin(), input.end(), out.begin(), mix());
+            check("transform", t, out == expect);
+            std::transform(input.begin(), input.end(), sorted.begin(), expect.begin(), std::minus<int64_t>());
+            lp::transform(policy, input.begin(), input.end(), sorted.begin(), out.begin(), std::minus<int64_t>());
+            check("transform(binary)", t, out == expect);
+
+            int64_t sum = std::accumulate(input.begin(), input.end(), (int64_t)5);
+            check("reduce", t, lp::reduce(policy, input.begin(), input.end(), (int64_t)5) == sum);
+            check("reduce(op)", t, lp::reduce(policy, input.begin(), input.end(), (int64_t)0, std::bit_xor<int64_t>()) ==
+                                       std::accumulate(input.begin(), input.end(), (int64_t)0, std::bit_xor<int64_t>()));
+
+            out = input;
+            lp::for_each(policy, out.begin(), out.end(), [](int64_t &x)
+                         { x += 3; });
+            check("for_each", t, lp::reduce(policy, out.begin(), out.end()) == sum - 5 + 3 * (int64_t)n);
+
+            std::partial_sum(input.begin(), input.end(), expect.begin());
+            lp::inclusive_scan(policy, input.begin(), input.end(), out.begin());
+            check("inclusive_scan", t, out == expect);
+            out = input;
+            lp::inclusive_scan(policy, out.begin(), out.end(), out.begin(), std::plus<int64_t>(), (int64_t)0);
+            check("inclusive_scan(in place)", t, out == expect);
+            lp::exclusive_scan(policy, input.begin(), input.end(), out.begin(), (int64_t)0);
+            check("exclusive_scan", t, 0 == out[0] && std::equal(out.begin() + 1, out.end(), expect.begin()));
+
+            check("count_if", t, lp::count_if(policy, input.begin(), input.end(), is_odd()) ==
+                                     std::count_if(input.begin(), input.end(), is_odd()));
+            vec::iterator e1 = std::copy_if(input.begin(), input.end(), expect.begin(), is_odd());
+            vec::iterator e2 = lp::copy_if(policy, input.begin(), input.end(), out.begin(), is_odd());
+            check("copy_if", t, e1 - expect.begin() == e2 - out.begin() && std::equal(expect.begin(), e1, out.begin()));
+        }
+
+        // 双向迭代器退回顺序版本
+        std::list<int64_t> l(input.begin(), input.begin() + (n < 1000 ? n : 1000));
+        lp::execution::parallel_policy policy = lp::execution::par;
+        check("reduce(list)", all, lp::reduce(policy, l.begin(), l.end()) == std::accumulate(l.begin(), l.end(), (int64_t)0));
+        check("count_if(list)", all, lp::count_if(policy, l.begin(), l.end(), is_odd()) ==
+                                         std::count_if(l.begin(), l.end(), is_odd()));
+        std::printf("correctness checks for 1..%zu threads: %s\n", all, all_ok ? "ok" : "FAILED");
+    }
+
+    void bench(const vec &input, size_t all)
+    {
+        size_t n = input.size();
+        vec out(n), work(n);
+        double m = n / 1e6;
+        std::printf("== %zu int64, M elements/s ==\n", n);
+        std::printf("%8s %10s %10s %10s %10s %10s %10s %10s %10s\n", "threads", "sort", "transform", "reduce",
+                    "for_each", "incl_scan", "excl_scan", "count_if", "copy_if");
+        {
+            double sort = best_seconds([&]
+                                       { work = input; },
+                                       [&]
+                                       { std::sort(work.begin(), work.end()); });
+            double trans = best_seconds([&]
+                                        { std::transform(input.begin(), input.end(), out.begin(), mix()); });
+            volatile int64_t sink = 0;
+            double reduce = best_seconds([&]
+                                         { sink = std::accumulate(input.begin(), input.end(), (int64_t)0); });
+            double each = best_seconds([&]
+                                       { std::for_each(work.begin(), work.end(), [](int64_t &x)
+                                                       { x += 3; }); });
+            double incl = best_seconds([&]
+                                       { std::partial_sum(input.begin(), input.end(), out.begin()); });
+            double count = best_seconds([&]
+                                        { sink = std::count_if(input.begin(), input.end(), is_odd()); });
+            double copy = best_seconds([&]
+                                       { std::copy_if(input.begin(), input.end(), out.begin(), is_odd()); });
+            (void)sink;
+            std::printf("%8s %10.1f %10.1f %10.1f %10.1f %10.1f %10s %10.1f %10.1f\n", "std", m / sort, m / trans,
+                        m / reduce, m / each, m / incl, "-", m / count, m / copy);
+            std::fflush(stdout);
+        }
+        for (size_t t = 1; t <= all; t = t * 2 <= all || t == all ? t * 2 : all)
+        {
+            lp::execution::parallel_policy policy = lp::execution::par(t);
+            double sort = best_seconds([&]
+                                       { work = input; },
+                                       [&]
+                                       { lp::sort(policy, work.begin(), work.end()); });
+            double trans = best_seconds([&]
+                                        { lp::transform(policy, input.begin(), input.end(), out.begin(), mix()); });
+            volatile int64_t sink = 0;
+            double reduce = best_seconds([&]
+                                         { sink = lp::reduce(policy, input.begin(), input.end()); });
+            double each = best_seconds([&]
+                                       { lp::for_each(policy, work.begin(), work.end(), [](int64_t &x)
+                                                      { x += 3; }); });
+            double incl = best_seconds([&]
+                                       { lp::inclusive_scan(policy, input.begin(), input.end(), out.begin()); });
+            double excl = best_seconds([&]
+                                       { lp::exclusive_scan(policy, input.begin(), input.end(), out.begin(), (int64_t)0); });
+            double count = best_seconds([&]
+                                        { sink = lp::count_if(policy, input.begin(), input.end(), is_odd()); });
+            double copy = best_seconds([&]
+                                       { lp::copy_if(policy, input.begin(), input.end(), out.begin(), is_odd()); });
+            (void)sink;
+            std::printf("%8zu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", t, m / sort, m / trans,
+                        m / reduce, m / each, m / incl, m / excl, m / count, m / copy);
+            std::fflush(stdout);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = 16 * 1024 * 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        n = (size_t)std::atoi(argv[1]);
+    }
+    size_t all = lp::thread_pool::instance().concurrency();
+    std::mt19937_64 gen(42);
+    vec input(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        input[i] = (int64_t)(gen() >> 20);
+    }
+    // 检查用较小的区间,但仍足够切成多段
+    vec small(input.begin(), input.begin() + (n < 300000 ? n : 300000));
+    check_all(small, all);
+    bench(input, all);
+    return all_ok ? 0 : 1;
+}
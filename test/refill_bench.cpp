@@ -0,0 +1,128 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+refill批量测试:固定每次20个 与 按规格自适应 的对比
+需要统计信息,因此本文件在包含头文件之前定义LP_ALLOC_STATS
+用法: refill_bench [热点对象个数]
+*/
+#define LP_ALLOC_STATS
+#include "1_allocator/lp_memory.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // 两个实例各自拥有独立的内存池,互不影响
+    using fixed_alloc = lp::_default_alloc_template<false, 1>;
+    using adaptive_alloc = lp::_default_alloc_template<false, 2>;
+
+    enum
+    {
+        _ROUNDS = 5,
+        _COLD_OBJS = 2 // 冷门规格每个只申请2个
+    };
+
+    struct refill_result
+    {
+        double seconds;
+        size_t chunk_allocs;
+        size_t refills;
+        size_t heap_size;
+        size_t idle_bytes; // 峰值时free_list中闲置的字节数
+        size_t cold_idle;  // 其中冷门规格(24..128 bytes)闲置的字节数
+    };
+
+    /*
+     * 8和16 bytes的热点对象反复成批申请,释放;24..128 bytes的冷门规格各只用两个,一直持有
+     * 固定批量下热点规格频繁回到chunk_alloc,冷门规格每个都多占19个对象
+     */
+    template <class Alloc>
+    refill_result run_workload(size_t hot_objs)
+    {
+        std::vector<void *> cold;
+        std::vector<void *> hot(2 * hot_objs);
+        refill_result r = {};
+        clock_type::time_point start = clock_type::now();
+        for (size_t size = 24; size <= 128; size += 8)
+        {
+            for (int i = 0; i < _COLD_OBJS; ++i)
+            {
+                cold.push_back(Alloc::allocate(size));
+            }
+        }
+        for (int round = 0; round < _ROUNDS; ++round)
+        {
+            for (size_t i = 0; i < hot_objs; ++i)
+            {
+                hot[2 * i] = Alloc::allocate(8);
+                hot[2 * i + 1] = Alloc::allocate(16);
+            }
+            if (0 == round)
+            {
+                lp::alloc_stats s = Alloc::stats();
+                for (size_t i = 0; i < s.classes.size(); ++i)
+                {
+                    r.idle_bytes += s.classes[i].free_bytes;
+                    if (s.classes[i].size >= 24)
+                    {
+                        r.cold_idle += s.classes[i].free_bytes;
+                    }
+                }
+            }
+            for (size_t i = 2 * hot_objs; i > 0; --i)
+            {
+                Alloc::deallocate(hot[i - 1], (i - 1) % 2 == 0 ? 8 : 16);
+            }
+        }
+        r.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        lp::alloc_stats s = Alloc::stats();
+        for (size_t i = 0; i < s.classes.size(); ++i)
+        {
+            r.refills += s.classes[i].refills;
+        }
+        r.chunk_allocs = s.chunk_allocs;
+        r.heap_size = s.heap_size;
+        for (size_t i = 0, k = 0; size_t(24) + 8 * i <= 128; ++i)
+        {
+            for (int j = 0; j < _COLD_OBJS; ++j, ++k)
+            {
+                Alloc::deallocate(cold[k], 24 + 8 * i);
+            }
+        }
+        return r;
+    }
+
+    void print_result(const char *name, const refill_result &r)
+    {
+        std::printf("%-18s %10.2f %12zu %10zu %12zu %12zu %12zu\n", name, r.seconds * 1e3,
+                    r.chunk_allocs, r.refills, r.heap_size, r.idle_bytes, r.cold_idle);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t hot_objs = 200000;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        hot_objs = (size_t)std::atoi(argv[1]);
+    }
+    // 原先的做法:每次固定20个
+    fixed_alloc::set_refill_bounds(20, 20);
+
+    std::printf("== refill batch sizing, %zu hot objects x 2 classes, %d rounds ==\n", hot_objs, (int)_ROUNDS);
+    std::printf("%-18s %10s %12s %10s %12s %12s %12s\n", "policy", "ms", "chunk_alloc", "refills",
+                "heap_size", "idle@peak", "cold idle");
+    print_result("fixed 20", run_workload<fixed_alloc>(hot_objs));
+    print_result("adaptive 4..512", run_workload<adaptive_alloc>(hot_objs));
+    std::printf("\n-- adaptive, per class --\n");
+    adaptive_alloc::print_stats(std::cout);
+    return 0;
+}
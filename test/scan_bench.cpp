@@ -0,0 +1,252 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+向量化扫描(lp_simd_scan.h)与libstdc++的对比
+数组用lp::vector(迭代器是连续迭代器);用法: scan_bench [每个数组的字节数,默认16M]
+先在各SIMD级别下检查find,find_if,count,count_if,mismatch,equal,min/max/minmax_element,accumulate,reduce
+与std的结果相同(短区间,各种长度,含NaN),再对int32_t,float,uint8_t报告吞吐量(GB/s),取最快一轮
+列依次为libstdc++与lp在generic,sse2,avx2,avx512各级别下的结果,只列出CPU支持的级别
+find与find_if要找的值不在数组中,都扫描整个数组
+*/
+#include "5_algorithm/lp_algorithm.h"
+#include "3_sequence_containers/lp_vector.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <stdint.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ROUNDS = 5
+    };
+
+    const char *level_names[lp::_SIMD_LEVELS] = {"generic", "sse2", "avx2", "avx512"};
+
+    bool all_ok = true;
+    volatile size_t sink = 0;
+
+    void check(const char *what, const char *type, size_t n, bool ok)
+    {
+        if (!ok)
+        {
+            all_ok = false;
+            std::printf("  MISMATCH: %s(%s), n = %zu, level %s\n", what, type, n, level_names[lp::simd_scan_level()]);
+        }
+    }
+
+    template <class E>
+    bool has_nan(const lp::vector<E> &v)
+    {
+        return std::any_of(v.begin(), v.end(), [](E x)
+                           { return x != x; });
+    }
+
+    // 各种长度(覆盖向量尾部与分块边界)与取值,浮点数中随机放入NaN
+    template <class E>
+    void check_type(const char *type, std::mt19937_64 &gen)
+    {
+        for (size_t n = 0; n < 1200; n += n < 130 ? 1 : 61)
+        {
+            lp::vector<E> v(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                v[i] = (E)(gen() % 50);
+            }
+            if (std::is_floating_point<E>::value && n > 0 && 0 == gen() % 3)
+            {
+                v[gen() % n] = (E)NAN;
+            }
+            for (int k = 0; k < 4; ++k)
+            {
+                E value = (E)(gen() % 60), lo = (E)(gen() % 50), hi = (E)(lo + gen() % 20);
+                check("find", type, n, lp::find(v.begin(), v.end(), value) == std::find(v.begin(), v.end(), value));
+                check("count", type, n, lp::count(v.begin(), v.end(), value) == std::count(v.begin(), v.end(), value));
+                check("count_if(between)", type, n, lp::count_if(v.begin(), v.end(), lp::value_between(lo, hi)) == std::count_if(v.begin(), v.end(), [&](E x)
+                                                                                                                                 { return lo <= x && x <= hi; }));
+                check("count_if(ne)", type, n, lp::count_if(v.begin(), v.end(), lp::value_ne(lo)) == std::count_if(v.begin(), v.end(), [&](E x)
+                                                                                                                   { return x != lo; }));
+                check("find_if(gt)", type, n, lp::find_if(v.begin(), v.end(), lp::value_gt(hi)) == std::find_if(v.begin(), v.end(), [&](E x)
+                                                                                                                { return x > hi; }));
+                check("find_if(le)", type, n, lp::find_if(v.begin(), v.end(), lp::value_le(lo)) == std::find_if(v.begin(), v.end(), [&](E x)
+                                                                                                                { return x <= lo; }));
+            }
+            check("min_element", type, n, lp::min_element(v.begin(), v.end()) == std::min_element(v.begin(), v.end()));
+            check("max_element", type, n, lp::max_element(v.begin(), v.end()) == std::max_element(v.begin(), v.end()));
+            // 有NaN时不是严格弱序,std::minmax_element没有确定的结果
+            if (!has_nan(v))
+            {
+                check("minmax_element", type, n, lp::minmax_element(v.begin(), v.end()) == std::minmax_element(v.begin(), v.end()));
+            }
+            lp::vector<E> w(v);
+            if (n > 0)
+            {
+                w[gen() % n] = (E)77;
+            }
+            check("mismatch", type, n, lp::mismatch(v.begin(), v.end(), w.begin()) == std::mismatch(v.begin(), v.end(), w.begin()));
+            check("equal", type, n, lp::equal(v.begin(), v.end(), w.begin()) == std::equal(v.begin(), v.end(), w.begin()));
+            check("equal(same)", type, n, lp::equal(v.begin(), v.end(), v.begin()) == std::equal(v.begin(), v.end(), v.begin()));
+            if (!std::is_floating_point<E>::value)
+            {
+                check("accumulate(int64)", type, n, lp::accumulate(v.begin(), v.end(), (int64_t)3) == std::accumulate(v.begin(), v.end(), (int64_t)3));
+                check("accumulate(uint8)", type, n, lp::accumulate(v.begin(), v.end(), (uint8_t)3) == std::accumulate(v.begin(), v.end(), (uint8_t)3));
+                check("reduce", type, n, lp::reduce(v.begin(), v.end()) == std::accumulate(v.begin(), v.end(), E()));
+            }
+            else if (!has_nan(v))
+            {
+                // 小整数值的和是精确的,分组不影响结果
+                check("reduce", type, n, lp::reduce(v.begin(), v.end()) == std::accumulate(v.begin(), v.end(), E()));
+            }
+        }
+    }
+
+    void check_all()
+    {
+        std::mt19937_64 gen(3);
+        const int best = lp::simd_scan_level();
+        for (int level = best; level >= lp::_SIMD_GENERIC; --level)
+        {
+            lp::simd_scan_level() = level;
+            check_type<int8_t>("int8_t", gen);
+            check_type<uint8_t>("uint8_t", gen);
+            check_type<int16_t>("int16_t", gen);
+            check_type<int32_t>("int32_t", gen);
+            check_type<uint32_t>("uint32_t", gen);
+            check_type<int64_t>("int64_t", gen);
+            check_type<float>("float", gen);
+            check_type<double>("double", gen);
+            // value不能表示为元素类型:uint8_t中没有-1
+            lp::vector<uint8_t> u(300, 255);
+            check("find(-1)", "uint8_t", u.size(), lp::find(u.begin(), u.end(), -1) == u.end());
+            check("count(255)", "uint8_t", u.size(), 300 == lp::count(u.begin(), u.end(), 255));
+            // 计数器需要中途并入总数
+            lp::vector<uint8_t> big(100000, 7);
+            check("count(7)", "uint8_t", big.size(), 100000 == lp::count(big.begin(), big.end(), 7));
+        }
+        lp::simd_scan_level() = best;
+        std::printf("correctness checks: %s\n", all_ok ? "ok" : "FAILED");
+    }
+
+    // 返回最快一轮的GB/s,bytes为一轮读取的字节数
+    template <class Op>
+    double best_gbps(size_t bytes, Op op)
+    {
+        double best = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            clock_type::time_point start = clock_type::now();
+            op();
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            best = 0 == r || secs < best ? secs : best;
+        }
+        return bytes / best / 1e9;
+    }
+
+    // 一行:std的吞吐量,然后是lp在每个级别下的吞吐量
+    template <class StdOp, class LpOp>
+    void row(const char *name, size_t bytes, StdOp std_op, LpOp lp_op)
+    {
+        const int best = lp::simd_scan_level();
+        std::printf("%-16s %9.2f", name, best_gbps(bytes, std_op));
+        for (int level = lp::_SIMD_GENERIC; level <= best; ++level)
+        {
+            lp::simd_scan_level() = level;
+            std::printf(" %9.2f", best_gbps(bytes, lp_op));
+        }
+        lp::simd_scan_level() = best;
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    template <class E>
+    void bench(const char *type, size_t bytes)
+    {
+        const size_t n = bytes / sizeof(E);
+        std::mt19937_64 gen(11);
+        lp::vector<E> v(n), w;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = (E)(gen() % 100);
+        }
+        w = v;
+        const E absent = (E)101, lo = (E)10, hi = (E)40;
+        std::printf("== %s, %zu elements, GB/s ==\n%-16s %9s", type, n, "op", "std");
+        for (int level = lp::_SIMD_GENERIC; level <= lp::simd_scan_level(); ++level)
+        {
+            std::printf(" %9s", level_names[level]);
+        }
+        std::printf("\n");
+        row("find", bytes, [&]
+            { sink = std::find(v.begin(), v.end(), absent) - v.begin(); },
+            [&]
+            { sink = lp::find(v.begin(), v.end(), absent) - v.begin(); });
+        row("find_if(gt)", bytes, [&]
+            { sink = std::find_if(v.begin(), v.end(), [&](E x)
+                                  { return x > absent; }) -
+                     v.begin(); },
+            [&]
+            { sink = lp::find_if(v.begin(), v.end(), lp::value_gt(absent)) - v.begin(); });
+        row("count", bytes, [&]
+            { sink = std::count(v.begin(), v.end(), lo); },
+            [&]
+            { sink = lp::count(v.begin(), v.end(), lo); });
+        row("count_if(btw)", bytes, [&]
+            { sink = std::count_if(v.begin(), v.end(), [&](E x)
+                                   { return lo <= x && x <= hi; }); },
+            [&]
+            { sink = lp::count_if(v.begin(), v.end(), lp::value_between(lo, hi)); });
+        row("min_element", bytes, [&]
+            { sink = std::min_element(v.begin(), v.end()) - v.begin(); },
+            [&]
+            { sink = lp::min_element(v.begin(), v.end()) - v.begin(); });
+        row("minmax_element", bytes, [&]
+            { sink = std::minmax_element(v.begin(), v.end()).second - v.begin(); },
+            [&]
+            { sink = lp::minmax_element(v.begin(), v.end()).second - v.begin(); });
+        // mismatch读两个数组
+        row("mismatch", 2 * bytes, [&]
+            { sink = std::mismatch(v.begin(), v.end(), w.begin()).first - v.begin(); },
+            [&]
+            { sink = lp::mismatch(v.begin(), v.end(), w.begin()).first - v.begin(); });
+        if (std::is_floating_point<E>::value)
+        {
+            row("reduce", bytes, [&]
+                { sink = (size_t)std::accumulate(v.begin(), v.end(), E()); },
+                [&]
+                { sink = (size_t)lp::reduce(v.begin(), v.end(), E()); });
+        }
+        else
+        {
+            row("accumulate(i64)", bytes, [&]
+                { sink = (size_t)std::accumulate(v.begin(), v.end(), (int64_t)0); },
+                [&]
+                { sink = (size_t)lp::accumulate(v.begin(), v.end(), (int64_t)0); });
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t bytes = 16 * 1024 * 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        bytes = (size_t)std::atoi(argv[1]);
+    }
+    check_all();
+    bench<int32_t>("int32_t", bytes);
+    bench<float>("float", bytes);
+    bench<uint8_t>("uint8_t", bytes);
+    std::printf("%s\n", all_ok ? "all results match" : "MISMATCH");
+    return all_ok ? 0 : 1;
+}
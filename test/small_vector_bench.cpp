@@ -0,0 +1,287 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+small_vector(lp_small_vector.h)与vector的对比
+用法: small_vector_bench [每种大小重复的次数,默认200000]
+先用随机操作序列检查small_vector<int>,<std::string>,<std::unique_ptr>与std::vector的结果相同,
+再对0到64个元素报告每个容器从构造,push_back到析构的分配次数与耗时(ns),取最快一轮
+*/
+#include "3_sequence_containers/lp_small_vector.h"
+#include "3_sequence_containers/lp_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ROUNDS = 5,
+        _CHECK_OPS = 20000
+    };
+
+    // 统计分配次数的配置器,其余都交给lp::alloc
+    struct counting_alloc
+    {
+        static size_t allocations;
+
+        static void *allocate(size_t n)
+        {
+            ++allocations;
+            return lp::alloc::allocate(n);
+        }
+        static void deallocate(void *p, size_t n) { lp::alloc::deallocate(p, n); }
+        static void *reallocate(void *p, size_t old_size, size_t new_size)
+        {
+            ++allocations;
+            return lp::alloc::reallocate(p, old_size, new_size);
+        }
+        static size_t good_size(size_t n) { return lp::alloc::good_size(n); }
+    };
+    size_t counting_alloc::allocations = 0;
+
+    bool all_ok = true;
+    volatile int64_t sink = 0;
+
+    // region:正确性
+    // 以k生成元素,Maker为各元素类型提供make与value
+    struct int_maker
+    {
+        using type = int;
+        static int make(int k) { return k; }
+        static int value(const int &x) { return x; }
+    };
+
+    struct string_maker
+    {
+        using type = std::string;
+        // 一部分超过短字符串优化的长度
+        static std::string make(int k) { return std::to_string(k) + (k % 3 ? "" : std::string(40, 'x')); }
+        static int value(const std::string &x) { return std::atoi(x.c_str()); }
+    };
+
+    struct ptr_maker
+    {
+        using type = std::unique_ptr<int>;
+        static std::unique_ptr<int> make(int k) { return std::unique_ptr<int>(new int(k)); }
+        static int value(const std::unique_ptr<int> &x) { return *x; }
+    };
+
+    template <class Maker, class SmallVector>
+    bool same(const SmallVector &v, const std::vector<int> &expect)
+    {
+        if (v.size() != expect.size() || v.capacity() < v.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < expect.size(); ++i)
+        {
+            if (Maker::value(v[i]) != expect[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // 只能移动的类型没有拷贝操作
+    template <class Maker, class SmallVector>
+    void check_copy(SmallVector &v, std::vector<int> &expect, std::true_type)
+    {
+        SmallVector c(v);
+        all_ok = all_ok && same<Maker>(c, expect);
+        c.push_back(Maker::make(-1));
+        v = c;
+        expect.push_back(-1);
+        if (!expect.empty())
+        {
+            // 插入本身的元素
+            v.insert(v.begin(), 2, v.back());
+            expect.insert(expect.begin(), 2, expect.back());
+        }
+    }
+
+    template <class Maker, class SmallVector>
+    void check_copy(SmallVector &, std::vector<int> &, std::false_type)
+    {
+    }
+
+    template <class Maker, size_t N>
+    void check_type(const char *name)
+    {
+        using T = typename Maker::type;
+        using small = lp::small_vector<T, N, counting_alloc>;
+        std::mt19937 gen(7);
+        small v;
+        std::vector<int> expect;
+        for (int op = 0; op < _CHECK_OPS; ++op)
+        {
+            const int k = (int)(gen() % 1000);
+            const size_t pos = expect.empty() ? 0 : gen() % (expect.size() + 1);
+            switch (gen() % 14)
+            {
+            case 0:
+            case 1:
+            case 2:
+                v.push_back(Maker::make(k));
+                expect.push_back(k);
+                break;
+            case 3:
+                v.emplace(v.begin() + pos, Maker::make(k));
+                expect.insert(expect.begin() + pos, k);
+                break;
+            case 4:
+                if (!expect.empty())
+                {
+                    v.pop_back();
+                    expect.pop_back();
+                }
+                break;
+            case 5:
+                if (pos < expect.size())
+                {
+                    v.erase(v.begin() + pos);
+                    expect.erase(expect.begin() + pos);
+                }
+                break;
+            case 6:
+                if (expect.size() > 20)
+                {
+                    v.erase(v.begin() + 3, v.end() - 5);
+                    expect.erase(expect.begin() + 3, expect.end() - 5);
+                }
+                break;
+            case 7:
+            {
+                // 在内部缓冲区与堆之间移动
+                small m(std::move(v));
+                all_ok = all_ok && v.empty() && v.is_inline();
+                v = std::move(m);
+                break;
+            }
+            case 8:
+            {
+                small other;
+                other.push_back(Maker::make(k));
+                v.swap(other);
+                other.swap(v);
+                break;
+            }
+            case 9:
+                v.reserve(expect.size() + gen() % 8);
+                break;
+            case 10:
+                v.shrink_to_fit();
+                all_ok = all_ok && (expect.size() <= N) == v.is_inline();
+                break;
+            case 11:
+                check_copy<Maker>(v, expect, std::is_copy_constructible<T>());
+                break;
+            case 12:
+                if (expect.size() > 50)
+                {
+                    v.clear();
+                    expect.clear();
+                }
+                break;
+            default:
+                v.resize(expect.size() + gen() % 3);
+                while (expect.size() < v.size())
+                {
+                    v[expect.size()] = Maker::make(k);
+                    expect.push_back(k);
+                }
+                break;
+            }
+            if (!same<Maker>(v, expect))
+            {
+                std::printf("  MISMATCH: %s after op %d\n", name, op);
+                all_ok = false;
+                return;
+            }
+        }
+    }
+
+    void check_all()
+    {
+        check_type<int_maker, 4>("small_vector<int, 4>");
+        check_type<string_maker, 4>("small_vector<std::string, 4>");
+        check_type<ptr_maker, 4>("small_vector<std::unique_ptr<int>, 4>");
+        check_type<int_maker, 1>("small_vector<int, 1>");
+        std::printf("correctness checks: %s\n", all_ok ? "ok" : "FAILED");
+    }
+    // endregion
+
+    // region:性能
+    // 每个容器的最快耗时(ns)与分配次数
+    template <class Container, bool Reserve>
+    void bench_one(size_t size, size_t reps)
+    {
+        double best = 0;
+        size_t allocs = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            counting_alloc::allocations = 0;
+            clock_type::time_point start = clock_type::now();
+            for (size_t i = 0; i < reps; ++i)
+            {
+                Container c;
+                if (Reserve)
+                {
+                    c.reserve(size);
+                }
+                for (size_t k = 0; k < size; ++k)
+                {
+                    c.push_back((int64_t)k);
+                }
+                sink = sink + (int64_t)c.size();
+            }
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            allocs = counting_alloc::allocations;
+            best = 0 == r || secs < best ? secs : best;
+        }
+        std::printf(" %7.2f %7.1f", (double)allocs / reps, best * 1e9 / reps);
+    }
+
+    void bench(size_t reps)
+    {
+        const size_t sizes[] = {0, 1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64};
+        std::printf("== construct, push_back int64_t, destroy; %zu reps, allocs and ns per container ==\n", reps);
+        std::printf("%5s %15s %15s %15s %15s\n", "size", "vector", "vector+reserve", "small<8>", "small<16>");
+        for (size_t size : sizes)
+        {
+            std::printf("%5zu", size);
+            bench_one<lp::vector<int64_t, counting_alloc>, false>(size, reps);
+            bench_one<lp::vector<int64_t, counting_alloc>, true>(size, reps);
+            bench_one<lp::small_vector<int64_t, 8, counting_alloc>, false>(size, reps);
+            bench_one<lp::small_vector<int64_t, 16, counting_alloc>, false>(size, reps);
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+    }
+    // endregion
+}
+
+int main(int argc, char **argv)
+{
+    size_t reps = 200000;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        reps = (size_t)std::atoi(argv[1]);
+    }
+    check_all();
+    bench(reps);
+    std::printf("%s\n", all_ok ? "all results match" : "MISMATCH");
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+排序算法(lp_sort.h)与libstdc++的对比
+用法: sort_bench [元素个数,默认4M]
+输入分布:random(均匀随机),sorted(有序),reversed(逆序),few_unique(16种取值),sorted+1%(有序后随机改1%)
+元素类型:uint64_t,double,{uint64_t key,uint64_t payload}(按key排序,检查稳定性)
+每一项先检查结果与std::sort/std::stable_sort相同,再报告每个元素的平均耗时(ns),取最快一轮
+*/
+#include "5_algorithm/lp_algorithm.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ROUNDS = 3
+    };
+
+    bool all_ok = true;
+
+    struct record
+    {
+        uint64_t key;
+        uint64_t payload; // 输入中的位置,用来检查稳定性
+    };
+
+    bool operator==(const record &a, const record &b)
+    {
+        return a.key == b.key && a.payload == b.payload;
+    }
+
+    struct key_less
+    {
+        bool operator()(const record &a, const record &b) const { return a.key < b.key; }
+    };
+
+    struct key_of
+    {
+        uint64_t operator()(const record &r) const { return r.key; }
+    };
+
+    // 生成n个不大于2^52的键,分布由name决定
+    std::vector<uint64_t> make_keys(const std::string &name, size_t n)
+    {
+        std::mt19937_64 gen(7);
+        std::vector<uint64_t> v(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = gen() >> 12;
+        }
+        if ("few_unique" == name)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                v[i] = (v[i] % 16) << 40;
+            }
+        }
+        else if ("sorted" == name || "sorted+1%" == name)
+        {
+            std::sort(v.begin(), v.end());
+        }
+        else if ("reversed" == name)
+        {
+            std::sort(v.begin(), v.end(), std::greater<uint64_t>());
+        }
+        if ("sorted+1%" == name)
+        {
+            for (size_t i = 0; i < n / 100; ++i)
+            {
+                v[gen() % n] = gen() >> 12;
+            }
+        }
+        return v;
+    }
+
+    // 每轮把input复制到work(不计时)再排序,返回最快一轮每个元素的ns
+    template <class T, class Sort>
+    double best_ns(const std::vector<T> &input, std::vector<T> &work, Sort sort)
+    {
+        double best = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            work = input;
+            clock_type::time_point start = clock_type::now();
+            sort(work);
+            double ns = std::chrono::duration<double>(clock_type::now() - start).count() * 1e9 / input.size();
+            best = 0 == r || ns < best ? ns : best;
+        }
+        return best;
+    }
+
+    template <class T>
+    void check(const char *what, const std::vector<T> &got, const std::vector<T> &expect)
+    {
+        if (!(got == expect))
+        {
+            all_ok = false;
+            std::printf("  MISMATCH: %s\n", what);
+        }
+    }
+
+    void print_header(const char *type)
+    {
+        std::printf("== %s, ns/element ==\n", type);
+        std::printf("%-12s %10s %10s %12s %12s %10s\n", "input", "std::sort", "lp::sort", "std::stable", "lp::stable",
+                    "lp::radix");
+    }
+
+    template <class T>
+    void bench_plain(const char *dist, const std::vector<T> &input)
+    {
+        std::vector<T> expect(input), work;
+        std::sort(expect.begin(), expect.end());
+        double s = best_ns(input, work, [](std::vector<T> &v)
+                           { std::sort(v.begin(), v.end()); });
+        double l = best_ns(input, work, [](std::vector<T> &v)
+                           { lp::sort(v.begin(), v.end()); });
+        check("lp::sort", work, expect);
+        double ss = best_ns(input, work, [](std::vector<T> &v)
+                            { std::stable_sort(v.begin(), v.end()); });
+        double ls = best_ns(input, work, [](std::vector<T> &v)
+                            { lp::stable_sort(v.begin(), v.end()); });
+        check("lp::stable_sort", work, expect);
+        double lr = best_ns(input, work, [](std::vector<T> &v)
+                            { lp::radix_sort(v.begin(), v.end()); });
+        check("lp::radix_sort", work, expect);
+        std::printf("%-12s %10.2f %10.2f %12.2f %12.2f %10.2f\n", dist, s, l, ss, ls, lr);
+        std::fflush(stdout);
+    }
+
+    void bench_records(const char *dist, const std::vector<record> &input)
+    {
+        std::vector<record> expect(input), work;
+        std::stable_sort(expect.begin(), expect.end(), key_less());
+        double s = best_ns(input, work, [](std::vector<record> &v)
+                           { std::sort(v.begin(), v.end(), key_less()); });
+        double l = best_ns(input, work, [](std::vector<record> &v)
+                           { lp::sort(v.begin(), v.end(), key_less()); });
+        // sort不稳定,只检查键的顺序
+        bool keys_ok = work.size() == expect.size();
+        for (size_t i = 0; keys_ok && i < work.size(); ++i)
+        {
+            keys_ok = work[i].key == expect[i].key;
+        }
+        if (!keys_ok)
+        {
+            all_ok = false;
+            std::printf("  MISMATCH: lp::sort\n");
+        }
+        double ss = best_ns(input, work, [](std::vector<record> &v)
+                            { std::stable_sort(v.begin(), v.end(), key_less()); });
+        double ls = best_ns(input, work, [](std::vector<record> &v)
+                            { lp::stable_sort(v.begin(), v.end(), key_less()); });
+        check("lp::stable_sort", work, expect);
+        double lr = best_ns(input, work, [](std::vector<record> &v)
+                            { lp::radix_sort(v.begin(), v.end(), key_of()); });
+        check("lp::radix_sort(key)", work, expect);
+        std::printf("%-12s %10.2f %10.2f %12.2f %12.2f %10.2f\n", dist, s, l, ss, ls, lr);
+        std::fflush(stdout);
+    }
+
+    // 边界情况:空区间,短区间,负数,-0.0,NaN以外的浮点数
+    void check_small()
+    {
+        std::mt19937_64 gen(1);
+        for (size_t n = 0; n < 600; n += 7)
+        {
+            std::vector<int32_t> a(n);
+            std::vector<double> d(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                a[i] = (int32_t)gen();
+                d[i] = ((int64_t)gen() >> 20) / 1024.0;
+            }
+            std::vector<int32_t> ea(a), wa(a);
+            std::sort(ea.begin(), ea.end());
+            lp::sort(wa.begin(), wa.end());
+            check("lp::sort(int32)", wa, ea);
+            wa = a;
+            lp::stable_sort(wa.begin(), wa.end());
+            check("lp::stable_sort(int32)", wa, ea);
+            wa = a;
+            lp::radix_sort(wa.begin(), wa.end());
+            check("lp::radix_sort(int32)", wa, ea);
+            std::vector<double> ed(d), wd(d);
+            std::sort(ed.begin(), ed.end());
+            lp::radix_sort(wd.begin(), wd.end());
+            check("lp::radix_sort(double)", wd, ed);
+            std::vector<std::string> s(n), es;
+            for (size_t i = 0; i < n; ++i)
+            {
+                s[i] = std::to_string(gen() % 100);
+            }
+            es = s;
+            std::stable_sort(es.begin(), es.end());
+            std::vector<std::string> ws(s);
+            lp::sort(ws.begin(), ws.end());
+            check("lp::sort(string)", ws, es);
+            ws = s;
+            lp::stable_sort(ws.begin(), ws.end());
+            check("lp::stable_sort(string)", ws, es);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = 4 * 1024 * 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        n = (size_t)std::atoi(argv[1]);
+    }
+    check_small();
+    const char *dists[] = {"random", "sorted", "reversed", "few_unique", "sorted+1%"};
+    print_header("uint64_t");
+    for (const char *dist : dists)
+    {
+        bench_plain(dist, make_keys(dist, n));
+    }
+    print_header("double");
+    for (const char *dist : dists)
+    {
+        std::vector<uint64_t> keys = make_keys(dist, n);
+        std::vector<double> input(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            input[i] = (double)keys[i] - (double)(1ull << 51); // 一半是负数
+        }
+        bench_plain(dist, input);
+    }
+    print_header("{uint64_t key, uint64_t payload}");
+    for (const char *dist : dists)
+    {
+        std::vector<uint64_t> keys = make_keys(dist, n);
+        std::vector<record> input(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            input[i].key = keys[i];
+            input[i].payload = i;
+        }
+        bench_records(dist, input);
+    }
+    std::printf("%s\n", all_ok ? "all results match" : "MISMATCH");
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,701 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+vector性能测试
+用法: vector_bench [随机访问缓冲区MB数] [push_back元素个数] [string与unique_ptr个数]
+增长策略测试与批量追加测试的元素个数为第二个参数的四分之一
+*/
+#include "1_allocator/lp_memory.h"
+#include "3_sequence_containers/lp_vector.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    double seconds_since(clock_type::time_point start)
+    {
+        return std::chrono::duration<double>(clock_type::now() - start).count();
+    }
+
+    // 本进程当前由透明大页承载的匿名内存(KB),读不到时返回-1
+    long anon_huge_kb()
+    {
+        std::ifstream in("/proc/self/smaps_rollup");
+        std::string key;
+        long kb;
+        while (in >> key)
+        {
+            if ("AnonHugePages:" == key && in >> kb)
+            {
+                return kb;
+            }
+        }
+        return -1;
+    }
+
+    // region:大页随机访问测试
+    // 在大缓冲区上做指针追逐,每次访问都依赖上一次的结果,耗时主要取决于cache和TLB缺失
+    using mmap_alloc = lp::_malloc_alloc_template<0, lp::mmap_chunk_source>;
+    using hugetlb_alloc = lp::_malloc_alloc_template<0, lp::hugetlb_chunk_source>;
+
+    enum
+    {
+        _CHASE_STEPS = 20000000
+    };
+
+    template <class Alloc>
+    void bench_random_access(const char *name, size_t n)
+    {
+        long huge_before = anon_huge_kb();
+        clock_type::time_point start = clock_type::now();
+        lp::vector<uint64_t, Alloc> v(n, 0);
+        // n为2的幂,x -> (a * x + c) mod n 在a % 4 == 1且c为奇数时是一个覆盖全部下标的环
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = (i * 6364136223846793005ull + 1442695040888963407ull) & (n - 1);
+        }
+        double fill_secs = seconds_since(start);
+        long huge_after = anon_huge_kb();
+
+        start = clock_type::now();
+        uint64_t x = 0;
+        for (int i = 0; i < _CHASE_STEPS; ++i)
+        {
+            x = v[x];
+        }
+        double secs = seconds_since(start);
+        std::printf("%-16s %10.1f %12.2f %14ld   (x=%llu)\n", name, fill_secs * 1e3,
+                    secs * 1e9 / _CHASE_STEPS, huge_before < 0 ? -1 : (huge_after - huge_before) / 1024,
+                    (unsigned long long)x);
+    }
+
+    void bench_huge_pages(size_t mbytes)
+    {
+        size_t n = 1;
+        while (n * 2 * sizeof(uint64_t) <= mbytes * 1024 * 1024)
+        {
+            n *= 2;
+        }
+        std::printf("== random access over lp::vector<uint64_t>, %zu MB ==\n", n * sizeof(uint64_t) >> 20);
+        std::printf("%-16s %10s %12s %14s\n", "allocator", "fill ms", "ns/access", "THP MB");
+        bench_random_access<lp::malloc_alloc>("malloc_alloc", n);
+        bench_random_access<mmap_alloc>("mmap 4KB", n);
+        bench_random_access<lp::huge_page_alloc>("huge_page_alloc", n);
+        bench_random_access<hugetlb_alloc>("hugetlb", n);
+    }
+    // endregion
+
+    // region:默认初始化测试
+    // 模拟从文件或socket读入一整块缓冲区:先构造vector<uint8_t>,再整体覆盖
+    // 值初始化先清零一遍,内存流量是默认初始化的两倍
+    template <class Init>
+    double fill_buffer(size_t n, Init init)
+    {
+        clock_type::time_point start = clock_type::now();
+        lp::vector<uint8_t> buf = init(n);
+        memset(buf.begin(), 0xab, n);
+        double secs = seconds_since(start);
+        if (0xab != buf[n / 2])
+        {
+            std::printf("bad buffer\n");
+        }
+        return secs;
+    }
+
+    void bench_default_init(size_t mbytes)
+    {
+        size_t n = mbytes * 1024 * 1024;
+        std::printf("== construct + overwrite lp::vector<uint8_t> of %zu MB ==\n", mbytes);
+        std::printf("%-28s %10s %12s\n", "construction", "ms", "GB/s");
+        const char *names[] = {"vector(n) (zero first)", "vector(n, default_init)"};
+        for (int round = 0; round < 2; ++round)
+        {
+            // 第一轮让malloc把区块映射好,只报告第二轮
+            double value = fill_buffer(n, [](size_t k)
+                                       { return lp::vector<uint8_t>(k); });
+            double deflt = fill_buffer(n, [](size_t k)
+                                       { return lp::vector<uint8_t>(k, lp::default_init); });
+            if (1 == round)
+            {
+                std::printf("%-28s %10.1f %12.2f\n", names[0], value * 1e3, n / value / 1e9);
+                std::printf("%-28s %10.1f %12.2f\n", names[1], deflt * 1e3, n / deflt / 1e9);
+            }
+        }
+    }
+    // endregion
+
+    // region:push_back扩容测试
+    // int64_t平凡可拷贝,扩容走reallocate;copied_int64有自定义的拷贝构造函数,扩容走逐个拷贝
+    struct copied_int64
+    {
+        int64_t value;
+        copied_int64(int64_t v) : value(v) {}
+        copied_int64(const copied_int64 &x) : value(x.value) {}
+        copied_int64 &operator=(const copied_int64 &x)
+        {
+            value = x.value;
+            return *this;
+        }
+    };
+
+    template <class T, class Alloc>
+    void bench_push_back(const char *name, size_t n)
+    {
+        clock_type::time_point start = clock_type::now();
+        lp::vector<T, Alloc> v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(T((int64_t)i));
+        }
+        double secs = seconds_since(start);
+        std::printf("%-28s %10.1f %12.1f   (back=%lld)\n", name, secs * 1e3, n / secs / 1e6,
+                    (long long)*(const int64_t *)&v.back());
+    }
+
+    void bench_growth(size_t n)
+    {
+        std::printf("== push_back growth to %zu int64 ==\n", n);
+        std::printf("%-28s %10s %12s\n", "path", "ms", "Melem/s");
+        bench_push_back<copied_int64, lp::alloc>("copy, alloc", n);
+        bench_push_back<int64_t, lp::alloc>("reallocate, alloc", n);
+        bench_push_back<copied_int64, lp::huge_page_alloc>("copy, huge_page_alloc", n);
+        bench_push_back<int64_t, lp::huge_page_alloc>("reallocate, huge_page_alloc", n);
+    }
+    // endregion
+
+    // region:增长策略测试
+    // 统计当前与峰值字节数的配置器,其余都交给lp::alloc;good_size也转发,growth_aligned据此取整
+    // 字节数按配置器实际给出的区块大小(good_size)计算
+    // reallocate按原地扩展计算(大区块由realloc/mremap扩展),峰值只算新区块
+    struct peak_alloc
+    {
+        static size_t live, peak, calls;
+
+        static void grow(size_t n)
+        {
+            live += good_size(n);
+            peak = live > peak ? live : peak;
+            ++calls;
+        }
+        static void reset()
+        {
+            live = peak = calls = 0;
+        }
+        static void *allocate(size_t n)
+        {
+            grow(n);
+            return lp::alloc::allocate(n);
+        }
+        static void deallocate(void *p, size_t n)
+        {
+            live -= good_size(n);
+            lp::alloc::deallocate(p, n);
+        }
+        static void *reallocate(void *p, size_t old_size, size_t new_size)
+        {
+            live -= good_size(old_size);
+            grow(new_size);
+            return lp::alloc::reallocate(p, old_size, new_size);
+        }
+        static size_t good_size(size_t n) { return lp::alloc::good_size(n); }
+    };
+    size_t peak_alloc::live = 0;
+    size_t peak_alloc::peak = 0;
+    size_t peak_alloc::calls = 0;
+
+    enum
+    {
+        _SMALL_VECTORS = 200000, // 小vector测试的个数
+        _SMALL_MAX = 40          // 每个小vector的元素个数在[1,_SMALL_MAX]中
+    };
+
+    bool growth_ok = true;
+
+    // reserve,shrink_to_fit,容量不小于元素个数
+    template <class Growth>
+    void check_growth()
+    {
+        lp::vector<copied_int64, peak_alloc, Growth> v;
+        lp::vector<int64_t, peak_alloc, Growth> w;
+        for (int64_t i = 0; i < 1000; ++i)
+        {
+            v.push_back(copied_int64(i));
+            w.push_back(i);
+            growth_ok = growth_ok && v.capacity() >= v.size() && w.capacity() >= w.size();
+        }
+        v.reserve(5000);
+        w.reserve(5000);
+        growth_ok = growth_ok && v.capacity() >= 5000 && w.capacity() >= 5000 && 999 == v[999].value && 999 == w[999];
+        v.shrink_to_fit();
+        w.shrink_to_fit();
+        growth_ok = growth_ok && 1000 == v.capacity() && 1000 == w.capacity() && 8000 == w.capacity_bytes() &&
+                    500 == v[500].value && 500 == w[500];
+        v.clear();
+        v.shrink_to_fit();
+        growth_ok = growth_ok && 0 == v.capacity();
+    }
+
+    // 一个大vector:吞吐量,峰值内存,最终的空闲比例
+    template <class T, class Growth>
+    void bench_policy_large(const char *name, size_t n)
+    {
+        peak_alloc::reset();
+        clock_type::time_point start = clock_type::now();
+        double slack;
+        {
+            lp::vector<T, peak_alloc, Growth> v;
+            for (size_t i = 0; i < n; ++i)
+            {
+                v.push_back(T((int64_t)i));
+            }
+            slack = 1.0 - (double)v.size() / v.capacity();
+        }
+        double secs = seconds_since(start);
+        std::printf("%-28s %10.1f %10.1f %10.1f %8zu\n", name, n / secs / 1e6, peak_alloc::peak / 1048576.0,
+                    slack * 100, peak_alloc::calls);
+    }
+
+    // 很多小vector同时存在:分配次数,占用的字节数与元素字节数之比
+    template <class Growth>
+    void bench_policy_small(const char *name, const lp::vector<uint8_t> &sizes)
+    {
+        peak_alloc::reset();
+        clock_type::time_point start = clock_type::now();
+        size_t used = 0;
+        {
+            lp::vector<lp::vector<int32_t, peak_alloc, Growth>> vs(sizes.size());
+            for (size_t i = 0; i < sizes.size(); ++i)
+            {
+                for (int32_t k = 0; k < sizes[i]; ++k)
+                {
+                    vs[i].push_back(k);
+                }
+                used += sizes[i] * sizeof(int32_t);
+            }
+        }
+        double secs = seconds_since(start);
+        std::printf("%-28s %10.1f %10.2f %10.2f %8zu\n", name, used / sizeof(int32_t) / secs / 1e6,
+                    peak_alloc::peak / 1048576.0, (double)peak_alloc::peak / used, peak_alloc::calls);
+    }
+
+    template <class Growth>
+    void bench_policy(const char *name, size_t n, const lp::vector<uint8_t> &sizes)
+    {
+        check_growth<Growth>();
+        std::string s(name);
+        bench_policy_large<int64_t, Growth>((s + ", reallocate").c_str(), n);
+        bench_policy_large<copied_int64, Growth>((s + ", copy").c_str(), n);
+        bench_policy_small<Growth>((s + ", small").c_str(), sizes);
+    }
+
+    void bench_growth_policies(size_t n)
+    {
+        lp::vector<uint8_t> sizes(_SMALL_VECTORS);
+        uint64_t x = 88172645463325252ull;
+        for (size_t i = 0; i < sizes.size(); ++i)
+        {
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+            sizes[i] = (uint8_t)(1 + x % _SMALL_MAX);
+        }
+        std::printf("== growth policies: push_back %zu int64 / %d vectors of 1..%d int32 ==\n", n,
+                    (int)_SMALL_VECTORS, (int)_SMALL_MAX);
+        std::printf("%-28s %10s %10s %10s %8s\n", "policy, path", "Melem/s", "peak MB", "slack%|x", "allocs");
+        bench_policy<lp::growth_2x>("2x", n, sizes);
+        bench_policy<lp::growth_1_5x>("1.5x", n, sizes);
+        bench_policy<lp::growth_aligned<lp::growth_2x>>("aligned 2x", n, sizes);
+        bench_policy<lp::growth_aligned<>>("aligned 1.5x", n, sizes);
+        std::printf("large rows: slack%% = unused capacity at the end; small rows: x = peak bytes / element bytes\n");
+        std::printf("reserve/shrink_to_fit checks: %s\n", growth_ok ? "ok" : "FAILED");
+    }
+    // endregion
+
+    // region:批量追加测试
+    // 模拟把解码出的记录一批一批追加到vector:逐个push_back,reserve后push_back,
+    // reserve后push_back_unchecked,以及append整批追加(源为指针或std::list)
+    struct record
+    {
+        int64_t id;
+        double value;
+        int32_t a, b;
+    };
+
+    enum
+    {
+        _CHECK_ROUNDS = 300
+    };
+
+    bool ingest_ok = true;
+
+    template <class T, class Make>
+    void check_range_insert_type(Make make)
+    {
+        uint64_t x = 2463534242ull;
+        lp::vector<T> v;
+        std::vector<T> expect;
+        for (int r = 0; r < _CHECK_ROUNDS; ++r)
+        {
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+            const size_t n = x % 9;
+            size_t pos = expect.empty() ? 0 : (x >> 8) % (expect.size() + 1);
+            std::vector<T> src;
+            for (size_t i = 0; i < n; ++i)
+            {
+                src.push_back(make((int64_t)(x >> 16) + (int64_t)i));
+            }
+            std::list<T> src_list(src.begin(), src.end());
+            switch ((x >> 32) % 4)
+            {
+            case 0:
+                v.insert(v.begin() + pos, src.data(), src.data() + n);
+                break;
+            case 1:
+                v.insert(v.begin() + pos, src_list.begin(), src_list.end());
+                break;
+            case 2:
+            {
+                // 输入迭代器逐个插入
+                std::ostringstream out;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out << (int64_t)(x >> 16) + (int64_t)i << ' ';
+                }
+                std::istringstream in(out.str());
+                lp::vector<int64_t> ids;
+                ids.insert(ids.begin(), std::istream_iterator<int64_t>(in), std::istream_iterator<int64_t>());
+                for (size_t i = 0; i < n; ++i)
+                {
+                    v.insert(v.begin() + pos + i, make(ids[i]));
+                }
+                break;
+            }
+            default:
+                v.append(src_list.begin(), src_list.end());
+                v.append(src.data(), 0);
+                pos = expect.size();
+                break;
+            }
+            expect.insert(expect.begin() + pos, src.begin(), src.end());
+            ingest_ok = ingest_ok && v.size() == expect.size() && std::equal(expect.begin(), expect.end(), v.begin());
+        }
+        // reserve之后的unchecked版本
+        lp::vector<T> w;
+        w.reserve(100);
+        for (int64_t i = 0; i < 100; ++i)
+        {
+            w.push_back_unchecked(make(i));
+        }
+        ingest_ok = ingest_ok && 100 == w.size() && make(99) == w[99];
+    }
+
+    struct copied_value
+    {
+        int64_t value;
+        copied_value(int64_t v) : value(v) {}
+        copied_value(const copied_value &x) : value(x.value) {}
+        copied_value &operator=(const copied_value &x)
+        {
+            value = x.value;
+            return *this;
+        }
+        bool operator==(const copied_value &x) const { return value == x.value; }
+    };
+
+    // 源元素类型与vector不同:以const char*区间构造std::string
+    void check_range_insert_convert()
+    {
+        const char *words[] = {"a", "bb", "ccc", "a string longer than the small string buffer", "", "dddd"};
+        const size_t count = sizeof(words) / sizeof(words[0]);
+        std::list<const char *> word_list(words, words + count);
+        uint64_t x = 88172645463325252ull;
+        lp::vector<std::string> v;
+        std::vector<std::string> expect;
+        for (int r = 0; r < _CHECK_ROUNDS; ++r)
+        {
+            x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+            const size_t n = x % (count + 1);
+            const size_t pos = expect.empty() ? 0 : (x >> 8) % (expect.size() + 1);
+            switch ((x >> 32) % 4)
+            {
+            case 0:
+                v.insert(v.begin() + pos, words, words + n);
+                expect.insert(expect.begin() + pos, words, words + n);
+                break;
+            case 1:
+                v.insert(v.begin() + pos, word_list.begin(), word_list.end());
+                expect.insert(expect.begin() + pos, word_list.begin(), word_list.end());
+                break;
+            case 2:
+                v.append(words, words + n);
+                expect.insert(expect.end(), words, words + n);
+                break;
+            default:
+                v.append(word_list.begin(), word_list.end());
+                expect.insert(expect.end(), word_list.begin(), word_list.end());
+                break;
+            }
+            ingest_ok = ingest_ok && v.size() == expect.size() && std::equal(expect.begin(), expect.end(), v.begin());
+        }
+        lp::vector<std::string> w, l;
+        w.append(words, words + count);
+        l.insert(l.end(), word_list.begin(), word_list.end());
+        ingest_ok = ingest_ok && count == w.size() && std::equal(w.begin(), w.end(), l.begin()) && words[3] == w[3];
+    }
+
+    void check_range_insert()
+    {
+        check_range_insert_convert();
+        check_range_insert_type<int64_t>([](int64_t k)
+                                         { return k; });
+        check_range_insert_type<copied_value>([](int64_t k)
+                                              { return copied_value(k); });
+        check_range_insert_type<std::string>([](int64_t k)
+                                             { return std::to_string(k) + std::string(k % 2 ? 0 : 30, 'y'); });
+    }
+
+    // 返回Melem/s,allocs为扩容次数
+    template <class Ingest>
+    void bench_ingest_one(const char *name, size_t n, size_t batch, Ingest ingest)
+    {
+        double best = 0;
+        for (int r = 0; r < 3; ++r)
+        {
+            peak_alloc::reset();
+            clock_type::time_point start = clock_type::now();
+            {
+                lp::vector<record, peak_alloc> v;
+                ingest(v);
+                if (v.size() != n || (int64_t)(n - 1) != v[n - 1].id)
+                {
+                    ingest_ok = false;
+                }
+            }
+            double secs = seconds_since(start);
+            best = 0 == r || secs < best ? secs : best;
+        }
+        std::printf("%-32s %8zu %10.1f %8zu\n", name, batch, n / best / 1e6, peak_alloc::calls);
+    }
+
+    void bench_ingest(size_t n)
+    {
+        check_range_insert();
+        const size_t batches[] = {16, 4096};
+        std::printf("== ingest %zu records of %zu bytes ==\n", n, sizeof(record));
+        std::printf("%-32s %8s %10s %8s\n", "path", "batch", "Mrec/s", "allocs");
+        for (size_t batch : batches)
+        {
+            // 一批解码好的记录,每次追加时只改id
+            std::vector<record> decoded(batch);
+            std::list<record> decoded_list(batch);
+            auto next_batch = [&](size_t base, size_t k)
+            {
+                for (size_t i = 0; i < k; ++i)
+                {
+                    decoded[i] = record{(int64_t)(base + i), 0.5 * i, (int32_t)i, (int32_t)base};
+                }
+            };
+            bench_ingest_one("push_back", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     next_batch(base, k);
+                                     for (size_t i = 0; i < k; ++i)
+                                     {
+                                         v.push_back(decoded[i]);
+                                     }
+                                 } });
+            bench_ingest_one("reserve + push_back", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 v.reserve(n);
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     next_batch(base, k);
+                                     for (size_t i = 0; i < k; ++i)
+                                     {
+                                         v.push_back(decoded[i]);
+                                     }
+                                 } });
+            bench_ingest_one("reserve + push_back_unchecked", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 v.reserve(n);
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     next_batch(base, k);
+                                     for (size_t i = 0; i < k; ++i)
+                                     {
+                                         v.push_back_unchecked(decoded[i]);
+                                     }
+                                 } });
+            bench_ingest_one("append(p, n)", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     next_batch(base, k);
+                                     v.append(decoded.data(), k);
+                                 } });
+            bench_ingest_one("reserve + append(p, n)", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 v.reserve(n);
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     next_batch(base, k);
+                                     v.append(decoded.data(), k);
+                                 } });
+            // std::list的迭代器只是双向的,个数由lp::distance遍历一次求得
+            bench_ingest_one("append(list)", n, batch, [&](lp::vector<record, peak_alloc> &v)
+                             {
+                                 for (size_t base = 0; base < n; base += batch)
+                                 {
+                                     const size_t k = lp::min(batch, n - base);
+                                     std::list<record>::iterator last = decoded_list.begin();
+                                     for (size_t i = 0; i < k; ++i, ++last)
+                                     {
+                                         last->id = (int64_t)(base + i);
+                                     }
+                                     v.append(decoded_list.begin(), last);
+                                 } });
+        }
+        std::printf("range insert checks: %s\n", ingest_ok ? "ok" : "FAILED");
+    }
+    // endregion
+
+    // region:std::string扩容测试
+    // copied_string只有拷贝构造函数,没有移动构造函数,相当于vector支持移动语义之前的行为:
+    // push_back拷贝临时对象,每次扩容深拷贝全部元素;std::string则移动,只搬动指针
+    struct copied_string
+    {
+        std::string value;
+        copied_string(const std::string &s) : value(s) {}
+        copied_string(const copied_string &x) : value(x.value) {}
+        copied_string &operator=(const copied_string &x)
+        {
+            value = x.value;
+            return *this;
+        }
+    };
+
+    template <class T>
+    void bench_string_push_back(const char *name, size_t n)
+    {
+        // 超过短字符串优化的长度,每个元素都在堆上
+        const std::string s(48, 'x');
+        clock_type::time_point start = clock_type::now();
+        lp::vector<T> v;
+        for (size_t i = 0; i < n; ++i)
+        {
+            v.push_back(T(s));
+        }
+        double secs = seconds_since(start);
+        std::printf("%-28s %10.1f %12.1f\n", name, secs * 1e3, n / secs / 1e6);
+    }
+
+    void bench_string_growth(size_t n)
+    {
+        std::printf("== push_back growth to %zu std::string ==\n", n);
+        std::printf("%-28s %10s %12s\n", "path", "ms", "Melem/s");
+        bench_string_push_back<copied_string>("copy (no move ctor)", n);
+        bench_string_push_back<std::string>("move", n);
+    }
+    // endregion
+
+    // region:unique_ptr重定位测试
+    // boxed_ptr与unique_ptr布局相同但没有标记为平凡可重定位,扩容,插入,删除时逐个移动再析构;
+    // std::unique_ptr已标记,扩容走reallocate,插入删除走memmove
+    struct boxed_ptr
+    {
+        std::unique_ptr<int64_t> p;
+        boxed_ptr(int64_t *x) : p(x) {}
+    };
+
+    enum
+    {
+        _SHIFT_SIZE = 100000,
+        _SHIFT_OPS = 20000
+    };
+
+    template <class T>
+    void bench_relocate(const char *name, size_t n)
+    {
+        clock_type::time_point start = clock_type::now();
+        {
+            lp::vector<T> v;
+            for (size_t i = 0; i < n; ++i)
+            {
+                v.emplace_back(new int64_t((int64_t)i));
+            }
+        }
+        double grow_secs = seconds_since(start);
+
+        lp::vector<T> v;
+        for (size_t i = 0; i < _SHIFT_SIZE; ++i)
+        {
+            v.emplace_back(new int64_t((int64_t)i));
+        }
+        start = clock_type::now();
+        for (int i = 0; i < _SHIFT_OPS; ++i)
+        {
+            // 在中间插入再删除,每次平移一半的元素
+            v.emplace(v.begin() + _SHIFT_SIZE / 2, new int64_t(i));
+            v.erase(v.begin() + _SHIFT_SIZE / 2 + 1);
+        }
+        double shift_secs = seconds_since(start);
+        std::printf("%-28s %12.1f %16.1f\n", name, grow_secs * 1e3, shift_secs * 1e3);
+    }
+
+    void bench_relocation(size_t n)
+    {
+        std::printf("== relocation: push_back %zu unique_ptr, %d middle insert+erase on %d ==\n", n,
+                    (int)_SHIFT_OPS, (int)_SHIFT_SIZE);
+        std::printf("%-28s %12s %16s\n", "path", "growth ms", "insert/erase ms");
+        bench_relocate<boxed_ptr>("move + destroy", n);
+        bench_relocate<std::unique_ptr<int64_t>>("trivially relocatable", n);
+    }
+    // endregion
+}
+
+int main(int argc, char **argv)
+{
+    size_t mbytes = 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        mbytes = (size_t)std::atoi(argv[1]);
+    }
+    size_t push_n = 200000000;
+    if (argc > 2 && std::atol(argv[2]) > 0)
+    {
+        push_n = (size_t)std::atol(argv[2]);
+    }
+    size_t string_n = 5000000;
+    if (argc > 3 && std::atol(argv[3]) > 0)
+    {
+        string_n = (size_t)std::atol(argv[3]);
+    }
+    bench_huge_pages(mbytes);
+    bench_default_init(mbytes);
+    bench_growth(push_n);
+    bench_growth_policies(push_n / 4);
+    bench_ingest(push_n / 4);
+    bench_string_growth(string_n);
+    bench_relocation(string_n);
+    return 0;
+}
@@ -0,0 +1,308 @@
+/*
+@author: LXP
+@create time: 2026-10-17
+@git repo: https://github.com/luoxpan/LP_STL
+@主要参考: <STL源码剖析>侯捷 著 华中科技大学出版社 出版
+*/
+/*
+惰性视图(lp_views.h)与逐步生成中间vector的写法对比
+用法: views_bench [元素个数,默认4M]
+先检查视图在lp::vector与std::list(非随机访问)上的结果与逐步写法相同,
+再对每条流水线报告两种写法的分配次数与每个输入元素的耗时(ns),取最快一轮
+*/
+#include "2_iterator/lp_views.h"
+#include "3_sequence_containers/lp_vector.h"
+#include "5_algorithm/lp_numeric.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <stdint.h>
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    enum
+    {
+        _BENCH_ROUNDS = 5,
+        _CHUNK = 16
+    };
+
+    // 统计分配次数的配置器,其余都交给lp::alloc
+    struct counting_alloc
+    {
+        static size_t allocations;
+
+        static void *allocate(size_t n)
+        {
+            ++allocations;
+            return lp::alloc::allocate(n);
+        }
+        static void deallocate(void *p, size_t n) { lp::alloc::deallocate(p, n); }
+        static void *reallocate(void *p, size_t old_size, size_t new_size)
+        {
+            ++allocations;
+            return lp::alloc::reallocate(p, old_size, new_size);
+        }
+    };
+    size_t counting_alloc::allocations = 0;
+
+    using vec = lp::vector<int64_t, counting_alloc>;
+
+    bool all_ok = true;
+    volatile int64_t sink = 0;
+
+    void check(const char *what, bool ok)
+    {
+        if (!ok)
+        {
+            all_ok = false;
+            std::printf("  MISMATCH: %s\n", what);
+        }
+    }
+
+    template <class Range, class Container>
+    bool same(const Range &r, const Container &c)
+    {
+        typename Container::const_iterator it = c.begin();
+        for (auto x : r)
+        {
+            if (it == c.end() || !(x == *it))
+            {
+                return false;
+            }
+            ++it;
+        }
+        return it == c.end();
+    }
+
+    bool is_odd(int64_t x) { return 0 != (x & 1); }
+    int64_t step(int64_t x) { return 3 * x + 1; }
+
+    // region:正确性
+    template <class Container>
+    void check_container(const Container &src, const Container &other)
+    {
+        vec expect;
+        for (int64_t x : src)
+        {
+            if (is_odd(x) && expect.size() < 7)
+            {
+                expect.push_back(step(x));
+            }
+        }
+        auto pipe = src | lp::views::filter(is_odd) | lp::views::transform(step) | lp::views::take(7);
+        check("filter|transform|take", same(pipe, expect));
+        check("take(filter(...))", same(lp::views::take(lp::views::transform(lp::views::filter(src, is_odd), step), 7), expect));
+        check("to<vec>", same(lp::views::to<vec>(pipe), expect));
+        check("| to<vec>()", same(pipe | lp::views::to<vec>(), expect));
+
+        // take超过长度,take(0)
+        check("take(n+5)", same(lp::views::take(src, src.size() + 5), src));
+        check("take(0)", lp::views::take(src, 0).empty());
+
+        // zip按较短的一个截断
+        vec dot;
+        typename Container::const_iterator b = other.begin();
+        for (typename Container::const_iterator a = src.begin(); a != src.end() && b != other.end(); ++a, ++b)
+        {
+            dot.push_back(*a * *b);
+        }
+        auto prod = lp::views::zip(src, other) | lp::views::transform([](std::pair<const int64_t &, const int64_t &> p)
+                                                                      { return p.first * p.second; });
+        check("zip|transform", same(prod, dot));
+        check("zip.size", (size_t)prod.size() == dot.size());
+
+        // chunk,最后一段不足_CHUNK个
+        vec sums;
+        int64_t acc = 0;
+        size_t k = 0;
+        for (int64_t x : src)
+        {
+            acc += x;
+            if (++k == _CHUNK)
+            {
+                sums.push_back(acc);
+                acc = 0;
+                k = 0;
+            }
+        }
+        if (k > 0)
+        {
+            sums.push_back(acc);
+        }
+        auto chunk_sums = src | lp::views::chunk(_CHUNK) | lp::views::transform([](lp::subrange<typename Container::const_iterator> c)
+                                                                                 { return lp::accumulate(c.begin(), c.end(), (int64_t)0); });
+        check("chunk|transform", same(chunk_sums, sums));
+
+        // 迭代器可以拷贝赋值(lambda本身不能)
+        auto it = prod.begin();
+        it = prod.end();
+        check("iterator assign", it == prod.end());
+    }
+
+    void check_all()
+    {
+        std::mt19937_64 gen(5);
+        for (size_t n : {0, 1, 15, 16, 17, 100, 1001})
+        {
+            vec v, w;
+            std::list<int64_t> l, m;
+            for (size_t i = 0; i < n; ++i)
+            {
+                v.push_back((int64_t)(gen() % 1000));
+                l.push_back(v.back());
+            }
+            for (size_t i = 0; i < n + 3 - n % 5; ++i)
+            {
+                w.push_back((int64_t)(gen() % 1000));
+                m.push_back(w.back());
+            }
+            check_container(v, w);
+            check_container(l, m);
+        }
+
+        // 随机访问视图上的运算
+        vec v;
+        for (int64_t i = 0; i < 100; ++i)
+        {
+            v.push_back(i);
+        }
+        auto t = lp::views::take(lp::views::transform(v, step), 40);
+        check("random access size", 40 == t.size() && 40 == t.end() - t.begin());
+        check("random access []", step(17) == t.begin()[17] && step(39) == *(t.end() - 1));
+        check("random access <", t.begin() < t.end() && t.begin() + 40 == t.end());
+        check("presized to", same(lp::views::to<vec>(t), lp::views::to<lp::vector<int64_t>>(t)));
+        std::printf("correctness checks: %s\n", all_ok ? "ok" : "FAILED");
+    }
+    // endregion
+
+    // region:性能
+    // 最快一轮每个输入元素的ns,以及该轮的分配次数
+    template <class Op>
+    void row(const char *name, size_t n, Op op)
+    {
+        double best = 0;
+        size_t allocs = 0;
+        for (int r = 0; r < _BENCH_ROUNDS; ++r)
+        {
+            counting_alloc::allocations = 0;
+            clock_type::time_point start = clock_type::now();
+            op();
+            double secs = std::chrono::duration<double>(clock_type::now() - start).count();
+            allocs = counting_alloc::allocations;
+            best = 0 == r || secs < best ? secs : best;
+        }
+        std::printf("%-34s %10zu %10.3f\n", name, allocs, best * 1e9 / n);
+        std::fflush(stdout);
+    }
+
+    void bench(size_t n)
+    {
+        std::mt19937_64 gen(13);
+        vec a, b;
+        for (size_t i = 0; i < n; ++i)
+        {
+            a.push_back((int64_t)(gen() % 1000));
+            b.push_back((int64_t)(gen() % 1000));
+        }
+        const size_t m = n / 4;
+        std::printf("== %zu int64_t ==\n%-34s %10s %10s\n", n, "pipeline", "allocs", "ns/elem");
+
+        row("eager filter,transform,take", n, [&]
+            {
+                vec odd, tr, out;
+                for (int64_t x : a)
+                {
+                    if (is_odd(x))
+                    {
+                        odd.push_back(x);
+                    }
+                }
+                for (int64_t x : odd)
+                {
+                    tr.push_back(step(x));
+                }
+                for (size_t i = 0; i < m && i < tr.size(); ++i)
+                {
+                    out.push_back(tr[i]);
+                }
+                sink = out.back(); });
+        row("lazy  filter|transform|take|to", n, [&]
+            {
+                vec out = a | lp::views::filter(is_odd) | lp::views::transform(step) | lp::views::take(m) | lp::views::to<vec>();
+                sink = out.back(); });
+
+        row("eager transform,take", n, [&]
+            {
+                vec tr, out;
+                for (int64_t x : a)
+                {
+                    tr.push_back(step(x));
+                }
+                for (size_t i = 0; i < m; ++i)
+                {
+                    out.push_back(tr[i]);
+                }
+                sink = out.back(); });
+        row("lazy  transform|take|to (presized)", n, [&]
+            {
+                vec out = a | lp::views::transform(step) | lp::views::take(m) | lp::views::to<vec>();
+                sink = out.back(); });
+
+        row("eager zip,multiply,accumulate", n, [&]
+            {
+                vec prod;
+                for (size_t i = 0; i < n; ++i)
+                {
+                    prod.push_back(a[i] * b[i]);
+                }
+                sink = lp::accumulate(prod.begin(), prod.end(), (int64_t)0); });
+        row("lazy  zip|transform|accumulate", n, [&]
+            {
+                auto prod = lp::views::zip(a, b) | lp::views::transform([](std::pair<int64_t &, int64_t &> p)
+                                                                        { return p.first * p.second; });
+                sink = lp::accumulate(prod.begin(), prod.end(), (int64_t)0); });
+
+        row("eager chunk sums", n, [&]
+            {
+                lp::vector<vec> chunks;
+                for (size_t i = 0; i < n; i += _CHUNK)
+                {
+                    vec c;
+                    for (size_t j = i; j < n && j < i + _CHUNK; ++j)
+                    {
+                        c.push_back(a[j]);
+                    }
+                    chunks.push_back(c);
+                }
+                vec sums;
+                for (const vec &c : chunks)
+                {
+                    sums.push_back(lp::accumulate(c.begin(), c.end(), (int64_t)0));
+                }
+                sink = sums.back(); });
+        row("lazy  chunk|transform|to", n, [&]
+            {
+                vec sums = a | lp::views::chunk(_CHUNK) | lp::views::transform([](lp::subrange<int64_t *> c)
+                                                                                { return lp::accumulate(c.begin(), c.end(), (int64_t)0); }) |
+                           lp::views::to<vec>();
+                sink = sums.back(); });
+    }
+    // endregion
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = 4 * 1024 * 1024;
+    if (argc > 1 && std::atoi(argv[1]) > 0)
+    {
+        n = (size_t)std::atoi(argv[1]);
+    }
+    check_all();
+    bench(n);
+    std::printf("%s\n", all_ok ? "all results match" : "MISMATCH");
+    return all_ok ? 0 : 1;
+}